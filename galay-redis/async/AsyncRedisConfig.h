@@ -5,6 +5,16 @@
 
 namespace galay::redis
 {
+    /**
+     * @brief 回复解码方式
+     */
+    enum class RedisDecodeMode
+    {
+        Tree,   // 每个元素独立分配的 RedisReply 树（默认）
+        Arena,  // 整个回复位于一个arena中，元素按需访问，释放为O(1)
+        Tape    // 先序扁平记录，子聚合可O(1)跳过，适合只访问部分字段的超大回复
+    };
+
     /**
      * @brief 异步Redis超时配置结构体
      * 用于在每个异步接口调用时指定 send/recv 的超时参数
@@ -24,11 +34,62 @@ namespace galay::redis
         std::chrono::milliseconds recv_timeout = std::chrono::milliseconds(-1);
 
         /**
-         * @brief 读缓冲区大小
+         * @brief 读缓冲区初始大小
          * 推荐范围：8192-65536
+         * 超过该大小的回复会使缓冲区按2倍扩容；之后连续多轮回复都很小时才缩回该大小
          */
         size_t buffer_size = 8192;
 
+        /**
+         * @brief 回复解码方式
+         * 大数组回复（ZRANGE WITHSCORES、HGETALL等）推荐 Arena；
+         * 多MB且只访问部分元素的回复（XRANGE、SCAN批次等）推荐 Tape
+         */
+        RedisDecodeMode decode_mode = RedisDecodeMode::Tree;
+
+        /**
+         * @brief 分散写阈值（setVectored / executeVectored）
+         * 不小于该长度的参数以 iovec 原地引用，更短的参数拷贝进命令缓冲区
+         */
+        size_t writev_threshold = 16 * 1024;
+
+        /**
+         * @brief 自动流水线（RedisMultiplexer）：发送队列积累到该字节数时立即发送
+         */
+        size_t pipeline_max_bytes = 64 * 1024;
+
+        /**
+         * @brief 自动流水线：发送队列积累到该命令数时立即发送
+         */
+        size_t pipeline_max_commands = 1024;
+
+        /**
+         * @brief 自动流水线：调用方 co_await 挂起时发送队列中的命令
+         * 关闭后命令只在达到上述上限或调用 RedisMultiplexer::flush() 时发送，适合手动控制批次
+         */
+        bool pipeline_flush_on_yield = true;
+
+        /**
+         * @brief 多路复用连接上已发送但尚未收到回复的最大字节数，0表示不限制
+         * 超出后写协程等待回复再继续发送，超大批次因此按该上限分段
+         */
+        size_t pipeline_max_inflight_bytes = 1024 * 1024;
+
+        /**
+         * @brief 流式 pipeline（pipelineStream）同时在途的最大命令数
+         * 内存占用与该值成正比；过大时回复可能填满 socket 缓冲区而拖慢发送
+         */
+        size_t pipeline_window = 1024;
+
+        /**
+         * @brief 按单命令延迟自动调节在途命令数（RedisMultiplexer 与 pipelineStream）
+         * 开启后窗口从 adaptive_window_initial 起，延迟平稳时增大、延迟上升时收缩，
+         * 不超过 adaptive_window_max；pipelineStream 以此代替 pipeline_window
+         */
+        bool adaptive_window = false;
+        size_t adaptive_window_initial = 16;
+        size_t adaptive_window_max = 4096;
+
         /**
          * @brief 检查发送超时是否启用
          * @return true表示启用超时（timeout >= 0ms）
@@ -13,16 +13,23 @@ namespace galay::redis
                                                std::vector<std::string> args,
                                                size_t expected_replies)
         : m_session(session)
-        , m_cmd(std::move(cmd))
-        , m_args(std::move(args))
         , m_expected_replies(expected_replies)
         , m_state(State::Invalid)
         , m_sent(0)
     {
-        // 编码命令
-        std::vector<std::string> cmd_parts = {m_cmd};
-        cmd_parts.insert(cmd_parts.end(), m_args.begin(), m_args.end());
-        m_encoded_cmd = m_session.m_encoder.encodeCommand(cmd_parts);
+        // 编码命令：直接追加，不拼接中间的 cmd_parts
+        protocol::RespEncoder::appendCommand(m_encoded_cmd, cmd, args);
+    }
+
+    ExecuteAwaitable::ExecuteAwaitable(AsyncRedisSession& session,
+                                               std::string encoded_cmd,
+                                               size_t expected_replies)
+        : m_session(session)
+        , m_encoded_cmd(std::move(encoded_cmd))
+        , m_expected_replies(expected_replies)
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
     }
 
     bool ExecuteAwaitable::await_suspend(std::coroutine_handle<> handle)
@@ -46,7 +53,7 @@ namespace galay::redis
         }
         else {
             // Receiving 状态，接收响应（重新创建 awaitable）
-            auto iovecs = m_session.m_ring_buffer.getWriteIovecs();
+            auto iovecs = m_session.m_recv_buffer.getWriteIovecs();
             m_recv_awaitable.emplace(m_session.m_socket.readv(std::move(iovecs)));
             return m_recv_awaitable->await_suspend(handle);
         }
@@ -91,6 +98,7 @@ namespace galay::redis
                 RedisLogDebug(m_session.m_logger, "receive response failed: {}", recv_result.error().message());
                 m_state = State::Invalid;
                 m_recv_awaitable.reset();
+                m_session.m_parser.reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
                                                  recv_result.error().message()));
             }
@@ -101,32 +109,28 @@ namespace galay::redis
                 RedisLogDebug(m_session.m_logger, "connection closed by peer");
                 m_state = State::Invalid;
                 m_recv_awaitable.reset();
+                m_session.m_parser.reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
                                                  "Connection closed"));
             }
 
-            m_session.m_ring_buffer.produce(n);
+            m_session.m_recv_buffer.produce(n);
 
             // 解析响应
             while (m_values.size() < m_expected_replies) {
-                auto read_iovecs = m_session.m_ring_buffer.getReadIovecs();
-                if (read_iovecs.empty()) {
+                if (m_session.m_recv_buffer.empty()) {
                     // 需要继续接收
                     RedisLogDebug(m_session.m_logger, "response incomplete, continue receiving");
                     return std::nullopt;
                 }
-
-                const char* data = static_cast<const char*>(read_iovecs[0].iov_base);
-                size_t len = read_iovecs[0].iov_len;
-                if (read_iovecs.size() > 1) {
-                    len += read_iovecs[1].iov_len;
-                }
+                const char* data = m_session.m_recv_buffer.data();
+                size_t len = m_session.m_recv_buffer.readable();
 
                 auto parse_result = m_session.m_parser.parse(data, len);
 
                 if (parse_result) {
                     auto [consumed, value] = parse_result.value();
-                    m_session.m_ring_buffer.consume(consumed);
+                    m_session.m_recv_buffer.consume(consumed);
                     m_values.push_back(RedisValue(value));
                 } else if (parse_result.error() == protocol::ParseError::Incomplete) {
                     // 数据不完整，需要继续接收
@@ -161,7 +165,7 @@ namespace galay::redis
     {
         // 编码所有命令
         for (const auto& cmd_parts : m_commands) {
-            m_encoded_batch += m_session.m_encoder.encodeCommand(cmd_parts);
+            protocol::RespEncoder::appendCommand(m_encoded_batch, cmd_parts);
         }
     }
 
@@ -186,7 +190,7 @@ namespace galay::redis
         }
         else {
             // Receiving 状态
-            auto iovecs = m_session.m_ring_buffer.getWriteIovecs();
+            auto iovecs = m_session.m_recv_buffer.getWriteIovecs();
             m_recv_awaitable.emplace(m_session.m_socket.readv(std::move(iovecs)));
             return m_recv_awaitable->await_suspend(handle);
         }
@@ -225,6 +229,7 @@ namespace galay::redis
                 RedisLogDebug(m_session.m_logger, "receive pipeline responses failed: {}", recv_result.error().message());
                 m_state = State::Invalid;
                 m_recv_awaitable.reset();
+                m_session.m_parser.reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
                                                  recv_result.error().message()));
             }
@@ -234,31 +239,27 @@ namespace galay::redis
                 RedisLogDebug(m_session.m_logger, "connection closed by peer");
                 m_state = State::Invalid;
                 m_recv_awaitable.reset();
+                m_session.m_parser.reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
                                                  "Connection closed"));
             }
 
-            m_session.m_ring_buffer.produce(n);
+            m_session.m_recv_buffer.produce(n);
 
             // 解析所有响应
             while (m_values.size() < m_commands.size()) {
-                auto read_iovecs = m_session.m_ring_buffer.getReadIovecs();
-                if (read_iovecs.empty()) {
+                if (m_session.m_recv_buffer.empty()) {
                     RedisLogDebug(m_session.m_logger, "pipeline responses incomplete, continue receiving");
                     return std::nullopt;
                 }
-
-                const char* data = static_cast<const char*>(read_iovecs[0].iov_base);
-                size_t len = read_iovecs[0].iov_len;
-                if (read_iovecs.size() > 1) {
-                    len += read_iovecs[1].iov_len;
-                }
+                const char* data = m_session.m_recv_buffer.data();
+                size_t len = m_session.m_recv_buffer.readable();
 
                 auto parse_result = m_session.m_parser.parse(data, len);
 
                 if (parse_result) {
                     auto [consumed, value] = parse_result.value();
-                    m_session.m_ring_buffer.consume(consumed);
+                    m_session.m_recv_buffer.consume(consumed);
                     m_values.push_back(RedisValue(value));
                 } else if (parse_result.error() == protocol::ParseError::Incomplete) {
                     RedisLogDebug(m_session.m_logger, "parse incomplete, continue receiving");
@@ -329,7 +330,7 @@ namespace galay::redis
     // ======================== AsyncRedisSession 实现 ========================
 
     AsyncRedisSession::AsyncRedisSession(IOScheduler* scheduler, AsyncRedisConfig config)
-        : m_scheduler(scheduler), m_config(config), m_ring_buffer(config.buffer_size)
+        : m_scheduler(scheduler), m_config(config), m_recv_buffer(config.buffer_size)
     {
         try {
             m_logger = spdlog::get("AsyncRedisLogger");
@@ -348,7 +349,7 @@ namespace galay::redis
         , m_encoder(std::move(other.m_encoder))
         , m_parser(std::move(other.m_parser))
         , m_config(other.m_config)
-        , m_ring_buffer(std::move(other.m_ring_buffer))
+        , m_recv_buffer(std::move(other.m_recv_buffer))
         , m_execute_awaitable(std::move(other.m_execute_awaitable))
         , m_pipeline_awaitable(std::move(other.m_pipeline_awaitable))
         , m_connect_awaitable(std::move(other.m_connect_awaitable))
@@ -366,7 +367,7 @@ namespace galay::redis
             m_encoder = std::move(other.m_encoder);
             m_parser = std::move(other.m_parser);
             m_config = other.m_config;
-            m_ring_buffer = std::move(other.m_ring_buffer);
+            m_recv_buffer = std::move(other.m_recv_buffer);
 
             // 手动处理optional成员，因为awaitable不可复制
             m_execute_awaitable.reset();
@@ -391,123 +392,123 @@ namespace galay::redis
     }
 
     ExecuteAwaitable& AsyncRedisSession::auth(const std::string& password) {
-        return execute("AUTH", {password});
+        return executeCommand<protocol::Command<"AUTH", 1>>(password);
     }
 
     ExecuteAwaitable& AsyncRedisSession::auth(const std::string& username, const std::string& password) {
-        return execute("AUTH", {username, password});
+        return executeCommand<protocol::Command<"AUTH", 2>>(username, password);
     }
 
     ExecuteAwaitable& AsyncRedisSession::select(int32_t db_index) {
-        return execute("SELECT", {std::to_string(db_index)});
+        return executeCommand<protocol::Command<"SELECT", 1>>(db_index);
     }
 
     ExecuteAwaitable& AsyncRedisSession::ping() {
-        return execute("PING", {});
+        return executeCommand<protocol::Command<"PING", 0>>();
     }
 
     ExecuteAwaitable& AsyncRedisSession::echo(const std::string& message) {
-        return execute("ECHO", {message});
+        return executeCommand<protocol::Command<"ECHO", 1>>(message);
     }
 
     ExecuteAwaitable& AsyncRedisSession::get(const std::string& key) {
-        return execute("GET", {key});
+        return executeCommand<protocol::Command<"GET", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::set(const std::string& key, const std::string& value) {
-        return execute("SET", {key, value});
+        return executeCommand<protocol::Command<"SET", 2>>(key, value);
     }
 
     ExecuteAwaitable& AsyncRedisSession::setex(const std::string& key, int64_t seconds, const std::string& value) {
-        return execute("SETEX", {key, std::to_string(seconds), value});
+        return executeCommand<protocol::Command<"SETEX", 3>>(key, seconds, value);
     }
 
     ExecuteAwaitable& AsyncRedisSession::del(const std::string& key) {
-        return execute("DEL", {key});
+        return executeCommand<protocol::Command<"DEL", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::exists(const std::string& key) {
-        return execute("EXISTS", {key});
+        return executeCommand<protocol::Command<"EXISTS", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::incr(const std::string& key) {
-        return execute("INCR", {key});
+        return executeCommand<protocol::Command<"INCR", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::decr(const std::string& key) {
-        return execute("DECR", {key});
+        return executeCommand<protocol::Command<"DECR", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::hget(const std::string& key, const std::string& field) {
-        return execute("HGET", {key, field});
+        return executeCommand<protocol::Command<"HGET", 2>>(key, field);
     }
 
     ExecuteAwaitable& AsyncRedisSession::hset(const std::string& key, const std::string& field, const std::string& value) {
-        return execute("HSET", {key, field, value});
+        return executeCommand<protocol::Command<"HSET", 3>>(key, field, value);
     }
 
     ExecuteAwaitable& AsyncRedisSession::hdel(const std::string& key, const std::string& field) {
-        return execute("HDEL", {key, field});
+        return executeCommand<protocol::Command<"HDEL", 2>>(key, field);
     }
 
     ExecuteAwaitable& AsyncRedisSession::hgetAll(const std::string& key) {
-        return execute("HGETALL", {key});
+        return executeCommand<protocol::Command<"HGETALL", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::lpush(const std::string& key, const std::string& value) {
-        return execute("LPUSH", {key, value});
+        return executeCommand<protocol::Command<"LPUSH", 2>>(key, value);
     }
 
     ExecuteAwaitable& AsyncRedisSession::rpush(const std::string& key, const std::string& value) {
-        return execute("RPUSH", {key, value});
+        return executeCommand<protocol::Command<"RPUSH", 2>>(key, value);
     }
 
     ExecuteAwaitable& AsyncRedisSession::lpop(const std::string& key) {
-        return execute("LPOP", {key});
+        return executeCommand<protocol::Command<"LPOP", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::rpop(const std::string& key) {
-        return execute("RPOP", {key});
+        return executeCommand<protocol::Command<"RPOP", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::llen(const std::string& key) {
-        return execute("LLEN", {key});
+        return executeCommand<protocol::Command<"LLEN", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::lrange(const std::string& key, int64_t start, int64_t stop) {
-        return execute("LRANGE", {key, std::to_string(start), std::to_string(stop)});
+        return executeCommand<protocol::Command<"LRANGE", 3>>(key, start, stop);
     }
 
     ExecuteAwaitable& AsyncRedisSession::sadd(const std::string& key, const std::string& member) {
-        return execute("SADD", {key, member});
+        return executeCommand<protocol::Command<"SADD", 2>>(key, member);
     }
 
     ExecuteAwaitable& AsyncRedisSession::srem(const std::string& key, const std::string& member) {
-        return execute("SREM", {key, member});
+        return executeCommand<protocol::Command<"SREM", 2>>(key, member);
     }
 
     ExecuteAwaitable& AsyncRedisSession::smembers(const std::string& key) {
-        return execute("SMEMBERS", {key});
+        return executeCommand<protocol::Command<"SMEMBERS", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::scard(const std::string& key) {
-        return execute("SCARD", {key});
+        return executeCommand<protocol::Command<"SCARD", 1>>(key);
     }
 
     ExecuteAwaitable& AsyncRedisSession::zadd(const std::string& key, double score, const std::string& member) {
-        return execute("ZADD", {key, std::to_string(score), member});
+        return executeCommand<protocol::Command<"ZADD", 3>>(key, score, member);
     }
 
     ExecuteAwaitable& AsyncRedisSession::zrem(const std::string& key, const std::string& member) {
-        return execute("ZREM", {key, member});
+        return executeCommand<protocol::Command<"ZREM", 2>>(key, member);
     }
 
     ExecuteAwaitable& AsyncRedisSession::zrange(const std::string& key, int64_t start, int64_t stop) {
-        return execute("ZRANGE", {key, std::to_string(start), std::to_string(stop)});
+        return executeCommand<protocol::Command<"ZRANGE", 3>>(key, start, stop);
     }
 
     ExecuteAwaitable& AsyncRedisSession::zscore(const std::string& key, const std::string& member) {
-        return execute("ZSCORE", {key, member});
+        return executeCommand<protocol::Command<"ZSCORE", 2>>(key, member);
     }
 
     PipelineAwaitable& AsyncRedisSession::pipeline(const std::vector<std::vector<std::string>>& commands) {
@@ -17,7 +17,9 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include "galay-redis/base/RedisError.h"
 #include "galay-redis/base/RedisValue.h"
+#include "galay-redis/base/RedisBuffer.h"
 #include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RespCommand.h"
 #include "AsyncRedisConfig.h"
 
 namespace galay::redis
@@ -27,7 +29,6 @@ namespace galay::redis
     using galay::kernel::Host;
     using galay::kernel::IOError;
     using galay::kernel::IPType;
-    using galay::kernel::RingBuffer;
     using galay::kernel::SendAwaitable;
     using galay::kernel::ReadvAwaitable;
 
@@ -50,6 +51,11 @@ namespace galay::redis
                         std::vector<std::string> args,
                         size_t expected_replies = 1);
 
+        // 已编码的命令（如 protocol::Command 预编码的结果）
+        ExecuteAwaitable(AsyncRedisSession& session,
+                        std::string encoded_cmd,
+                        size_t expected_replies);
+
         bool await_ready() const noexcept { return false; }
         bool await_suspend(std::coroutine_handle<> handle);
         RedisResult await_resume();
@@ -64,8 +70,6 @@ namespace galay::redis
         };
 
         AsyncRedisSession& m_session;
-        std::string m_cmd;
-        std::vector<std::string> m_args;
         std::string m_encoded_cmd;
         size_t m_expected_replies;
         std::vector<RedisValue> m_values;
@@ -248,6 +252,11 @@ namespace galay::redis
 
         bool isClosed() const { return m_is_closed; }
 
+        /**
+         * @brief 接收缓冲区统计（当前/峰值容量、扩容与缩容次数）
+         */
+        const RedisBufferStats& bufferStats() const { return m_recv_buffer.stats(); }
+
         ~AsyncRedisSession() = default;
 
     private:
@@ -255,6 +264,18 @@ namespace galay::redis
         friend class PipelineAwaitable;
         friend class ConnectAwaitable;
 
+        // 固定参数个数的命令：前缀编译期生成，只在需要新建 awaitable 时编码参数
+        template<typename Cmd, typename... Args>
+        ExecuteAwaitable& executeCommand(const Args&... args)
+        {
+            if (!m_execute_awaitable.has_value() || m_execute_awaitable->isInvalid()) {
+                std::string encoded;
+                Cmd::append(encoded, args...);
+                m_execute_awaitable.emplace(*this, std::move(encoded), 1);
+            }
+            return *m_execute_awaitable;
+        }
+
         // 成员变量
         bool m_is_closed = false;
         TcpSocket m_socket;
@@ -262,7 +283,7 @@ namespace galay::redis
         protocol::RespEncoder m_encoder;
         protocol::RespParser m_parser;
         AsyncRedisConfig m_config;
-        RingBuffer m_ring_buffer;
+        RedisBuffer m_recv_buffer;
 
         // 存储 awaitable 对象
         std::optional<ExecuteAwaitable> m_execute_awaitable;
@@ -6,6 +6,22 @@
 
 namespace galay::redis
 {
+    namespace
+    {
+        // close()、握手超时或命令发到一半超时之后发起的命令
+        RedisError connectionClosedError()
+        {
+            return RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
+                              "Connection closed (close() was called or a previous command timed out mid-send)");
+        }
+
+        // 内核 IO 到达时限后被取消
+        bool isTimeout(const IOError& error)
+        {
+            return error.code() == galay::kernel::kTimeout;
+        }
+    }
+
     // ======================== RedisClientAwaitable 实现 ========================
 
     RedisClientAwaitable::RedisClientAwaitable(RedisClient& client,
@@ -13,77 +29,194 @@ namespace galay::redis
                                                std::vector<std::string> args,
                                                size_t expected_replies)
         : m_client(client)
-        , m_cmd(std::move(cmd))
-        , m_args(std::move(args))
         , m_expected_replies(expected_replies)
         , m_state(State::Invalid)
         , m_sent(0)
     {
-        // 编码命令
-        std::vector<std::string> cmd_parts;
-        cmd_parts.reserve(1 + m_args.size());  // 预分配内存
-        cmd_parts.push_back(m_cmd);
-        cmd_parts.insert(cmd_parts.end(), m_args.begin(), m_args.end());
-        m_encoded_cmd = m_client.m_encoder.encodeCommand(cmd_parts);
+        // 编码命令：直接追加，不拼接中间的 cmd_parts
+        protocol::RespEncoder::appendCommand(m_encoded_cmd, cmd, args);
 
         // 预分配响应值的内存
         m_values.reserve(m_expected_replies);
     }
 
-    bool RedisClientAwaitable::await_suspend(std::coroutine_handle<> handle)
+    RedisClientAwaitable::RedisClientAwaitable(RedisClient& client,
+                                               std::string encoded_cmd,
+                                               size_t expected_replies)
+        : m_client(client)
+        , m_encoded_cmd(std::move(encoded_cmd))
+        , m_expected_replies(expected_replies)
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
+        m_values.reserve(m_expected_replies);
+    }
+
+    RedisClientAwaitable::RedisClientAwaitable(RedisClient& client,
+                                               protocol::RespVectoredCommand command,
+                                               size_t expected_replies)
+        : m_client(client)
+        , m_vectored_cmd(std::move(command))
+        , m_expected_replies(expected_replies)
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
+        m_values.reserve(m_expected_replies);
+    }
+
+    RedisClientAwaitable::RedisClientAwaitable(RedisClient& client,
+                                               std::string encoded_header,
+                                               RedisFileRegion file)
+        : m_client(client)
+        , m_encoded_cmd(std::move(encoded_header))
+        , m_file(file)
+        , m_expected_replies(1)
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
+        m_values.reserve(m_expected_replies);
+    }
+
+    size_t RedisClientAwaitable::commandSize() const
+    {
+        if (m_file.has_value()) {
+            return m_encoded_cmd.size() + m_file->length + 2;
+        }
+        return m_vectored_cmd.empty() ? m_encoded_cmd.size() : m_vectored_cmd.size();
+    }
+
+    bool RedisClientAwaitable::suspendSend(std::coroutine_handle<> handle)
+    {
+        m_send_awaitable.reset();
+        m_writev_awaitable.reset();
+        m_sendfile_awaitable.reset();
+
+        if (m_file.has_value()) {
+            // 命令头 -> 文件内容 -> 结尾的 \r\n，按已发送字节数决定当前阶段
+            size_t header = m_encoded_cmd.size();
+            if (m_sent >= header && m_sent < header + m_file->length) {
+                size_t done = m_sent - header;
+                m_sendfile_awaitable.emplace(m_client.m_socket.sendfile(
+                    m_file->fd,
+                    m_file->offset + static_cast<off_t>(done),
+                    m_file->length - done
+                ));
+                return m_sendfile_awaitable.suspend(handle, remainingTime());
+            }
+            if (m_sent >= header) {
+                size_t done = m_sent - header - m_file->length;
+                m_send_awaitable.emplace(m_client.m_socket.send("\r\n" + done, 2 - done));
+                return m_send_awaitable.suspend(handle, remainingTime());
+            }
+        }
+        if (!m_vectored_cmd.empty()) {
+            // 从已发送位置重新切分 iovec，原地引用的参数不经过用户态拷贝
+            m_writev_awaitable.emplace(m_client.m_socket.writev(m_vectored_cmd.iovecs(m_sent)));
+            return m_writev_awaitable.suspend(handle, remainingTime());
+        }
+        m_send_awaitable.emplace(m_client.m_socket.send(
+            m_encoded_cmd.c_str() + m_sent,
+            m_encoded_cmd.size() - m_sent
+        ));
+        return m_send_awaitable.suspend(handle, remainingTime());
+    }
+
+    std::expected<size_t, IOError> RedisClientAwaitable::resumeSend()
+    {
+        if (m_sendfile_awaitable.has_value()) {
+            return m_sendfile_awaitable.resume();
+        }
+        if (m_writev_awaitable.has_value()) {
+            return m_writev_awaitable.resume();
+        }
+        return m_send_awaitable.resume();
+    }
+
+    void RedisClientAwaitable::resetParser() noexcept
+    {
+        m_client.m_parser.reset();
+        m_client.m_view_parser.reset();
+        m_client.m_tape_parser.reset();
+    }
+
+    bool RedisClientAwaitable::suspendStep(std::coroutine_handle<> handle)
     {
         if (m_state == State::Invalid) {
-            // Invalid 状态，开始发送命令
+            // Invalid 状态，开始发送命令；之前借出的回复在此失效
+            m_client.releaseBorrowed();
+            startDeadline();
             m_state = State::Sending;
-            m_send_awaitable.emplace(m_client.m_socket.send(
-                m_encoded_cmd.c_str() + m_sent,
-                m_encoded_cmd.size() - m_sent
-            ));
-            return m_send_awaitable->await_suspend(handle);
+            return suspendSend(handle);
         }
         else if (m_state == State::Sending) {
             // 继续发送命令（重新创建 awaitable）
-            m_send_awaitable.emplace(m_client.m_socket.send(
-                m_encoded_cmd.c_str() + m_sent,
-                m_encoded_cmd.size() - m_sent
-            ));
-            return m_send_awaitable->await_suspend(handle);
+            return suspendSend(handle);
         }
         else {
             // Receiving 状态，接收响应（重新创建 awaitable）
-            auto iovecs = m_client.m_ring_buffer.getWriteIovecs();
-            m_recv_awaitable.emplace(m_client.m_socket.readv(std::move(iovecs)));
-            return m_recv_awaitable->await_suspend(handle);
+            auto region = m_client.m_recv_buffer.getWriteSpan();
+            m_recv_awaitable.emplace(m_client.m_socket.recv(region.data(), region.size()));
+            return m_recv_awaitable.suspend(handle, remainingTime());
         }
     }
 
-    std::expected<std::optional<std::vector<RedisValue>>, RedisError>
+    bool RedisClientAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        return m_client.drive(*this, handle);
+    }
+
+    bool RedisClientAwaitable::resumeStep()
+    {
+        auto result = onIOComplete();
+        if (result && !result->has_value()) {
+            return false;
+        }
+        m_final = std::move(result);
+        return true;
+    }
+
+    std::expected<std::optional<RedisValueList>, RedisError>
     RedisClientAwaitable::await_resume()
     {
-        // 首先检查是否有超时错误（由 TimeoutSupport 设置）
-        if (!m_result.has_value()) {
-            // m_result 已被 TimeoutSupport 设置为 IOError，需要转换为 RedisError
-            auto& io_error = m_result.error();
-            RedisLogDebug(m_client.m_logger, "command failed with IO error: {}", io_error.message());
-
-            // 将 IOError 转换为 RedisError
-            RedisErrorType redis_error_type;
-            if (io_error.code() == galay::kernel::kTimeout) {
-                redis_error_type = RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR;
-            } else if (io_error.code() == galay::kernel::kDisconnectError) {
-                redis_error_type = RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED;
-            } else {
-                redis_error_type = RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR;
-            }
+        if (takeRejected()) {
+            return std::unexpected(connectionClosedError());
+        }
 
+        if (!m_final.has_value()) {
+            RedisLogError(m_client.m_logger, "await_resume called without result");
             reset();
-            return std::unexpected(RedisError(redis_error_type, io_error.message()));
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "RedisClientAwaitable resumed without result"));
+        }
+        auto result = std::move(*m_final);
+        m_final.reset();
+        return result;
+    }
+
+    RedisError RedisClientAwaitable::onTimeout(const IOError& error)
+    {
+        RedisLogDebug(m_client.m_logger, "command timed out: {}", error.message());
+        if (m_state == State::Receiving) {
+            // 命令已完整发出，回复迟早会到，由之后的命令按个数跳过
+            m_client.m_stale_replies += m_expected_replies - m_values.size();
+        } else if (m_sent > 0) {
+            // 服务端收到了半条命令，会把下一条命令的字节当作它的剩余部分，连接不能再用
+            m_client.m_is_closed.store(true, std::memory_order_release);
         }
+        reset();
+        return RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR, error.message());
+    }
 
+    std::expected<std::optional<RedisValueList>, RedisError>
+    RedisClientAwaitable::onIOComplete()
+    {
         if (m_state == State::Sending) {
             // 检查发送结果
-            auto send_result = m_send_awaitable->await_resume();
+            auto send_result = resumeSend();
 
+            if (!send_result && isTimeout(send_result.error())) {
+                return std::unexpected(onTimeout(send_result.error()));
+            }
             if (!send_result) {
                 // 发送错误，清理资源并重置为 Invalid 状态
                 RedisLogDebug(m_client.m_logger, "send command failed: {}", send_result.error().message());
@@ -92,9 +225,17 @@ namespace galay::redis
                                                  send_result.error().message()));
             }
 
+            if (send_result.value() == 0 && m_sendfile_awaitable.has_value()) {
+                // 文件比声明的长度短，命令已无法补全
+                RedisLogDebug(m_client.m_logger, "sendfile reached end of file before length");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_SEND_ERROR,
+                                                 "File shorter than requested length"));
+            }
+
             m_sent += send_result.value();
 
-            if (m_sent < m_encoded_cmd.size()) {
+            if (m_sent < commandSize()) {
                 // 发送未完成，保持 Sending 状态
                 RedisLogDebug(m_client.m_logger, "send command incomplete, continue sending");
                 return std::nullopt;
@@ -104,12 +245,17 @@ namespace galay::redis
             RedisLogDebug(m_client.m_logger, "send command completed, start receiving response");
             m_state = State::Receiving;
             m_send_awaitable.reset();
+            m_writev_awaitable.reset();
+            m_sendfile_awaitable.reset();
             return std::nullopt;
         }
         else if (m_state == State::Receiving) {
             // Receiving 状态，检查接收结果
-            auto recv_result = m_recv_awaitable->await_resume();
+            auto recv_result = m_recv_awaitable.resume();
 
+            if (!recv_result && isTimeout(recv_result.error())) {
+                return std::unexpected(onTimeout(recv_result.error()));
+            }
             if (!recv_result) {
                 // 接收错误，清理资源并重置为 Invalid 状态
                 RedisLogDebug(m_client.m_logger, "receive response failed: {}", recv_result.error().message());
@@ -127,29 +273,36 @@ namespace galay::redis
                                                  "Connection closed"));
             }
 
-            m_client.m_ring_buffer.produce(n);
+            m_client.m_recv_buffer.produce(n);
+
+            // 先丢弃之前超时的命令迟到的回复
+            auto skipped = m_client.skipStaleReplies();
+            if (!skipped) {
+                RedisLogDebug(m_client.m_logger, "parse error in stale reply");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
+            }
+            if (!*skipped) {
+                return std::nullopt;
+            }
 
             // 解析响应
             while (m_values.size() < m_expected_replies) {
-                auto read_iovecs = m_client.m_ring_buffer.getReadIovecs();
-                if (read_iovecs.empty()) {
+                size_t len = m_client.m_recv_buffer.readable();
+                const char* data = m_client.m_recv_buffer.data();
+                if (len == 0) {
                     // 需要继续接收
                     RedisLogDebug(m_client.m_logger, "response incomplete, continue receiving");
                     return std::nullopt;
                 }
 
-                const char* data = static_cast<const char*>(read_iovecs[0].iov_base);
-                size_t len = read_iovecs[0].iov_len;
-                if (read_iovecs.size() > 1) {
-                    len += read_iovecs[1].iov_len;
-                }
-
-                auto parse_result = m_client.m_parser.parse(data, len);
+                auto parse_result = m_client.parseValue(data, len);
 
                 if (parse_result) {
-                    auto [consumed, value] = parse_result.value();
-                    m_client.m_ring_buffer.consume(consumed);
-                    m_values.push_back(RedisValue(value));
+                    auto& [consumed, value] = parse_result.value();
+                    m_client.m_recv_buffer.consume(consumed);
+                    m_values.push_back(std::move(value));
                 } else if (parse_result.error() == protocol::ParseError::Incomplete) {
                     // 数据不完整，需要继续接收
                     RedisLogDebug(m_client.m_logger, "parse incomplete, continue receiving");
@@ -171,7 +324,7 @@ namespace galay::redis
         }
         else {
             // Invalid 状态，不应该被调用
-            RedisLogError(m_client.m_logger, "await_resume called in Invalid state");
+            RedisLogError(m_client.m_logger, "IO completed in Invalid state");
             reset();
             return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
                                              "RedisClientAwaitable in Invalid state"));
@@ -190,22 +343,31 @@ namespace galay::redis
         // 预分配响应值的内存
         m_values.reserve(m_commands.size());
 
-        // 编码所有命令
+        // 编码所有命令，追加到同一个缓冲区
         for (const auto& cmd_parts : m_commands) {
-            m_encoded_batch += m_client.m_encoder.encodeCommand(cmd_parts);
+            protocol::RespEncoder::appendCommand(m_encoded_batch, cmd_parts);
         }
     }
 
-    bool RedisPipelineAwaitable::await_suspend(std::coroutine_handle<> handle)
+    void RedisPipelineAwaitable::resetParser() noexcept
+    {
+        m_client.m_parser.reset();
+        m_client.m_view_parser.reset();
+        m_client.m_tape_parser.reset();
+    }
+
+    bool RedisPipelineAwaitable::suspendStep(std::coroutine_handle<> handle)
     {
         if (m_state == State::Invalid) {
-            // Invalid 状态，开始发送
+            // Invalid 状态，开始发送；之前借出的回复在此失效
+            m_client.releaseBorrowed();
+            startDeadline();
             m_state = State::Sending;
             m_send_awaitable.emplace(m_client.m_socket.send(
                 m_encoded_batch.c_str() + m_sent,
                 m_encoded_batch.size() - m_sent
             ));
-            return m_send_awaitable->await_suspend(handle);
+            return m_send_awaitable.suspend(handle, remainingTime());
         }
         else if (m_state == State::Sending) {
             // 继续发送
@@ -213,42 +375,72 @@ namespace galay::redis
                 m_encoded_batch.c_str() + m_sent,
                 m_encoded_batch.size() - m_sent
             ));
-            return m_send_awaitable->await_suspend(handle);
+            return m_send_awaitable.suspend(handle, remainingTime());
         }
         else {
             // Receiving 状态
-            auto iovecs = m_client.m_ring_buffer.getWriteIovecs();
-            m_recv_awaitable.emplace(m_client.m_socket.readv(std::move(iovecs)));
-            return m_recv_awaitable->await_suspend(handle);
+            auto region = m_client.m_recv_buffer.getWriteSpan();
+            m_recv_awaitable.emplace(m_client.m_socket.recv(region.data(), region.size()));
+            return m_recv_awaitable.suspend(handle, remainingTime());
+        }
+    }
+
+    bool RedisPipelineAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        return m_client.drive(*this, handle);
+    }
+
+    bool RedisPipelineAwaitable::resumeStep()
+    {
+        auto result = onIOComplete();
+        if (result && !result->has_value()) {
+            return false;
         }
+        m_final = std::move(result);
+        return true;
     }
 
     std::expected<std::optional<std::vector<RedisValue>>, RedisError>
     RedisPipelineAwaitable::await_resume()
     {
-        // 首先检查是否有超时错误（由 TimeoutSupport 设置）
-        if (!m_result.has_value()) {
-            // m_result 已被 TimeoutSupport 设置为 IOError，需要转换为 RedisError
-            auto& io_error = m_result.error();
-            RedisLogDebug(m_client.m_logger, "pipeline failed with IO error: {}", io_error.message());
-
-            // 将 IOError 转换为 RedisError
-            RedisErrorType redis_error_type;
-            if (io_error.code() == galay::kernel::kTimeout) {
-                redis_error_type = RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR;
-            } else if (io_error.code() == galay::kernel::kDisconnectError) {
-                redis_error_type = RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED;
-            } else {
-                redis_error_type = RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR;
-            }
+        if (takeRejected()) {
+            return std::unexpected(connectionClosedError());
+        }
 
+        if (!m_final.has_value()) {
+            RedisLogError(m_client.m_logger, "await_resume called without result");
             reset();
-            return std::unexpected(RedisError(redis_error_type, io_error.message()));
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "RedisPipelineAwaitable resumed without result"));
+        }
+        auto result = std::move(*m_final);
+        m_final.reset();
+        return result;
+    }
+
+    RedisError RedisPipelineAwaitable::onTimeout(const IOError& error)
+    {
+        RedisLogDebug(m_client.m_logger, "pipeline timed out: {}", error.message());
+        if (m_state == State::Receiving) {
+            // 所有命令已发出，尚未收到的回复由之后的命令跳过
+            m_client.m_stale_replies += m_commands.size() - m_values.size();
+        } else if (m_sent > 0) {
+            // 服务端收到了不完整的批次，连接不能再用
+            m_client.m_is_closed.store(true, std::memory_order_release);
         }
+        reset();
+        return RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR, error.message());
+    }
 
+    std::expected<std::optional<std::vector<RedisValue>>, RedisError>
+    RedisPipelineAwaitable::onIOComplete()
+    {
         if (m_state == State::Sending) {
-            auto send_result = m_send_awaitable->await_resume();
+            auto send_result = m_send_awaitable.resume();
 
+            if (!send_result && isTimeout(send_result.error())) {
+                return std::unexpected(onTimeout(send_result.error()));
+            }
             if (!send_result) {
                 RedisLogDebug(m_client.m_logger, "send pipeline failed: {}", send_result.error().message());
                 reset();
@@ -269,8 +461,11 @@ namespace galay::redis
             return std::nullopt;
         }
         else if (m_state == State::Receiving) {
-            auto recv_result = m_recv_awaitable->await_resume();
+            auto recv_result = m_recv_awaitable.resume();
 
+            if (!recv_result && isTimeout(recv_result.error())) {
+                return std::unexpected(onTimeout(recv_result.error()));
+            }
             if (!recv_result) {
                 RedisLogDebug(m_client.m_logger, "receive pipeline responses failed: {}", recv_result.error().message());
                 reset();
@@ -286,28 +481,35 @@ namespace galay::redis
                                                  "Connection closed"));
             }
 
-            m_client.m_ring_buffer.produce(n);
+            m_client.m_recv_buffer.produce(n);
+
+            // 先丢弃之前超时的命令迟到的回复
+            auto skipped = m_client.skipStaleReplies();
+            if (!skipped) {
+                RedisLogDebug(m_client.m_logger, "parse error in stale reply");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
+            }
+            if (!*skipped) {
+                return std::nullopt;
+            }
 
             // 解析所有响应
             while (m_values.size() < m_commands.size()) {
-                auto read_iovecs = m_client.m_ring_buffer.getReadIovecs();
-                if (read_iovecs.empty()) {
+                size_t len = m_client.m_recv_buffer.readable();
+                const char* data = m_client.m_recv_buffer.data();
+                if (len == 0) {
                     RedisLogDebug(m_client.m_logger, "pipeline responses incomplete, continue receiving");
                     return std::nullopt;
                 }
 
-                const char* data = static_cast<const char*>(read_iovecs[0].iov_base);
-                size_t len = read_iovecs[0].iov_len;
-                if (read_iovecs.size() > 1) {
-                    len += read_iovecs[1].iov_len;
-                }
-
-                auto parse_result = m_client.m_parser.parse(data, len);
+                auto parse_result = m_client.parseValue(data, len);
 
                 if (parse_result) {
-                    auto [consumed, value] = parse_result.value();
-                    m_client.m_ring_buffer.consume(consumed);
-                    m_values.push_back(RedisValue(value));
+                    auto& [consumed, value] = parse_result.value();
+                    m_client.m_recv_buffer.consume(consumed);
+                    m_values.push_back(std::move(value));
                 } else if (parse_result.error() == protocol::ParseError::Incomplete) {
                     RedisLogDebug(m_client.m_logger, "parse incomplete, continue receiving");
                     return std::nullopt;
@@ -326,341 +528,1033 @@ namespace galay::redis
         }
         else {
             // Invalid 状态，不应该被调用
-            RedisLogError(m_client.m_logger, "await_resume called in Invalid state");
+            RedisLogError(m_client.m_logger, "IO completed in Invalid state");
             reset();
             return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
                                              "RedisPipelineAwaitable in Invalid state"));
         }
     }
 
-    // ======================== RedisConnectAwaitable 实现 ========================
+    // ======================== RedisPipelineStreamAwaitable 实现 ========================
 
-    RedisConnectAwaitable::RedisConnectAwaitable(RedisClient& client,
-                                                 std::string ip,
-                                                 int32_t port,
-                                                 std::string username,
-                                                 std::string password,
-                                                 int32_t db_index,
-                                                 int version)
+    RedisPipelineStreamAwaitable::RedisPipelineStreamAwaitable(RedisClient& client,
+                                                               RedisCommandSource source,
+                                                               RedisReplyHandler handler,
+                                                               size_t window,
+                                                               RedisAdaptiveWindow* adaptive)
         : m_client(client)
-        , m_ip(std::move(ip))
-        , m_port(port)
-        , m_username(std::move(username))
-        , m_password(std::move(password))
-        , m_db_index(db_index)
-        , m_version(version)
+        , m_source(std::move(source))
+        , m_handler(std::move(handler))
+        , m_window(std::max<size_t>(window, 1))
+        , m_adaptive(adaptive)
         , m_state(State::Invalid)
+        , m_sent(0)
     {
     }
 
-    bool RedisConnectAwaitable::await_suspend(std::coroutine_handle<> handle)
+    void RedisPipelineStreamAwaitable::resetParser() noexcept
     {
-        if (m_state == State::Invalid) {
-            // 开始连接
-            m_state = State::Connecting;
+        m_client.m_parser.reset();
+        m_client.m_view_parser.reset();
+        m_client.m_tape_parser.reset();
+    }
 
-            // 创建 Host 对象并连接
-            Host host(m_version == 4 ? IPType::IPV4 : IPType::IPV6, m_ip, m_port);
-            m_connect_awaitable.emplace(m_client.m_socket.connect(host));
-            return m_connect_awaitable->await_suspend(handle);
-        }
-        else if (m_state == State::Connecting) {
-            // 连接已建立，检查是否需要认证
-            if (m_username.empty() && m_password.empty()) {
-                // 不需要认证，直接跳到数据库选择
-                m_state = State::SelectingDB;
-                return true;  // 立即继续
+    void RedisPipelineStreamAwaitable::refill()
+    {
+        m_encoded.clear();
+        m_sent = 0;
+        m_batch_commands = 0;
+        size_t window = this->window();
+        while (!m_source_done && m_in_flight < window) {
+            m_command.clear();
+            if (!m_source || !m_source(m_command)) {
+                m_source_done = true;
+                break;
             }
-
-            // 需要认证
-            m_state = State::Authenticating;
-
-            // 编码认证命令
-            std::vector<std::string> auth_cmd;
-            if (m_username.empty()) {
-                auth_cmd = {"AUTH", m_password};
-            } else {
-                auth_cmd = {"AUTH", m_username, m_password};
+            if (m_command.empty()) {
+                continue;
             }
-
-            m_encoded_cmd = m_client.m_encoder.encodeCommand(auth_cmd);
-            m_sent = 0;
-
-            // 发送认证命令
-            m_send_awaitable.emplace(m_client.m_socket.send(
-                m_encoded_cmd.c_str(),
-                m_encoded_cmd.size()
-            ));
-            return m_send_awaitable->await_suspend(handle);
-        }
-        else if (m_state == State::Authenticating) {
-            // 继续发送认证命令（如果未完成）
-            m_send_awaitable.emplace(m_client.m_socket.send(
-                m_encoded_cmd.c_str() + m_sent,
-                m_encoded_cmd.size() - m_sent
-            ));
-            return m_send_awaitable->await_suspend(handle);
+            protocol::RespEncoder::appendCommand(m_encoded, m_command);
+            ++m_in_flight;
+            ++m_batch_commands;
         }
-        else if (m_state == State::SelectingDB) {
-            // 需要选择数据库
-            if (m_db_index == 0) {
-                // 不需要选择数据库，直接完成
-                m_state = State::Done;
+        m_summary.max_in_flight = std::max(m_summary.max_in_flight, m_in_flight);
+    }
+
+    bool RedisPipelineStreamAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        if (m_state == State::Invalid && !m_client.isClosed()) {
+            // Invalid 状态，取第一批命令；之前借出的回复在此失效
+            m_client.releaseBorrowed();
+            startDeadline();
+            refill();
+            if (m_encoded.empty()) {
+                // 没有任何命令，不经过驱动协程
+                m_final = finish();
                 return false;
             }
+            m_state = State::Sending;
+        }
+        return m_client.drive(*this, handle);
+    }
 
-            // 发送 SELECT 命令
-            std::vector<std::string> select_cmd = {"SELECT", std::to_string(m_db_index)};
-            m_encoded_cmd = m_client.m_encoder.encodeCommand(select_cmd);
-            m_sent = 0;
-
+    bool RedisPipelineStreamAwaitable::suspendStep(std::coroutine_handle<> handle)
+    {
+        if (m_state == State::Sending) {
             m_send_awaitable.emplace(m_client.m_socket.send(
-                m_encoded_cmd.c_str(),
-                m_encoded_cmd.size()
+                m_encoded.c_str() + m_sent,
+                m_encoded.size() - m_sent
             ));
-            return m_send_awaitable->await_suspend(handle);
+            return m_send_awaitable.suspend(handle, remainingTime());
         }
 
-        return false;
+        // Receiving 状态
+        auto region = m_client.m_recv_buffer.getWriteSpan();
+        m_recv_awaitable.emplace(m_client.m_socket.recv(region.data(), region.size()));
+        return m_recv_awaitable.suspend(handle, remainingTime());
     }
 
-    RedisVoidResult RedisConnectAwaitable::await_resume()
+    bool RedisPipelineStreamAwaitable::resumeStep()
     {
-        if (m_state == State::Connecting) {
-            // 检查连接结果
-            auto connect_result = m_connect_awaitable->await_resume();
+        auto result = onIOComplete();
+        if (result && !result->has_value()) {
+            return false;
+        }
+        m_final = std::move(result);
+        return true;
+    }
 
-            if (!connect_result) {
-                // 连接失败
-                RedisLogDebug(m_client.m_logger, "Connection to {}:{} failed: {}",
-                              m_ip, m_port, connect_result.error().message());
-                m_state = State::Invalid;
-                m_connect_awaitable.reset();
-                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
-                                                         "Connection failed: " + connect_result.error().message()));
-            }
-
-            // 连接成功，检查是否需要认证
-            if (m_username.empty() && m_password.empty()) {
-                // 不需要认证，直接检查是否需要选择数据库
-                if (m_db_index == 0) {
-                    m_state = State::Done;
-                    return {};
-                }
-                m_state = State::SelectingDB;
-            } else {
-                m_state = State::Authenticating;
-            }
+    std::expected<std::optional<RedisPipelineStreamSummary>, RedisError>
+    RedisPipelineStreamAwaitable::await_resume()
+    {
+        if (takeRejected()) {
+            return std::unexpected(connectionClosedError());
+        }
 
-            m_connect_awaitable.reset();
-            return {};
+        if (!m_final.has_value()) {
+            RedisLogError(m_client.m_logger, "await_resume called without result");
+            reset();
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "RedisPipelineStreamAwaitable resumed without result"));
+        }
+        auto result = std::move(*m_final);
+        m_final.reset();
+        return result;
+    }
+
+    RedisError RedisPipelineStreamAwaitable::onTimeout(const IOError& error)
+    {
+        RedisLogDebug(m_client.m_logger, "pipeline stream timed out: {}", error.message());
+        if (m_state == State::Receiving) {
+            // 在途命令都已发出，回复由之后的命令跳过
+            m_client.m_stale_replies += m_in_flight;
+        } else if (m_sent == 0) {
+            // 本批一个字节都没发出，只有之前批次的命令在途
+            m_client.m_stale_replies += m_in_flight - m_batch_commands;
+        } else {
+            // 服务端收到了不完整的批次，连接不能再用
+            m_client.m_is_closed.store(true, std::memory_order_release);
+        }
+        reset();
+        return RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR, error.message());
+    }
+
+    std::expected<std::optional<RedisPipelineStreamSummary>, RedisError>
+    RedisPipelineStreamAwaitable::finish()
+    {
+        bool stopped = m_stopped;
+        auto summary = m_summary;
+        reset();
+        if (stopped) {
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INVALID_ERROR,
+                                             "Pipeline handler stopped"));
         }
+        return summary;
+    }
 
-        if (m_state == State::Authenticating) {
-            // 检查认证命令发送结果
-            auto send_result = m_send_awaitable->await_resume();
+    std::expected<std::optional<RedisPipelineStreamSummary>, RedisError>
+    RedisPipelineStreamAwaitable::onIOComplete()
+    {
+        if (m_state == State::Sending) {
+            auto send_result = m_send_awaitable.resume();
 
+            if (!send_result && isTimeout(send_result.error())) {
+                return std::unexpected(onTimeout(send_result.error()));
+            }
             if (!send_result) {
-                RedisLogDebug(m_client.m_logger, "Send AUTH command failed: {}", send_result.error().message());
-                m_state = State::Invalid;
-                m_send_awaitable.reset();
+                RedisLogDebug(m_client.m_logger, "send pipeline stream failed: {}", send_result.error().message());
+                reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_SEND_ERROR,
-                                                         "Send AUTH failed: " + send_result.error().message()));
+                                                 send_result.error().message()));
             }
 
             m_sent += send_result.value();
-
-            if (m_sent < m_encoded_cmd.size()) {
-                // 发送未完成，继续发送
-                return {};
+            if (m_sent < m_encoded.size()) {
+                RedisLogDebug(m_client.m_logger, "send pipeline stream batch incomplete, continue sending");
+                return std::nullopt;
             }
 
-            // 发送完成，接收认证响应
-            auto iovecs = m_client.m_ring_buffer.getWriteIovecs();
-            m_recv_awaitable.emplace(m_client.m_socket.readv(std::move(iovecs)));
-            m_recv_awaitable->await_suspend(std::coroutine_handle<>::from_address(nullptr));
-            m_recv_awaitable->await_resume();
-
-            auto recv_result = m_recv_awaitable->await_resume();
+            // 本批发送完成，接收回复
+            if (m_adaptive) {
+                m_batches.emplace_back(std::chrono::steady_clock::now(), m_batch_commands);
+            }
+            m_state = State::Receiving;
+            m_send_awaitable.reset();
+            return std::nullopt;
+        }
+        else if (m_state == State::Receiving) {
+            auto recv_result = m_recv_awaitable.resume();
+            m_recv_awaitable.reset();
 
+            if (!recv_result && isTimeout(recv_result.error())) {
+                return std::unexpected(onTimeout(recv_result.error()));
+            }
             if (!recv_result) {
-                RedisLogDebug(m_client.m_logger, "Receive AUTH response failed: {}", recv_result.error().message());
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
+                RedisLogDebug(m_client.m_logger, "receive pipeline stream failed: {}", recv_result.error().message());
+                reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
-                                                         "Receive AUTH response failed"));
+                                                 recv_result.error().message()));
             }
 
             size_t n = recv_result.value();
             if (n == 0) {
-                RedisLogDebug(m_client.m_logger, "Connection closed during AUTH");
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
+                RedisLogDebug(m_client.m_logger, "connection closed by peer");
+                reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
-                                                         "Connection closed"));
+                                                 "Connection closed"));
             }
+            m_client.m_recv_buffer.produce(n);
 
-            m_client.m_ring_buffer.produce(n);
-
-            // 解析认证响应
-            auto read_iovecs = m_client.m_ring_buffer.getReadIovecs();
-            if (read_iovecs.empty()) {
-                RedisLogDebug(m_client.m_logger, "AUTH response incomplete");
-                return {};  // 继续接收
+            // 先丢弃之前超时的命令迟到的回复
+            auto skipped = m_client.skipStaleReplies();
+            if (!skipped) {
+                RedisLogDebug(m_client.m_logger, "parse error in stale reply");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
             }
-
-            const char* data = static_cast<const char*>(read_iovecs[0].iov_base);
-            size_t len = read_iovecs[0].iov_len;
-            if (read_iovecs.size() > 1) {
-                len += read_iovecs[1].iov_len;
+            if (!*skipped) {
+                return std::nullopt;
             }
 
-            auto parse_result = m_client.m_parser.parse(data, len);
+            // 逐条解析并交给 handler，解析过的回复立即释放
+            auto now = std::chrono::steady_clock::now();
+            while (m_in_flight > 0 && !m_client.m_recv_buffer.empty()) {
+                auto parse_result = m_client.parseValue(m_client.m_recv_buffer.data(),
+                                                        m_client.m_recv_buffer.readable());
+                if (!parse_result) {
+                    if (parse_result.error() == protocol::ParseError::Incomplete) {
+                        break;
+                    }
+                    RedisLogDebug(m_client.m_logger, "parse error");
+                    reset();
+                    return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                     "Parse error"));
+                }
 
-            if (!parse_result) {
-                if (parse_result.error() == protocol::ParseError::Incomplete) {
-                    return {};  // 继续接收
+                auto& [consumed, value] = parse_result.value();
+                m_client.m_recv_buffer.consume(consumed);
+                --m_in_flight;
+                if (m_adaptive && !m_batches.empty()) {
+                    m_adaptive->onReply(now - m_batches.front().first);
+                    if (--m_batches.front().second == 0) {
+                        m_batches.pop_front();
+                    }
+                }
+                size_t index = m_summary.commands++;
+                if (value.isError()) {
+                    ++m_summary.error_replies;
+                }
+                if (!m_stopped && m_handler && !m_handler(index, std::move(value))) {
+                    // 已发出命令的回复仍要读完，连接才能继续使用
+                    m_stopped = true;
                 }
-                RedisLogDebug(m_client.m_logger, "Parse AUTH response error");
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
-                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
-                                                         "Parse AUTH response error"));
             }
 
-            auto [consumed, value] = parse_result.value();
-            m_client.m_ring_buffer.consume(consumed);
-
-            // 检查认证结果
-            if (value.isError()) {
-                RedisLogDebug(m_client.m_logger, "AUTH failed: {}", value.asString());
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
-                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_AUTH_ERROR,
-                                                         "AUTH failed: " + value.asString()));
+            // 在途数降到窗口一半时补发下一批
+            if (!m_stopped && !m_source_done && m_in_flight <= window() / 2) {
+                refill();
+                if (!m_encoded.empty()) {
+                    m_state = State::Sending;
+                    return std::nullopt;
+                }
             }
 
-            RedisLogDebug(m_client.m_logger, "AUTH succeeded");
-
-            // 认证成功，检查是否需要选择数据库
-            if (m_db_index == 0) {
-                m_state = State::Done;
-                return {};
+            if (m_in_flight > 0) {
+                RedisLogDebug(m_client.m_logger, "pipeline stream responses incomplete, continue receiving");
+                return std::nullopt;
             }
 
-            m_state = State::SelectingDB;
-            m_recv_awaitable.reset();
-            return {};
+            return finish();
+        }
+        else {
+            // Invalid 状态，不应该被调用
+            RedisLogError(m_client.m_logger, "IO completed in Invalid state");
+            reset();
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "RedisPipelineStreamAwaitable in Invalid state"));
         }
+    }
 
-        if (m_state == State::SelectingDB) {
-            // 检查 SELECT 命令发送结果
-            auto send_result = m_send_awaitable->await_resume();
+    // ======================== RedisBorrowedReply 实现 ========================
 
+    RedisBorrowedReply::RedisBorrowedReply(RedisBorrowedReply&& other) noexcept
+        : m_client(other.m_client)
+        , m_view(other.m_view)
+        , m_generation(other.m_generation)
+    {
+        other.m_client = nullptr;
+        other.m_view = protocol::RedisReplyView();
+    }
+
+    RedisBorrowedReply& RedisBorrowedReply::operator=(RedisBorrowedReply&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            m_client = other.m_client;
+            m_view = other.m_view;
+            m_generation = other.m_generation;
+            other.m_client = nullptr;
+            other.m_view = protocol::RedisReplyView();
+        }
+        return *this;
+    }
+
+    bool RedisBorrowedReply::valid() const
+    {
+        return m_client != nullptr
+            && m_client->m_borrowed_bytes != 0
+            && m_client->m_borrow_generation == m_generation;
+    }
+
+    void RedisBorrowedReply::release() noexcept
+    {
+        // 句柄可能已被下一条命令顶替，只有仍是当前借出者时才归还
+        if (valid()) {
+            m_client->releaseBorrowed();
+        }
+        m_client = nullptr;
+        m_view = protocol::RedisReplyView();
+    }
+
+    // ======================== RedisViewAwaitable 实现 ========================
+
+    RedisViewAwaitable::RedisViewAwaitable(RedisClient& client,
+                                           std::string cmd,
+                                           std::vector<std::string> args)
+        : m_client(client)
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
+        protocol::RespEncoder::appendCommand(m_encoded_cmd, cmd, args);
+    }
+
+    RedisViewAwaitable::RedisViewAwaitable(RedisClient& client, std::string encoded)
+        : m_client(client)
+        , m_encoded_cmd(std::move(encoded))
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
+    }
+
+    void RedisViewAwaitable::resetParser() noexcept
+    {
+        m_client.m_view_parser.reset();
+    }
+
+    bool RedisViewAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        if (m_state == State::Invalid && m_client.isClosed()) {
+            m_rejected = true;
+            return false;
+        }
+        if (m_state == State::Invalid) {
+            // 开始发送命令；之前借出的回复在此失效
+            m_client.releaseBorrowed();
+            startDeadline();
+            m_state = State::Sending;
+            m_send_awaitable.emplace(m_client.m_socket.send(
+                m_encoded_cmd.c_str() + m_sent,
+                m_encoded_cmd.size() - m_sent
+            ));
+            return m_send_awaitable.suspend(handle, remainingTime());
+        }
+        else if (m_state == State::Sending) {
+            m_send_awaitable.emplace(m_client.m_socket.send(
+                m_encoded_cmd.c_str() + m_sent,
+                m_encoded_cmd.size() - m_sent
+            ));
+            return m_send_awaitable.suspend(handle, remainingTime());
+        }
+        else {
+            auto region = m_client.m_recv_buffer.getWriteSpan();
+            m_recv_awaitable.emplace(m_client.m_socket.recv(region.data(), region.size()));
+            return m_recv_awaitable.suspend(handle, remainingTime());
+        }
+    }
+
+    std::expected<std::optional<RedisBorrowedReply>, RedisError>
+    RedisViewAwaitable::await_resume()
+    {
+        if (std::exchange(m_rejected, false)) {
+            return std::unexpected(connectionClosedError());
+        }
+
+        if (m_state == State::Sending) {
+            auto send_result = m_send_awaitable.resume();
+
+            if (!send_result && isTimeout(send_result.error())) {
+                if (m_sent > 0) {
+                    // 服务端收到了半条命令，连接不能再用
+                    m_client.m_is_closed.store(true, std::memory_order_release);
+                }
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                 send_result.error().message()));
+            }
             if (!send_result) {
-                RedisLogDebug(m_client.m_logger, "Send SELECT command failed: {}", send_result.error().message());
-                m_state = State::Invalid;
-                m_send_awaitable.reset();
+                RedisLogDebug(m_client.m_logger, "send view command failed: {}", send_result.error().message());
+                reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_SEND_ERROR,
-                                                         "Send SELECT failed"));
+                                                 send_result.error().message()));
             }
 
             m_sent += send_result.value();
-
             if (m_sent < m_encoded_cmd.size()) {
-                // 发送未完成，继续发送
-                return {};
+                return std::nullopt;
             }
 
-            // 发送完成，接收 SELECT 响应
-            auto iovecs = m_client.m_ring_buffer.getWriteIovecs();
-            m_recv_awaitable.emplace(m_client.m_socket.readv(std::move(iovecs)));
-            m_recv_awaitable->await_suspend(std::coroutine_handle<>::from_address(nullptr));
-            m_recv_awaitable->await_resume();
-
-            auto recv_result = m_recv_awaitable->await_resume();
+            m_state = State::Receiving;
+            m_send_awaitable.reset();
+            return std::nullopt;
+        }
+        else if (m_state == State::Receiving) {
+            auto recv_result = m_recv_awaitable.resume();
 
+            if (!recv_result && isTimeout(recv_result.error())) {
+                // 帧数据一直留在缓冲区中，回复到达后由之后的命令整帧跳过
+                ++m_client.m_stale_replies;
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                 recv_result.error().message()));
+            }
             if (!recv_result) {
-                RedisLogDebug(m_client.m_logger, "Receive SELECT response failed: {}", recv_result.error().message());
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
+                RedisLogDebug(m_client.m_logger, "receive view response failed: {}", recv_result.error().message());
+                reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
-                                                         "Receive SELECT response failed"));
+                                                 recv_result.error().message()));
             }
 
             size_t n = recv_result.value();
             if (n == 0) {
-                RedisLogDebug(m_client.m_logger, "Connection closed during SELECT");
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
+                RedisLogDebug(m_client.m_logger, "connection closed by peer");
+                reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
-                                                         "Connection closed"));
+                                                 "Connection closed"));
             }
 
-            m_client.m_ring_buffer.produce(n);
+            m_client.m_recv_buffer.produce(n);
 
-            // 解析 SELECT 响应
-            auto read_iovecs = m_client.m_ring_buffer.getReadIovecs();
-            if (read_iovecs.empty()) {
-                RedisLogDebug(m_client.m_logger, "SELECT response incomplete");
-                return {};  // 继续接收
+            auto skipped = m_client.skipStaleReplies();
+            if (!skipped) {
+                RedisLogDebug(m_client.m_logger, "parse error in stale reply");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
             }
-
-            const char* data = static_cast<const char*>(read_iovecs[0].iov_base);
-            size_t len = read_iovecs[0].iov_len;
-            if (read_iovecs.size() > 1) {
-                len += read_iovecs[1].iov_len;
+            if (!*skipped) {
+                return std::nullopt;
             }
 
-            auto parse_result = m_client.m_parser.parse(data, len);
+            size_t len = m_client.m_recv_buffer.readable();
+            const char* data = m_client.m_recv_buffer.data();
+            if (len == 0) {
+                return std::nullopt;
+            }
 
+            auto parse_result = m_client.m_view_parser.parse(data, len, m_client.m_view_nodes);
             if (!parse_result) {
                 if (parse_result.error() == protocol::ParseError::Incomplete) {
-                    return {};  // 继续接收
+                    RedisLogDebug(m_client.m_logger, "view parse incomplete, continue receiving");
+                    return std::nullopt;
                 }
-                RedisLogDebug(m_client.m_logger, "Parse SELECT response error");
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
+                RedisLogDebug(m_client.m_logger, "view parse error");
+                reset();
                 return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
-                                                         "Parse SELECT response error"));
+                                                 "Parse error"));
             }
 
-            auto [consumed, value] = parse_result.value();
-            m_client.m_ring_buffer.consume(consumed);
+            // 帧数据留在缓冲区中，直到借用句柄归还
+            m_client.m_borrowed_bytes = parse_result.value();
+            ++m_client.m_borrow_generation;
+            RedisBorrowedReply reply(&m_client,
+                                     protocol::RedisReplyView(data, m_client.m_view_nodes.data()),
+                                     m_client.m_borrow_generation);
+            reset();
+            return std::optional<RedisBorrowedReply>(std::move(reply));
+        }
+        else {
+            RedisLogError(m_client.m_logger, "await_resume called in Invalid state");
+            reset();
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "RedisViewAwaitable in Invalid state"));
+        }
+    }
+
+    // ======================== RedisVisitAwaitable 实现 ========================
 
-            // 检查 SELECT 结果
-            if (value.isError()) {
-                RedisLogDebug(m_client.m_logger, "SELECT failed: {}", value.asString());
-                m_state = State::Invalid;
-                m_recv_awaitable.reset();
-                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INVALID_ERROR,
-                                                         "SELECT failed: " + value.asString()));
+    RedisVisitAwaitable::RedisVisitAwaitable(RedisClient& client,
+                                             std::string cmd,
+                                             std::vector<std::string> args,
+                                             protocol::RespVisitor& visitor)
+        : m_client(client)
+        , m_visitor(&visitor)
+        , m_state(State::Invalid)
+        , m_sent(0)
+        , m_visited(0)
+    {
+        protocol::RespEncoder::appendCommand(m_encoded_cmd, cmd, args);
+    }
+
+    void RedisVisitAwaitable::resetParser() noexcept
+    {
+        m_client.m_visit_parser.reset();
+    }
+
+    bool RedisVisitAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        if (m_state == State::Invalid && m_client.isClosed()) {
+            m_rejected = true;
+            return false;
+        }
+        if (m_state == State::Invalid) {
+            // 开始发送命令
+            m_client.releaseBorrowed();
+            startDeadline();
+            m_state = State::Sending;
+            m_send_awaitable.emplace(m_client.m_socket.send(
+                m_encoded_cmd.c_str() + m_sent,
+                m_encoded_cmd.size() - m_sent
+            ));
+            return m_send_awaitable.suspend(handle, remainingTime());
+        }
+        else if (m_state == State::Sending) {
+            m_send_awaitable.emplace(m_client.m_socket.send(
+                m_encoded_cmd.c_str() + m_sent,
+                m_encoded_cmd.size() - m_sent
+            ));
+            return m_send_awaitable.suspend(handle, remainingTime());
+        }
+        else {
+            auto region = m_client.m_recv_buffer.getWriteSpan();
+            m_recv_awaitable.emplace(m_client.m_socket.recv(region.data(), region.size()));
+            return m_recv_awaitable.suspend(handle, remainingTime());
+        }
+    }
+
+    std::expected<std::optional<size_t>, RedisError>
+    RedisVisitAwaitable::await_resume()
+    {
+        if (std::exchange(m_rejected, false)) {
+            return std::unexpected(connectionClosedError());
+        }
+
+        if (m_state == State::Sending) {
+            auto send_result = m_send_awaitable.resume();
+
+            if (!send_result && isTimeout(send_result.error())) {
+                if (m_sent > 0) {
+                    // 服务端收到了半条命令，连接不能再用
+                    m_client.m_is_closed.store(true, std::memory_order_release);
+                }
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                 send_result.error().message()));
+            }
+            if (!send_result) {
+                RedisLogDebug(m_client.m_logger, "send visit command failed: {}", send_result.error().message());
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_SEND_ERROR,
+                                                 send_result.error().message()));
             }
 
-            RedisLogDebug(m_client.m_logger, "SELECT succeeded, db_index: {}", m_db_index);
+            m_sent += send_result.value();
+            if (m_sent < m_encoded_cmd.size()) {
+                return std::nullopt;
+            }
 
-            // 完成
-            m_state = State::Done;
-            m_recv_awaitable.reset();
-            return {};
+            m_state = State::Receiving;
+            m_send_awaitable.reset();
+            return std::nullopt;
+        }
+        else if (m_state == State::Receiving) {
+            auto recv_result = m_recv_awaitable.resume();
+
+            if (!recv_result && isTimeout(recv_result.error())) {
+                if (!m_client.hasStaleReplies()) {
+                    // 本帧可能已回调并释放了一部分，解析器连同进度交给跳过逻辑，从断点继续丢弃
+                    std::swap(m_client.m_stale_parser, m_client.m_visit_parser);
+                }
+                ++m_client.m_stale_replies;
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                 recv_result.error().message()));
+            }
+            if (!recv_result) {
+                RedisLogDebug(m_client.m_logger, "receive visit response failed: {}", recv_result.error().message());
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
+                                                 recv_result.error().message()));
+            }
+
+            size_t n = recv_result.value();
+            if (n == 0) {
+                RedisLogDebug(m_client.m_logger, "connection closed by peer");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
+                                                 "Connection closed"));
+            }
+
+            m_client.m_recv_buffer.produce(n);
+
+            auto skipped = m_client.skipStaleReplies();
+            if (!skipped) {
+                RedisLogDebug(m_client.m_logger, "parse error in stale reply");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
+            }
+            if (!*skipped) {
+                return std::nullopt;
+            }
+
+            size_t len = m_client.m_recv_buffer.readable();
+            const char* data = m_client.m_recv_buffer.data();
+            if (len == 0) {
+                return std::nullopt;
+            }
+
+            auto progress = m_client.m_visit_parser.parse(data, len, *m_visitor);
+            if (!progress) {
+                RedisLogDebug(m_client.m_logger, "visit parse error");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
+            }
+
+            // 已回调的元素立即释放，腾出空间接收后续数据
+            m_client.m_recv_buffer.consume(progress->consumed);
+            m_visited += progress->consumed;
+            if (!progress->done) {
+                return std::nullopt;
+            }
+
+            size_t total = m_visited;
+            reset();
+            return std::optional<size_t>(total);
+        }
+        else {
+            RedisLogError(m_client.m_logger, "await_resume called in Invalid state");
+            reset();
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "RedisVisitAwaitable in Invalid state"));
+        }
+    }
+
+    // ======================== RedisStreamAwaitable 实现 ========================
+
+    RedisStreamAwaitable::RedisStreamAwaitable(RedisClient& client,
+                                               std::string encoded_cmd,
+                                               protocol::RespBulkSink sink)
+        : m_client(client)
+        , m_sink(std::move(sink))
+        , m_encoded_cmd(std::move(encoded_cmd))
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
+    }
+
+    void RedisStreamAwaitable::resetParser() noexcept
+    {
+        m_client.m_stream_parser.reset();
+    }
+
+    bool RedisStreamAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        if (m_state == State::Invalid && m_client.isClosed()) {
+            m_rejected = true;
+            return false;
+        }
+        if (m_state == State::Invalid) {
+            // 开始发送命令
+            m_client.releaseBorrowed();
+            startDeadline();
+            m_state = State::Sending;
+            m_send_awaitable.emplace(m_client.m_socket.send(
+                m_encoded_cmd.c_str() + m_sent,
+                m_encoded_cmd.size() - m_sent
+            ));
+            return m_send_awaitable.suspend(handle, remainingTime());
+        }
+        else if (m_state == State::Sending) {
+            m_send_awaitable.emplace(m_client.m_socket.send(
+                m_encoded_cmd.c_str() + m_sent,
+                m_encoded_cmd.size() - m_sent
+            ));
+            return m_send_awaitable.suspend(handle, remainingTime());
+        }
+        else {
+            auto region = m_client.m_recv_buffer.getWriteSpan();
+            m_recv_awaitable.emplace(m_client.m_socket.recv(region.data(), region.size()));
+            return m_recv_awaitable.suspend(handle, remainingTime());
+        }
+    }
+
+    std::expected<std::optional<protocol::RespBulkStreamResult>, RedisError>
+    RedisStreamAwaitable::await_resume()
+    {
+        if (std::exchange(m_rejected, false)) {
+            return std::unexpected(connectionClosedError());
+        }
+
+        if (m_state == State::Sending) {
+            auto send_result = m_send_awaitable.resume();
+
+            if (!send_result && isTimeout(send_result.error())) {
+                if (m_sent > 0) {
+                    // 服务端收到了半条命令，连接不能再用
+                    m_client.m_is_closed.store(true, std::memory_order_release);
+                }
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                 send_result.error().message()));
+            }
+            if (!send_result) {
+                RedisLogDebug(m_client.m_logger, "send stream command failed: {}", send_result.error().message());
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_SEND_ERROR,
+                                                 send_result.error().message()));
+            }
+
+            m_sent += send_result.value();
+            if (m_sent < m_encoded_cmd.size()) {
+                return std::nullopt;
+            }
+
+            m_state = State::Receiving;
+            m_send_awaitable.reset();
+            return std::nullopt;
+        }
+        else if (m_state == State::Receiving) {
+            auto recv_result = m_recv_awaitable.resume();
+
+            if (!recv_result && isTimeout(recv_result.error())) {
+                if (!m_client.hasStaleReplies()) {
+                    // 已交给 sink 的分片不会重发，解析器连同进度交给跳过逻辑，剩余内容直接丢弃
+                    std::swap(m_client.m_stale_stream_parser, m_client.m_stream_parser);
+                    m_client.m_stale_stream = true;
+                } else {
+                    ++m_client.m_stale_replies;
+                }
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                 recv_result.error().message()));
+            }
+            if (!recv_result) {
+                RedisLogDebug(m_client.m_logger, "receive stream response failed: {}", recv_result.error().message());
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
+                                                 recv_result.error().message()));
+            }
+
+            size_t n = recv_result.value();
+            if (n == 0) {
+                RedisLogDebug(m_client.m_logger, "connection closed by peer");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
+                                                 "Connection closed"));
+            }
+
+            m_client.m_recv_buffer.produce(n);
+
+            auto skipped = m_client.skipStaleReplies();
+            if (!skipped) {
+                RedisLogDebug(m_client.m_logger, "parse error in stale reply");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
+            }
+            if (!*skipped) {
+                return std::nullopt;
+            }
+
+            auto& parser = m_client.m_stream_parser;
+            auto progress = parser.parse(m_client.m_recv_buffer.data(), m_client.m_recv_buffer.readable(), m_sink);
+            if (!progress) {
+                RedisLogDebug(m_client.m_logger, "stream parse error");
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 "Parse error"));
+            }
+
+            // 已交给 sink 的分片立即释放，缓冲区不会因为大值而扩容
+            m_client.m_recv_buffer.consume(progress->consumed);
+            if (!progress->done) {
+                return std::nullopt;
+            }
+
+            if (parser.isError()) {
+                std::string message = parser.errorMessage();
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_COMMAND_ERROR, message));
+            }
+            if (parser.sinkStopped()) {
+                reset();
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INVALID_ERROR,
+                                                 "Stream sink stopped"));
+            }
+            auto result = parser.result();
+            reset();
+            return std::optional<protocol::RespBulkStreamResult>(result);
+        }
+        else {
+            RedisLogError(m_client.m_logger, "await_resume called in Invalid state");
+            reset();
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "RedisStreamAwaitable in Invalid state"));
         }
+    }
+
+    // ======================== RedisConnectAwaitable 实现 ========================
+
+    RedisConnectAwaitable::RedisConnectAwaitable(RedisClient& client,
+                                                 std::string ip,
+                                                 int32_t port,
+                                                 std::string username,
+                                                 std::string password,
+                                                 int32_t db_index,
+                                                 int version)
+        : m_client(client)
+        , m_ip(std::move(ip))
+        , m_port(port)
+        , m_username(std::move(username))
+        , m_password(std::move(password))
+        , m_db_index(db_index)
+        , m_version(version)
+        , m_state(State::Invalid)
+        , m_sent(0)
+    {
+    }
+
+    bool RedisConnectAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        return m_client.drive(*this, handle);
+    }
 
-        if (m_state == State::Done) {
+    RedisVoidResult RedisConnectAwaitable::await_resume()
+    {
+        if (takeRejected()) {
+            return std::unexpected(connectionClosedError());
+        }
+        if (!m_final.has_value()) {
+            RedisLogError(m_client.m_logger, "await_resume called without result");
             m_state = State::Invalid;
-            return {};
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                                     "RedisConnectAwaitable resumed without result"));
+        }
+        auto result = std::move(*m_final);
+        m_final.reset();
+        return result;
+    }
+
+    bool RedisConnectAwaitable::suspendStep(std::coroutine_handle<> handle)
+    {
+        if (m_state == State::Invalid) {
+            // 开始连接
+            startDeadline();
+            m_client.clearStaleReplies();
+            m_state = State::Connecting;
+            m_receiving = false;
+
+            // 创建 Host 对象并连接
+            Host host(m_version == 4 ? IPType::IPV4 : IPType::IPV6, m_ip, m_port);
+            m_connect_awaitable.emplace(m_client.m_socket.connect(host));
+            return m_connect_awaitable.suspend(handle, remainingTime());
+        }
+
+        if (m_receiving) {
+            // 接收认证 / SELECT 的回复
+            auto region = m_client.m_recv_buffer.getWriteSpan();
+            m_recv_awaitable.emplace(m_client.m_socket.recv(region.data(), region.size()));
+            return m_recv_awaitable.suspend(handle, remainingTime());
+        }
+
+        // 发送认证 / SELECT 命令（未发完时从已发送位置继续）
+        m_send_awaitable.emplace(m_client.m_socket.send(
+            m_encoded_cmd.c_str() + m_sent,
+            m_encoded_cmd.size() - m_sent
+        ));
+        return m_send_awaitable.suspend(handle, remainingTime());
+    }
+
+    bool RedisConnectAwaitable::resumeStep()
+    {
+        if (m_state == State::Connecting) {
+            // 检查连接结果
+            auto connect_result = m_connect_awaitable.resume();
+            m_connect_awaitable.reset();
+
+            if (!connect_result && isTimeout(connect_result.error())) {
+                return finish(std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                         "Connection timed out: " + connect_result.error().message())));
+            }
+            if (!connect_result) {
+                // 连接失败
+                RedisLogDebug(m_client.m_logger, "Connection to {}:{} failed: {}",
+                              m_ip, m_port, connect_result.error().message());
+                return finish(std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
+                                                         "Connection failed: " + connect_result.error().message())));
+            }
+            return nextStage() ? false : finish({});
+        }
+
+        if (m_state == State::Authenticating || m_state == State::SelectingDB) {
+            auto result = onCommandIO();
+            if (!result.has_value()) {
+                return false;
+            }
+            if (!*result) {
+                return finish(std::move(*result));
+            }
+            return nextStage() ? false : finish({});
         }
 
         // Invalid 状态
-        RedisLogError(m_client.m_logger, "await_resume called in Invalid state");
+        RedisLogError(m_client.m_logger, "IO completed in Invalid state");
+        return finish(std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                                 "RedisConnectAwaitable in Invalid state")));
+    }
+
+    bool RedisConnectAwaitable::nextStage()
+    {
+        // 连接建立 -> AUTH（有用户名或密码时）-> SELECT（db_index 非0时）
+        m_encoded_cmd.clear();
+        m_sent = 0;
+        m_receiving = false;
+        if (m_state == State::Connecting && !(m_username.empty() && m_password.empty())) {
+            m_state = State::Authenticating;
+            if (m_username.empty()) {
+                protocol::RespEncoder::appendCommandArgs(m_encoded_cmd, "AUTH", m_password);
+            } else {
+                protocol::RespEncoder::appendCommandArgs(m_encoded_cmd, "AUTH", m_username, m_password);
+            }
+            return true;
+        }
+        if (m_state != State::SelectingDB && m_db_index != 0) {
+            m_state = State::SelectingDB;
+            protocol::RespEncoder::appendCommandArgs(m_encoded_cmd, "SELECT", m_db_index);
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<RedisVoidResult> RedisConnectAwaitable::onCommandIO()
+    {
+        const char* name = m_state == State::Authenticating ? "AUTH" : "SELECT";
+
+        if (!m_receiving) {
+            // 检查命令发送结果
+            auto send_result = m_send_awaitable.resume();
+            m_send_awaitable.reset();
+
+            if (!send_result && isTimeout(send_result.error())) {
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                                  std::string("Send ") + name + " timed out"));
+            }
+            if (!send_result) {
+                RedisLogDebug(m_client.m_logger, "Send {} command failed: {}", name, send_result.error().message());
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_SEND_ERROR,
+                                                  std::string("Send ") + name + " failed: " + send_result.error().message()));
+            }
+
+            m_sent += send_result.value();
+            // 发送完成后接收回复，否则继续发送
+            m_receiving = m_sent >= m_encoded_cmd.size();
+            return std::nullopt;
+        }
+
+        auto recv_result = m_recv_awaitable.resume();
+        m_recv_awaitable.reset();
+
+        if (!recv_result && isTimeout(recv_result.error())) {
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                                              std::string("Receive ") + name + " response timed out"));
+        }
+        if (!recv_result) {
+            RedisLogDebug(m_client.m_logger, "Receive {} response failed: {}", name, recv_result.error().message());
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
+                                              std::string("Receive ") + name + " response failed"));
+        }
+
+        size_t n = recv_result.value();
+        if (n == 0) {
+            RedisLogDebug(m_client.m_logger, "Connection closed during {}", name);
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED,
+                                              "Connection closed"));
+        }
+
+        m_client.m_recv_buffer.produce(n);
+
+        auto parse_result = m_client.m_parser.parse(m_client.m_recv_buffer.data(),
+                                                    m_client.m_recv_buffer.readable());
+        if (!parse_result) {
+            if (parse_result.error() == protocol::ParseError::Incomplete) {
+                RedisLogDebug(m_client.m_logger, "{} response incomplete", name);
+                return std::nullopt;  // 继续接收
+            }
+            RedisLogDebug(m_client.m_logger, "Parse {} response error", name);
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                              std::string("Parse ") + name + " response error"));
+        }
+
+        auto& [consumed, value] = parse_result.value();
+        m_client.m_recv_buffer.consume(consumed);
+
+        if (value.isError()) {
+            RedisLogDebug(m_client.m_logger, "{} failed: {}", name, value.asString());
+            auto type = m_state == State::Authenticating ? RedisErrorType::REDIS_ERROR_TYPE_AUTH_ERROR
+                                                         : RedisErrorType::REDIS_ERROR_TYPE_INVALID_ERROR;
+            return std::unexpected(RedisError(type, std::string(name) + " failed: " + value.asString()));
+        }
+
+        RedisLogDebug(m_client.m_logger, "{} succeeded", name);
+        return RedisVoidResult{};
+    }
+
+    bool RedisConnectAwaitable::finish(RedisVoidResult result)
+    {
+        if (!result && result.error().type() == RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR) {
+            // 握手停在中途，这条连接不能再用
+            m_client.m_is_closed.store(true, std::memory_order_release);
+        }
         m_state = State::Invalid;
-        return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
-                                                 "RedisConnectAwaitable in Invalid state"));
+        m_receiving = false;
+        m_connect_awaitable.reset();
+        m_send_awaitable.reset();
+        m_recv_awaitable.reset();
+        clearTimeout();
+        m_final = std::move(result);
+        return true;
     }
 
     // ======================== RedisClient 实现 ========================
 
     RedisClient::RedisClient(IOScheduler* scheduler, AsyncRedisConfig config)
-        : m_scheduler(scheduler), m_config(config), m_ring_buffer(config.buffer_size)
+        : m_scheduler(scheduler), m_config(config)
+        , m_adaptive_window(RedisAdaptiveWindowConfig{
+              .initial_window = config.adaptive_window_initial,
+              .max_window = config.adaptive_window_max})
+        , m_recv_buffer(config.buffer_size)
     {
         try {
             m_logger = spdlog::get("AsyncRedisLogger");
@@ -686,16 +1580,30 @@ namespace galay::redis
     }
 
     RedisClient::RedisClient(RedisClient&& other) noexcept
-        : m_is_closed(other.m_is_closed)
+        : m_is_closed(other.m_is_closed.load())
         , m_socket(std::move(other.m_socket))
         , m_scheduler(other.m_scheduler)
         , m_encoder(std::move(other.m_encoder))
         , m_parser(std::move(other.m_parser))
         , m_config(other.m_config)
-        , m_ring_buffer(std::move(other.m_ring_buffer))
+        , m_adaptive_window(other.m_adaptive_window)
+        , m_recv_buffer(std::move(other.m_recv_buffer))
+        , m_view_parser(std::move(other.m_view_parser))
+        , m_view_nodes(std::move(other.m_view_nodes))
+        , m_tape_parser(std::move(other.m_tape_parser))
+        , m_tape_entries(std::move(other.m_tape_entries))
+        , m_visit_parser(std::move(other.m_visit_parser))
+        , m_stream_parser(std::move(other.m_stream_parser))
+        , m_borrowed_bytes(other.m_borrowed_bytes)
+        , m_borrow_generation(other.m_borrow_generation)
+        , m_stale_replies(other.m_stale_replies)
+        , m_stale_parser(std::move(other.m_stale_parser))
+        , m_stale_stream(other.m_stale_stream)
+        , m_stale_stream_parser(std::move(other.m_stale_stream_parser))
         , m_cmd_awaitable(std::move(other.m_cmd_awaitable))
         , m_pipeline_awaitable(std::move(other.m_pipeline_awaitable))
         , m_connect_awaitable(std::move(other.m_connect_awaitable))
+        , m_driver(std::move(other.m_driver))
         , m_logger(std::move(other.m_logger))
     {
         other.m_is_closed = true;
@@ -704,18 +1612,38 @@ namespace galay::redis
     RedisClient& RedisClient::operator=(RedisClient&& other) noexcept
     {
         if (this != &other) {
-            m_is_closed = other.m_is_closed;
+            m_is_closed = other.m_is_closed.load();
             m_socket = std::move(other.m_socket);
             m_scheduler = other.m_scheduler;
             m_encoder = std::move(other.m_encoder);
             m_parser = std::move(other.m_parser);
             m_config = other.m_config;
-            m_ring_buffer = std::move(other.m_ring_buffer);
+            m_adaptive_window = other.m_adaptive_window;
+            m_recv_buffer = std::move(other.m_recv_buffer);
+            m_view_parser = std::move(other.m_view_parser);
+            m_view_nodes = std::move(other.m_view_nodes);
+            m_tape_parser = std::move(other.m_tape_parser);
+            m_tape_entries = std::move(other.m_tape_entries);
+            m_visit_parser = std::move(other.m_visit_parser);
+            m_stream_parser = std::move(other.m_stream_parser);
+            m_borrowed_bytes = other.m_borrowed_bytes;
+            m_borrow_generation = other.m_borrow_generation;
+            m_stale_replies = other.m_stale_replies;
+            m_stale_parser = std::move(other.m_stale_parser);
+            m_stale_stream = other.m_stale_stream;
+            m_stale_stream_parser = std::move(other.m_stale_stream_parser);
 
             // 手动处理optional成员，因为awaitable不可复制
             m_cmd_awaitable.reset();
             m_pipeline_awaitable.reset();
+            m_pipeline_stream_awaitable.reset();
             m_connect_awaitable.reset();
+            m_view_awaitable.reset();
+            m_visit_awaitable.reset();
+            m_stream_awaitable.reset();
+
+            stopDriver();
+            m_driver = std::move(other.m_driver);
 
             m_logger = std::move(other.m_logger);
             other.m_is_closed = true;
@@ -723,135 +1651,402 @@ namespace galay::redis
         return *this;
     }
 
+    RedisClient::~RedisClient()
+    {
+        stopDriver();
+    }
+
+    // ======================== 驱动协程 ========================
+
+    bool RedisClient::drive(RedisDrivenStep& step, std::coroutine_handle<> handle)
+    {
+        step.m_done = false;
+        step.m_waiter = {};
+        if (isClosed()) {
+            step.m_rejected = true;
+            return false;
+        }
+        if (!m_driver || m_driver->stopped) {
+            auto state = std::make_shared<DriverState>();
+            if (m_driver) {
+                state->stats = m_driver->stats;
+            }
+            state->step = &step;
+            m_driver = state;
+            m_scheduler->spawn(driveLoop(std::move(state)));
+        } else {
+            // 驱动协程正在恢复上一个调用方时只登记，它回到循环后继续执行
+            m_driver->step = &step;
+            if (m_driver->idle) {
+                std::exchange(m_driver->idle, {}).resume();
+            }
+        }
+        // IO 全部同步完成时不挂起
+        if (step.m_done) {
+            return false;
+        }
+        step.m_waiter = handle;
+        return true;
+    }
+
+    void RedisClient::stopDriver() noexcept
+    {
+        if (!m_driver) {
+            return;
+        }
+        m_driver->stopped = true;
+        m_driver->step = nullptr;
+        if (m_driver->idle) {
+            std::exchange(m_driver->idle, {}).resume();
+        }
+        m_driver.reset();
+    }
+
+    Coroutine RedisClient::driveLoop(std::shared_ptr<DriverState> state)
+    {
+        while (true) {
+            co_await DriverIdle{*state};
+            if (state->stopped) {
+                break;
+            }
+            if (state->step == nullptr) {
+                continue;
+            }
+
+            // 反复发起 IO 并处理结果，直到等待体得到最终结果
+            auto* step = state->step;
+            bool done = false;
+            while (!done) {
+                co_await DriverStep{*state, *step};
+                if (state->stopped) {
+                    co_return;
+                }
+                done = step->resumeStep();
+            }
+
+            // 恢复调用方之后不再访问 step：调用方可能立即发起下一条命令并重建等待体
+            state->step = nullptr;
+            ++state->stats.operations;
+            step->m_done = true;
+            if (auto waiter = std::exchange(step->m_waiter, {})) {
+                waiter.resume();
+            }
+        }
+    }
+
     // ======================== 命令方法 ========================
 
     RedisClientAwaitable& RedisClient::execute(const std::string& cmd, const std::vector<std::string>& args)
     {
         // 只有当 awaitable 不存在或状态为 Invalid 时，才创建新的
         if (!m_cmd_awaitable.has_value() || m_cmd_awaitable->isInvalid()) {
-            m_cmd_awaitable.emplace(*this, cmd, args, 1);
+            std::string encoded = takeCommandBuffer();
+            protocol::RespEncoder::appendCommand(encoded, cmd, args);
+            m_cmd_awaitable.emplace(*this, std::move(encoded), 1);
+        }
+        return *m_cmd_awaitable;
+    }
+
+    std::string RedisClient::takeCommandBuffer()
+    {
+        std::string buffer;
+        if (m_cmd_awaitable.has_value()) {
+            // 上一个等待体已是 Invalid，发送早已完成，缓冲区可以直接接管
+            buffer = std::move(m_cmd_awaitable->m_encoded_cmd);
+            buffer.clear();
+        }
+        return buffer;
+    }
+
+    std::string RedisClient::takeViewBuffer()
+    {
+        std::string buffer;
+        if (m_view_awaitable.has_value()) {
+            buffer = std::move(m_view_awaitable->m_encoded_cmd);
+            buffer.clear();
+        }
+        return buffer;
+    }
+
+    RedisClientAwaitable& RedisClient::executeVectored(std::string_view cmd,
+                                                       const std::vector<std::string_view>& args)
+    {
+        if (!m_cmd_awaitable.has_value() || m_cmd_awaitable->isInvalid()) {
+            protocol::RespVectoredCommand command(m_config.writev_threshold);
+            command.append(cmd, args);
+            m_cmd_awaitable.emplace(*this, std::move(command), 1);
+        }
+        return *m_cmd_awaitable;
+    }
+
+    RedisClientAwaitable& RedisClient::executeFromFile(const std::string& cmd,
+                                                       const std::vector<std::string>& args,
+                                                       RedisFileRegion file)
+    {
+        if (!m_cmd_awaitable.has_value() || m_cmd_awaitable->isInvalid()) {
+            // 编码到最后一个参数的长度头为止，内容由 sendfile 发送
+            std::string header = takeCommandBuffer();
+            protocol::RespEncoder::appendArrayHeader(header, args.size() + 2);
+            protocol::RespEncoder::appendBulkString(header, cmd);
+            for (const auto& arg : args) {
+                protocol::RespEncoder::appendBulkString(header, arg);
+            }
+            protocol::RespEncoder::appendBulkHeader(header, file.length);
+            m_cmd_awaitable.emplace(*this, std::move(header), file);
         }
         return *m_cmd_awaitable;
     }
 
+    RedisViewAwaitable& RedisClient::executeView(const std::string& cmd, const std::vector<std::string>& args)
+    {
+        if (!m_view_awaitable.has_value() || m_view_awaitable->isInvalid()) {
+            std::string encoded = takeViewBuffer();
+            protocol::RespEncoder::appendCommand(encoded, cmd, args);
+            m_view_awaitable.emplace(*this, std::move(encoded));
+        }
+        return *m_view_awaitable;
+    }
+
+    RedisVisitAwaitable& RedisClient::executeVisit(const std::string& cmd, const std::vector<std::string>& args,
+                                                   protocol::RespVisitor& visitor)
+    {
+        if (!m_visit_awaitable.has_value() || m_visit_awaitable->isInvalid()) {
+            m_visit_awaitable.emplace(*this, cmd, args, visitor);
+        }
+        return *m_visit_awaitable;
+    }
+
+    RedisStreamAwaitable& RedisClient::getStream(const std::string& key, protocol::RespBulkSink sink)
+    {
+        if (!m_stream_awaitable.has_value() || m_stream_awaitable->isInvalid()) {
+            m_stream_awaitable.emplace(*this, protocol::Command<"GET", 1>::encode(key), std::move(sink));
+        }
+        return *m_stream_awaitable;
+    }
+
+    RedisStreamAwaitable& RedisClient::getToFd(const std::string& key, int fd) {
+        return getStream(key, protocol::makeFdSink(fd));
+    }
+
+    RedisViewAwaitable& RedisClient::getView(const std::string& key) {
+        // 不经过 executeView 的参数 vector，命令直接编码到复用的缓冲区
+        if (!m_view_awaitable.has_value() || m_view_awaitable->isInvalid()) {
+            std::string encoded = takeViewBuffer();
+            protocol::Command<"GET", 1>::append(encoded, key);
+            m_view_awaitable.emplace(*this, std::move(encoded));
+        }
+        return *m_view_awaitable;
+    }
+
+    void RedisClient::releaseBorrowed() noexcept
+    {
+        if (m_borrowed_bytes != 0) {
+            m_recv_buffer.consume(m_borrowed_bytes);
+            m_borrowed_bytes = 0;
+        }
+    }
+
+    std::expected<bool, protocol::ParseError> RedisClient::skipStaleReplies()
+    {
+        if (m_stale_stream) {
+            // 先读完 getStream 超时时交付到一半的帧，剩余内容不再交给 sink
+            static const protocol::RespBulkSink discard = [](std::string_view) { return true; };
+            auto progress = m_stale_stream_parser.parse(m_recv_buffer.data(), m_recv_buffer.readable(), discard);
+            if (!progress) {
+                m_stale_stream_parser.reset();
+                return std::unexpected(progress.error());
+            }
+            m_recv_buffer.consume(progress->consumed);
+            if (!progress->done) {
+                return false;
+            }
+            m_stale_stream_parser.reset();
+            m_stale_stream = false;
+        }
+
+        // 访问者不做任何事，整帧按字节跳过，已跳过的部分立即释放
+        protocol::RespVisitor ignore;
+        while (m_stale_replies > 0) {
+            if (m_recv_buffer.empty()) {
+                return false;
+            }
+            auto progress = m_stale_parser.parse(m_recv_buffer.data(), m_recv_buffer.readable(), ignore);
+            if (!progress) {
+                m_stale_parser.reset();
+                return std::unexpected(progress.error());
+            }
+            m_recv_buffer.consume(progress->consumed);
+            if (!progress->done) {
+                return false;
+            }
+            --m_stale_replies;
+        }
+        return true;
+    }
+
+    void RedisClient::clearStaleReplies() noexcept
+    {
+        m_stale_replies = 0;
+        m_stale_parser.reset();
+        m_stale_stream = false;
+        m_stale_stream_parser.reset();
+    }
+
+    std::expected<std::pair<size_t, RedisValue>, protocol::ParseError>
+    RedisClient::parseValue(const char* data, size_t length)
+    {
+        if (m_config.decode_mode == RedisDecodeMode::Arena) {
+            auto result = m_view_parser.parse(data, length, m_view_nodes);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+            // 节点数组和整帧一次拷入arena，之后与接收缓冲区无关
+            auto arena = std::make_shared<const protocol::RespArenaReply>(data, *result, m_view_nodes);
+            return std::make_pair(*result, RedisValue(std::move(arena)));
+        }
+
+        if (m_config.decode_mode == RedisDecodeMode::Tape) {
+            auto result = m_tape_parser.parse(data, length, m_tape_entries);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+            auto tape = std::make_shared<const protocol::RespTapeReply>(data, *result, m_tape_entries);
+            return std::make_pair(*result, RedisValue(std::move(tape)));
+        }
+
+        auto result = m_parser.parse(data, length);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+        return std::make_pair(result->first, RedisValue(std::move(result->second)));
+    }
+
     RedisClientAwaitable& RedisClient::auth(const std::string& password) {
-        return execute("AUTH", {password});
+        return executeCommand<protocol::Command<"AUTH", 1>>(password);
     }
 
     RedisClientAwaitable& RedisClient::auth(const std::string& username, const std::string& password) {
-        return execute("AUTH", {username, password});
+        return executeCommand<protocol::Command<"AUTH", 2>>(username, password);
     }
 
     RedisClientAwaitable& RedisClient::select(int32_t db_index) {
-        return execute("SELECT", {std::to_string(db_index)});
+        return executeCommand<protocol::Command<"SELECT", 1>>(db_index);
     }
 
     RedisClientAwaitable& RedisClient::ping() {
-        return execute("PING", {});
+        return executeCommand<protocol::Command<"PING", 0>>();
     }
 
     RedisClientAwaitable& RedisClient::echo(const std::string& message) {
-        return execute("ECHO", {message});
+        return executeCommand<protocol::Command<"ECHO", 1>>(message);
     }
 
     RedisClientAwaitable& RedisClient::get(const std::string& key) {
-        return execute("GET", {key});
+        return executeCommand<protocol::Command<"GET", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::set(const std::string& key, const std::string& value) {
-        return execute("SET", {key, value});
+        return executeCommand<protocol::Command<"SET", 2>>(key, value);
     }
 
     RedisClientAwaitable& RedisClient::setex(const std::string& key, int64_t seconds, const std::string& value) {
-        return execute("SETEX", {key, std::to_string(seconds), value});
+        return executeCommand<protocol::Command<"SETEX", 3>>(key, seconds, value);
+    }
+
+    RedisClientAwaitable& RedisClient::setVectored(std::string_view key, std::string_view value) {
+        return executeVectored("SET", {key, value});
+    }
+
+    RedisClientAwaitable& RedisClient::setFromFile(const std::string& key, int fd, off_t offset, size_t length) {
+        return executeFromFile("SET", {key}, RedisFileRegion{fd, offset, length});
     }
 
     RedisClientAwaitable& RedisClient::del(const std::string& key) {
-        return execute("DEL", {key});
+        return executeCommand<protocol::Command<"DEL", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::exists(const std::string& key) {
-        return execute("EXISTS", {key});
+        return executeCommand<protocol::Command<"EXISTS", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::incr(const std::string& key) {
-        return execute("INCR", {key});
+        return executeCommand<protocol::Command<"INCR", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::decr(const std::string& key) {
-        return execute("DECR", {key});
+        return executeCommand<protocol::Command<"DECR", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::hget(const std::string& key, const std::string& field) {
-        return execute("HGET", {key, field});
+        return executeCommand<protocol::Command<"HGET", 2>>(key, field);
     }
 
     RedisClientAwaitable& RedisClient::hset(const std::string& key, const std::string& field, const std::string& value) {
-        return execute("HSET", {key, field, value});
+        return executeCommand<protocol::Command<"HSET", 3>>(key, field, value);
     }
 
     RedisClientAwaitable& RedisClient::hdel(const std::string& key, const std::string& field) {
-        return execute("HDEL", {key, field});
+        return executeCommand<protocol::Command<"HDEL", 2>>(key, field);
     }
 
     RedisClientAwaitable& RedisClient::hgetAll(const std::string& key) {
-        return execute("HGETALL", {key});
+        return executeCommand<protocol::Command<"HGETALL", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::lpush(const std::string& key, const std::string& value) {
-        return execute("LPUSH", {key, value});
+        return executeCommand<protocol::Command<"LPUSH", 2>>(key, value);
     }
 
     RedisClientAwaitable& RedisClient::rpush(const std::string& key, const std::string& value) {
-        return execute("RPUSH", {key, value});
+        return executeCommand<protocol::Command<"RPUSH", 2>>(key, value);
     }
 
     RedisClientAwaitable& RedisClient::lpop(const std::string& key) {
-        return execute("LPOP", {key});
+        return executeCommand<protocol::Command<"LPOP", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::rpop(const std::string& key) {
-        return execute("RPOP", {key});
+        return executeCommand<protocol::Command<"RPOP", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::llen(const std::string& key) {
-        return execute("LLEN", {key});
+        return executeCommand<protocol::Command<"LLEN", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::lrange(const std::string& key, int64_t start, int64_t stop) {
-        return execute("LRANGE", {key, std::to_string(start), std::to_string(stop)});
+        return executeCommand<protocol::Command<"LRANGE", 3>>(key, start, stop);
     }
 
     RedisClientAwaitable& RedisClient::sadd(const std::string& key, const std::string& member) {
-        return execute("SADD", {key, member});
+        return executeCommand<protocol::Command<"SADD", 2>>(key, member);
     }
 
     RedisClientAwaitable& RedisClient::srem(const std::string& key, const std::string& member) {
-        return execute("SREM", {key, member});
+        return executeCommand<protocol::Command<"SREM", 2>>(key, member);
     }
 
     RedisClientAwaitable& RedisClient::smembers(const std::string& key) {
-        return execute("SMEMBERS", {key});
+        return executeCommand<protocol::Command<"SMEMBERS", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::scard(const std::string& key) {
-        return execute("SCARD", {key});
+        return executeCommand<protocol::Command<"SCARD", 1>>(key);
     }
 
     RedisClientAwaitable& RedisClient::zadd(const std::string& key, double score, const std::string& member) {
-        return execute("ZADD", {key, std::to_string(score), member});
+        return executeCommand<protocol::Command<"ZADD", 3>>(key, score, member);
     }
 
     RedisClientAwaitable& RedisClient::zrem(const std::string& key, const std::string& member) {
-        return execute("ZREM", {key, member});
+        return executeCommand<protocol::Command<"ZREM", 2>>(key, member);
     }
 
     RedisClientAwaitable& RedisClient::zrange(const std::string& key, int64_t start, int64_t stop) {
-        return execute("ZRANGE", {key, std::to_string(start), std::to_string(stop)});
+        return executeCommand<protocol::Command<"ZRANGE", 3>>(key, start, stop);
     }
 
     RedisClientAwaitable& RedisClient::zscore(const std::string& key, const std::string& member) {
-        return execute("ZSCORE", {key, member});
+        return executeCommand<protocol::Command<"ZSCORE", 2>>(key, member);
     }
 
     RedisPipelineAwaitable& RedisClient::pipeline(const std::vector<std::vector<std::string>>& commands) {
@@ -862,6 +2057,32 @@ namespace galay::redis
         return *m_pipeline_awaitable;
     }
 
+    RedisPipelineStreamAwaitable& RedisClient::pipelineStream(RedisCommandSource source, RedisReplyHandler handler) {
+        if (!m_pipeline_stream_awaitable.has_value() || m_pipeline_stream_awaitable->isInvalid()) {
+            m_pipeline_stream_awaitable.emplace(*this, std::move(source), std::move(handler),
+                                                m_config.pipeline_window,
+                                                m_config.adaptive_window ? &m_adaptive_window : nullptr);
+        }
+        return *m_pipeline_stream_awaitable;
+    }
+
+    RedisPipelineStreamAwaitable& RedisClient::pipelineStream(const std::vector<std::vector<std::string>>& commands,
+                                                              RedisReplyHandler handler) {
+        if (!m_pipeline_stream_awaitable.has_value() || m_pipeline_stream_awaitable->isInvalid()) {
+            auto source = [&commands, next = size_t(0)](std::vector<std::string>& command) mutable {
+                if (next == commands.size()) {
+                    return false;
+                }
+                command = commands[next++];
+                return true;
+            };
+            m_pipeline_stream_awaitable.emplace(*this, std::move(source), std::move(handler),
+                                                m_config.pipeline_window,
+                                                m_config.adaptive_window ? &m_adaptive_window : nullptr);
+        }
+        return *m_pipeline_stream_awaitable;
+    }
+
     // ======================== 连接方法 ========================
 
     RedisConnectAwaitable& RedisClient::connect(const std::string& url)
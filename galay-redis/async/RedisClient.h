@@ -8,17 +8,32 @@
 #include <galay-kernel/common/Host.hpp>
 #include <galay-kernel/common/Buffer.h>
 #include <galay-kernel/common/Error.h>
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <expected>
 #include <optional>
+#include <utility>
 #include <vector>
 #include <coroutine>
+#include <functional>
+#include <deque>
+#include <chrono>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include "galay-redis/base/RedisError.h"
 #include "galay-redis/base/RedisValue.h"
+#include "galay-redis/base/RedisValueList.h"
+#include "galay-redis/base/RedisBuffer.h"
+#include "galay-redis/base/RedisAdaptiveWindow.h"
 #include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RespCommand.h"
+#include "galay-redis/protocol/RespVectored.h"
+#include "galay-redis/protocol/RedisReplyView.h"
+#include "galay-redis/protocol/RespVisitor.h"
+#include "galay-redis/protocol/RespStream.h"
+#include "galay-redis/protocol/RespDecode.h"
 #include "AsyncRedisConfig.h"
 
 namespace galay::redis
@@ -29,9 +44,10 @@ namespace galay::redis
     using galay::kernel::Host;
     using galay::kernel::IOError;
     using galay::kernel::IPType;
-    using galay::kernel::RingBuffer;
     using galay::kernel::SendAwaitable;
-    using galay::kernel::ReadvAwaitable;
+    using galay::kernel::WritevAwaitable;
+    using galay::kernel::SendFileAwaitable;
+    using galay::kernel::RecvAwaitable;
     using galay::kernel::ConnectAwaitable;
 
     // 类型别名
@@ -41,20 +57,158 @@ namespace galay::redis
     // 前向声明
     class RedisClient;
 
+    /**
+     * @brief 文件中的一段数据，作为命令的最后一个参数通过 sendfile 发送
+     * @note fd 由调用方持有，在等待体完成前不能关闭；[offset, offset + length) 必须在文件范围内
+     */
+    struct RedisFileRegion
+    {
+        int fd = -1;
+        off_t offset = 0;
+        size_t length = 0;
+    };
+
+    /**
+     * @brief RedisClient 等待体的超时设置
+     * @details timeout() 限定整次 co_await 的时长，从发起第一次 IO 开始计时。
+     *          每次 send/recv/connect 都以剩余时间调用内核等待体自身的 timeout()，到期时由内核取消这次 IO，
+     *          等待体以 REDIS_ERROR_TYPE_TIMEOUT_ERROR 结束。返回时内核已不再引用客户端的缓冲区，
+     *          客户端可以继续发送命令（超时命令迟到的回复会被丢弃），也可以直接析构
+     */
+    template<typename Derived>
+    class RedisTimeoutSupport
+    {
+    public:
+        template<typename Rep, typename Period>
+        Derived& timeout(std::chrono::duration<Rep, Period> duration)
+        {
+            m_timeout = std::max(std::chrono::ceil<std::chrono::milliseconds>(duration),
+                                 std::chrono::milliseconds(1));
+            return static_cast<Derived&>(*this);
+        }
+
+    protected:
+        // 开始一次操作，按 timeout() 的设置确定截止时间
+        void startDeadline() noexcept
+        {
+            m_deadline = std::chrono::steady_clock::now() + m_timeout;
+        }
+
+        // 下一次 IO 的时限，0 表示不限时；截止时间已过时给 1ms，让 IO 尽快以超时结束
+        std::chrono::milliseconds remainingTime() const noexcept
+        {
+            if (m_timeout.count() == 0) {
+                return m_timeout;
+            }
+            auto left = std::chrono::ceil<std::chrono::milliseconds>(m_deadline - std::chrono::steady_clock::now());
+            return std::max(left, std::chrono::milliseconds(1));
+        }
+
+        // 操作结束，下一次操作需要重新设置
+        void clearTimeout() noexcept { m_timeout = std::chrono::milliseconds(0); }
+
+    private:
+        std::chrono::milliseconds m_timeout{0};
+        std::chrono::steady_clock::time_point m_deadline;
+    };
+
+    /**
+     * @brief 一次内核 IO（send/recv/writev/sendfile/connect）
+     * @details 有时限时通过内核等待体自身的 timeout() 挂起，到期后 IO 被内核取消并以 kTimeout 结束
+     */
+    template<typename IO>
+    class RedisTimedIO
+    {
+        using Timed = decltype(std::declval<IO&>().timeout(std::chrono::milliseconds(1)));
+
+    public:
+        using Result = decltype(std::declval<IO&>().await_resume());
+
+        void emplace(IO&& io)
+        {
+            reset();
+            m_io.emplace(std::move(io));
+        }
+
+        bool suspend(std::coroutine_handle<> handle, std::chrono::milliseconds timeout)
+        {
+            if (timeout.count() > 0) {
+                return m_timed.emplace(m_io->timeout(timeout)).await_suspend(handle);
+            }
+            return m_io->await_suspend(handle);
+        }
+
+        Result resume() { return m_timed ? m_timed->await_resume() : m_io->await_resume(); }
+
+        bool has_value() const noexcept { return m_io.has_value(); }
+
+        void reset() noexcept
+        {
+            m_timed.reset();
+            m_io.reset();
+        }
+
+    private:
+        std::optional<IO> m_io;
+        std::optional<Timed> m_timed;   // 引用 m_io，先于它析构
+    };
+
+    /**
+     * @brief 由 RedisClient 的驱动协程推进的等待体
+     * @details 一次 co_await 完成整个发送/接收流程：每一步 IO 由驱动协程发起并等待，
+     *          部分发送、回复不完整时在驱动协程内继续，调用方只在得到最终结果时恢复一次。
+     *          派生类实现两步：suspendStep 以驱动协程的句柄发起下一次 IO（返回 false 表示 IO 已同步完成），
+     *          resumeStep 处理该 IO 的结果（返回 true 表示已得到最终结果）。
+     *          超时作用在每次 IO 上，调用方总是在 IO 结束之后才恢复
+     */
+    class RedisDrivenStep
+    {
+    public:
+        virtual bool suspendStep(std::coroutine_handle<> driver) = 0;
+        virtual bool resumeStep() = 0;
+
+    protected:
+        ~RedisDrivenStep() = default;
+
+        // 连接已关闭，本次 co_await 没有交给驱动协程（取出后清零）
+        bool takeRejected() noexcept { return std::exchange(m_rejected, false); }
+
+    private:
+        friend class RedisClient;
+
+        std::coroutine_handle<> m_waiter;   // 已挂起的调用方
+        bool m_done = false;                // 驱动协程已得到最终结果
+        bool m_rejected = false;            // 连接已关闭，直接以 CONNECTION_CLOSED 结束
+    };
+
+    /**
+     * @brief 驱动协程统计
+     */
+    struct RedisDriverStats
+    {
+        uint64_t operations = 0;    // 完成的命令（调用方各恢复一次）
+        uint64_t io_steps = 0;      // 发起的 IO 次数，即旧接口下调用方需要的 co_await 次数
+        uint64_t io_wakeups = 0;    // 驱动协程因 IO 完成被调度器恢复的次数（其余 IO 同步完成）
+    };
+
     /**
      * @brief Redis客户端等待体
-     * @details 自动处理完整的命令发送和响应接收流程
-     *          返回 std::expected<std::optional<std::vector<RedisValue>>, RedisError>
-     *          - std::vector<RedisValue>: 命令和响应全部完成
-     *          - std::nullopt: 需要继续调用（数据未完全发送或接收）
+     * @details 自动处理完整的命令发送和响应接收流程，一次 co_await 只恢复一次
+     *          返回 std::expected<std::optional<RedisValueList>, RedisError>
+     *          - RedisValueList: 命令和响应全部完成；接口与 std::vector<RedisValue> 一致，单个回复不申请堆内存，
+     *            但字符串回复超出 std::string 的短字符串长度时值本身仍会分配，需要零分配时用 getView
      *          - RedisError: 发生错误
+     *          不再返回 std::nullopt，已有的循环写法照常工作
+     * @note 结果类型曾是 std::optional<std::vector<RedisValue>>，改为 RedisValueList 是源码级不兼容变更：
+     *       显式写出 std::vector<RedisValue> 或按值拷贝结果的代码需要改为 RedisValueList、引用或 std::move 转换
      *
-     * @note 支持超时设置：
+     * @note 支持超时设置，超时后同一个客户端可以继续使用：
      * @code
      * auto result = co_await client.get("key").timeout(std::chrono::seconds(5));
      * @endcode
      */
-    class RedisClientAwaitable : public galay::kernel::TimeoutSupport<RedisClientAwaitable>
+    class RedisClientAwaitable : public RedisTimeoutSupport<RedisClientAwaitable>,
+                                 public RedisDrivenStep
     {
     public:
         /**
@@ -69,13 +223,38 @@ namespace galay::redis
                             std::vector<std::string> args,
                             size_t expected_replies = 1);
 
+        /**
+         * @brief 构造函数（已编码的命令）
+         * @param encoded_cmd 完整的RESP命令字节，如 protocol::Command 预编码的结果
+         */
+        RedisClientAwaitable(RedisClient& client,
+                            std::string encoded_cmd,
+                            size_t expected_replies);
+
+        /**
+         * @brief 构造函数（分散写命令）
+         * @details 大参数以 iovec 原地引用，通过 writev 发送；调用方保证其在等待体完成前有效
+         */
+        RedisClientAwaitable(RedisClient& client,
+                            protocol::RespVectoredCommand command,
+                            size_t expected_replies);
+
+        /**
+         * @brief 构造函数（文件参数）
+         * @param encoded_header 命令头，以最后一个参数的 "$<length>\r\n" 结尾
+         * @details 命令头用 send 发送，文件内容用 sendfile 由内核直接发送，最后补上 "\r\n"
+         */
+        RedisClientAwaitable(RedisClient& client,
+                            std::string encoded_header,
+                            RedisFileRegion file);
+
         bool await_ready() const noexcept {
             return false;
         }
 
         bool await_suspend(std::coroutine_handle<> handle);
 
-        std::expected<std::optional<std::vector<RedisValue>>, RedisError> await_resume();
+        std::expected<std::optional<RedisValueList>, RedisError> await_resume();
 
         /**
          * @brief 检查状态是否为 Invalid
@@ -92,48 +271,72 @@ namespace galay::redis
         void reset() noexcept {
             m_state = State::Invalid;
             m_send_awaitable.reset();
+            m_writev_awaitable.reset();
+            m_sendfile_awaitable.reset();
             m_recv_awaitable.reset();
             m_values.clear();
             m_sent = 0;
-            m_result = std::nullopt;  // 重置为 nullopt
+            clearTimeout();
+            resetParser();
         }
 
     private:
+        friend class RedisClient;
+
+        // RedisDrivenStep：由驱动协程调用
+        bool suspendStep(std::coroutine_handle<> driver) override;
+        bool resumeStep() override;
+
+        // 丢弃解析器中未完成的帧（RedisClient 在此处尚不完整，实现放在 .cc 中）
+        void resetParser() noexcept;
+
+        // 处理一次 IO 的结果，std::nullopt 表示需要继续
+        std::expected<std::optional<RedisValueList>, RedisError> onIOComplete();
+
         enum class State {
             Invalid,           // 无效状态，可以重新创建
             Sending,           // 正在发送命令
             Receiving          // 正在接收响应
         };
 
+        // 发送下一段尚未发送的数据
+        bool suspendSend(std::coroutine_handle<> handle);
+        std::expected<size_t, IOError> resumeSend();
+        size_t commandSize() const;
+
+        // IO 超时：记下迟到的回复，未发完的命令使连接不可再用
+        RedisError onTimeout(const IOError& error);
+
         RedisClient& m_client;
-        std::string m_cmd;
-        std::vector<std::string> m_args;
         std::string m_encoded_cmd;
+        protocol::RespVectoredCommand m_vectored_cmd;   // 非空时走 writev
+        std::optional<RedisFileRegion> m_file;          // 有值时 m_encoded_cmd 只是命令头
         size_t m_expected_replies;
-        std::vector<RedisValue> m_values;
+        RedisValueList m_values;
         State m_state;
         size_t m_sent;
 
         // 持有底层的 awaitable 对象
-        std::optional<SendAwaitable> m_send_awaitable;
-        std::optional<ReadvAwaitable> m_recv_awaitable;
+        RedisTimedIO<SendAwaitable> m_send_awaitable;
+        RedisTimedIO<WritevAwaitable> m_writev_awaitable;
+        RedisTimedIO<SendFileAwaitable> m_sendfile_awaitable;
+        RedisTimedIO<RecvAwaitable> m_recv_awaitable;
 
-    public:
-        // TimeoutSupport 需要访问此成员来设置超时错误
-        // 注意：这里使用 IOError 类型，因为 TimeoutSupport 会设置 IOError
-        std::expected<std::optional<std::vector<RedisValue>>, galay::kernel::IOError> m_result;
+        // 驱动协程得到的最终结果，由 await_resume 取走
+        std::optional<std::expected<std::optional<RedisValueList>, RedisError>> m_final;
     };
 
     /**
      * @brief Redis Pipeline等待体
-     * @details 处理批量命令的发送和接收
+     * @details 处理批量命令的发送和接收，一次 co_await 只在全部回复到齐（或出错）时恢复
      *
-     * @note 支持超时设置：
+     * @note 支持超时设置，超时后同一个客户端可以继续使用：
      * @code
      * auto result = co_await client.pipeline(commands).timeout(std::chrono::seconds(10));
      * @endcode
      */
-    class RedisPipelineAwaitable : public galay::kernel::TimeoutSupport<RedisPipelineAwaitable>
+    class RedisPipelineAwaitable : public RedisTimeoutSupport<RedisPipelineAwaitable>,
+                                   public RedisDrivenStep
     {
     public:
         RedisPipelineAwaitable(RedisClient& client,
@@ -161,10 +364,22 @@ namespace galay::redis
             m_recv_awaitable.reset();
             m_values.clear();
             m_sent = 0;
-            m_result = std::nullopt;
+            clearTimeout();
+            resetParser();
         }
 
     private:
+        // RedisDrivenStep：由驱动协程调用
+        bool suspendStep(std::coroutine_handle<> driver) override;
+        bool resumeStep() override;
+
+        void resetParser() noexcept;
+
+        std::expected<std::optional<std::vector<RedisValue>>, RedisError> onIOComplete();
+
+        // IO 超时：记下迟到的回复，未发完的命令使连接不可再用
+        RedisError onTimeout(const IOError& error);
+
         enum class State {
             Invalid,
             Sending,
@@ -178,19 +393,472 @@ namespace galay::redis
         State m_state;
         size_t m_sent;
 
-        std::optional<SendAwaitable> m_send_awaitable;
-        std::optional<ReadvAwaitable> m_recv_awaitable;
+        RedisTimedIO<SendAwaitable> m_send_awaitable;
+        RedisTimedIO<RecvAwaitable> m_recv_awaitable;
 
+        std::optional<std::expected<std::optional<std::vector<RedisValue>>, RedisError>> m_final;
+    };
+
+    /**
+     * @brief 流式 pipeline 的命令来源
+     * @details 每次调用把下一条命令（命令名和参数）写入 command（已清空，可复用容量），
+     *          没有更多命令时返回 false
+     */
+    using RedisCommandSource = std::function<bool(std::vector<std::string>& command)>;
+
+    /**
+     * @brief 流式 pipeline 的回复处理者
+     * @details 按命令顺序收到第 index 条回复（错误回复以 isError() 的 RedisValue 给出），
+     *          返回 false 表示停止：不再发送新命令，已发出命令的回复读取后丢弃
+     */
+    using RedisReplyHandler = std::function<bool(size_t index, RedisValue value)>;
+
+    /**
+     * @brief 流式 pipeline 的完成统计
+     */
+    struct RedisPipelineStreamSummary
+    {
+        size_t commands = 0;        // 收到回复的命令数
+        size_t error_replies = 0;   // 其中错误回复的个数
+        size_t max_in_flight = 0;   // 同时在途命令数的峰值
+    };
+
+    /**
+     * @brief 流式 Pipeline 等待体
+     * @details 命令按需从 source 取出，在途命令数不超过窗口（AsyncRedisConfig::pipeline_window）；
+     *          回复解析出一条就交给 handler 一条，在途数降到窗口一半时补发下一批。
+     *          内存占用只取决于窗口大小，与命令总数无关。
+     *          开启 AsyncRedisConfig::adaptive_window 时窗口由 RedisClient 的 RedisAdaptiveWindow 给出，
+     *          每条回复的延迟（所在批次发完到收到回复）用于调节窗口，调节结果在多次调用间保留。
+     *          与 RedisClientAwaitable 一样由驱动协程推进，一次 co_await 得到最终结果。
+     *          返回 std::expected<std::optional<RedisPipelineStreamSummary>, RedisError>，
+     *          不再返回 std::nullopt，已有的循环写法照常工作；handler 中途停止时返回 INVALID_ERROR
+     *
+     * @code
+     * size_t i = 0;
+     * auto source = [&](std::vector<std::string>& cmd) {
+     *     if (i == total) return false;
+     *     cmd = {"SET", "key" + std::to_string(i), "value"};
+     *     ++i;
+     *     return true;
+     * };
+     * auto handler = [&](size_t, RedisValue value) { return !value.isError(); };
+     * auto result = co_await client.pipelineStream(source, handler);
+     * @endcode
+     */
+    class RedisPipelineStreamAwaitable : public RedisTimeoutSupport<RedisPipelineStreamAwaitable>,
+                                         public RedisDrivenStep
+    {
     public:
-        // TimeoutSupport 需要访问此成员来设置超时错误
-        std::expected<std::optional<std::vector<RedisValue>>, galay::kernel::IOError> m_result;
+        RedisPipelineStreamAwaitable(RedisClient& client,
+                                     RedisCommandSource source,
+                                     RedisReplyHandler handler,
+                                     size_t window,
+                                     RedisAdaptiveWindow* adaptive = nullptr);
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        std::expected<std::optional<RedisPipelineStreamSummary>, RedisError> await_resume();
+
+        bool isInvalid() const noexcept {
+            return m_state == State::Invalid;
+        }
+
+        /**
+         * @brief 重置状态并清理资源
+         */
+        void reset() noexcept {
+            m_state = State::Invalid;
+            m_send_awaitable.reset();
+            m_recv_awaitable.reset();
+            m_encoded.clear();
+            m_sent = 0;
+            m_in_flight = 0;
+            m_batch_commands = 0;
+            m_batches.clear();
+            m_source_done = false;
+            m_stopped = false;
+            m_summary = {};
+            clearTimeout();
+            resetParser();
+        }
+
+    private:
+        // RedisDrivenStep：由驱动协程调用
+        bool suspendStep(std::coroutine_handle<> driver) override;
+        bool resumeStep() override;
+
+        void resetParser() noexcept;
+
+        // 处理一次 IO 的结果，std::nullopt 表示需要继续
+        std::expected<std::optional<RedisPipelineStreamSummary>, RedisError> onIOComplete();
+
+        // 所有回复已处理，结束本次调用
+        std::expected<std::optional<RedisPipelineStreamSummary>, RedisError> finish();
+
+        // IO 超时：记下迟到的回复，未发完的批次使连接不可再用
+        RedisError onTimeout(const IOError& error);
+
+        // 从 source 取命令编码进 m_encoded，直到在途数达到窗口或 source 耗尽
+        void refill();
+
+        // 固定窗口，或自适应窗口的当前值
+        size_t window() const noexcept {
+            return m_adaptive ? m_adaptive->window() : m_window;
+        }
+
+        enum class State {
+            Invalid,
+            Sending,
+            Receiving
+        };
+
+        RedisClient& m_client;
+        RedisCommandSource m_source;
+        RedisReplyHandler m_handler;
+        size_t m_window;
+        RedisAdaptiveWindow* m_adaptive;        // 为空时使用固定窗口
+        std::vector<std::string> m_command;     // 复用的单条命令
+        std::string m_encoded;                  // 当前批次
+        State m_state;
+        size_t m_sent;
+        size_t m_in_flight = 0;
+        size_t m_batch_commands = 0;            // m_encoded 中的命令数
+        // 自适应窗口：已发完批次的发送完成时刻和尚未收到的回复数
+        std::deque<std::pair<std::chrono::steady_clock::time_point, size_t>> m_batches;
+        bool m_source_done = false;
+        bool m_stopped = false;
+        RedisPipelineStreamSummary m_summary;
+
+        RedisTimedIO<SendAwaitable> m_send_awaitable;
+        RedisTimedIO<RecvAwaitable> m_recv_awaitable;
+
+        std::optional<std::expected<std::optional<RedisPipelineStreamSummary>, RedisError>> m_final;
+    };
+
+    /**
+     * @brief 借用式回复
+     * @details 持有一个指向 RedisClient 接收缓冲区的 RedisReplyView，字符串不做任何拷贝。
+     *          在 release() 或析构之前，帧数据一直保留在接收缓冲区中；
+     *          同一个客户端发起下一条命令时会自动释放，此后视图失效。
+     *
+     * @code
+     * auto result = co_await client.getView("key");
+     * if (result && result->has_value()) {
+     *     std::string_view value = (*result)->view().asString();
+     * }
+     * @endcode
+     */
+    class RedisBorrowedReply
+    {
+    public:
+        RedisBorrowedReply() = default;
+        RedisBorrowedReply(RedisBorrowedReply&& other) noexcept;
+        RedisBorrowedReply& operator=(RedisBorrowedReply&& other) noexcept;
+        RedisBorrowedReply(const RedisBorrowedReply&) = delete;
+        RedisBorrowedReply& operator=(const RedisBorrowedReply&) = delete;
+        ~RedisBorrowedReply() { release(); }
+
+        const protocol::RedisReplyView& view() const { return m_view; }
+        const protocol::RedisReplyView* operator->() const { return &m_view; }
+
+        /**
+         * @brief 是否仍然有效（未释放且未被下一条命令顶替）
+         */
+        bool valid() const;
+
+        /**
+         * @brief 归还接收缓冲区中的帧数据，之后视图失效
+         */
+        void release() noexcept;
+
+    private:
+        friend class RedisViewAwaitable;
+
+        RedisBorrowedReply(RedisClient* client, protocol::RedisReplyView view, uint64_t generation)
+            : m_client(client), m_view(view), m_generation(generation) {}
+
+        RedisClient* m_client = nullptr;
+        protocol::RedisReplyView m_view;
+        uint64_t m_generation = 0;
+    };
+
+    /**
+     * @brief 借用式回复等待体
+     * @details 与 RedisClientAwaitable 流程相同，但响应由 RespViewParser 解析为节点数组，
+     *          不构造 RedisReply / RedisValue，结果以 RedisBorrowedReply 交付。
+     *          返回 std::expected<std::optional<RedisBorrowedReply>, RedisError>，
+     *          std::nullopt 表示需要继续调用。
+     * @note 整帧保留在接收缓冲区中，超过 AsyncRedisConfig::buffer_size 的帧会使缓冲区临时扩容
+     */
+    class RedisViewAwaitable : public RedisTimeoutSupport<RedisViewAwaitable>
+    {
+    public:
+        RedisViewAwaitable(RedisClient& client,
+                          std::string cmd,
+                          std::vector<std::string> args);
+
+        // 已编码的命令，由 RedisClient 复用上一条命令的缓冲区编码
+        RedisViewAwaitable(RedisClient& client, std::string encoded);
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        std::expected<std::optional<RedisBorrowedReply>, RedisError> await_resume();
+
+        bool isInvalid() const noexcept {
+            return m_state == State::Invalid;
+        }
+
+        /**
+         * @brief 重置状态并清理资源
+         */
+        void reset() noexcept {
+            m_state = State::Invalid;
+            m_send_awaitable.reset();
+            m_recv_awaitable.reset();
+            m_sent = 0;
+            clearTimeout();
+            resetParser();
+        }
+
+    private:
+        friend class RedisClient;
+
+        void resetParser() noexcept;
+
+        enum class State {
+            Invalid,
+            Sending,
+            Receiving
+        };
+
+        RedisClient& m_client;
+        std::string m_encoded_cmd;
+        State m_state;
+        bool m_rejected = false;    // 连接已关闭，本次 co_await 没有发起 IO
+        size_t m_sent;
+
+        RedisTimedIO<SendAwaitable> m_send_awaitable;
+        RedisTimedIO<RecvAwaitable> m_recv_awaitable;
+    };
+
+    /**
+     * @brief 类型化等待体
+     * @details 复用 RedisViewAwaitable 的收发流程，整帧解析为节点数组后由 protocol::decode<T>
+     *          一次性构造目标类型，不经过 RedisReply / RedisValue。
+     *          返回 std::expected<std::optional<T>, RedisError>，std::nullopt 表示需要继续调用；
+     *          Redis错误回复返回 REDIS_ERROR_TYPE_COMMAND_ERROR，类型不匹配返回 REDIS_ERROR_TYPE_PARSE_ERROR。
+     *
+     * @code
+     * auto result = co_await client.typed<std::vector<std::string>>("LRANGE", {"list", "0", "-1"});
+     * @endcode
+     */
+    template<typename T>
+    class RedisTypedAwaitable
+    {
+    public:
+        explicit RedisTypedAwaitable(RedisViewAwaitable& inner)
+            : m_inner(&inner) {}
+
+        // 超时设置在内部等待体上
+        template<typename Rep, typename Period>
+        RedisTypedAwaitable& timeout(std::chrono::duration<Rep, Period> duration) {
+            m_inner->timeout(duration);
+            return *this;
+        }
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            return m_inner->await_suspend(handle);
+        }
+
+        std::expected<std::optional<T>, RedisError> await_resume()
+        {
+            auto result = m_inner->await_resume();
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+            if (!result->has_value()) {
+                return std::nullopt;
+            }
+
+            // 借用的帧在本作用域结束时归还
+            RedisBorrowedReply reply = std::move(**result);
+            if (reply->isError()) {
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_COMMAND_ERROR,
+                                                 std::string(reply->asString())));
+            }
+            auto value = protocol::decode<T>(reply.view());
+            if (!value) {
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                                                 protocol::decodeErrorString(value.error())));
+            }
+            return std::optional<T>(std::move(*value));
+        }
+
+        bool isInvalid() const noexcept {
+            return m_inner->isInvalid();
+        }
+
+    private:
+        RedisViewAwaitable* m_inner;
+    };
+
+    /**
+     * @brief 访问者等待体
+     * @details 发送命令后由 RespVisitParser 直接在接收缓冲区上回调访问者，不构造 RedisReply / RedisValue。
+     *          已回调的字节立即从接收缓冲区释放，缓冲区只需容纳单个元素，
+     *          即使是多MB的回复也保持在 AsyncRedisConfig::buffer_size 附近。
+     *          返回 std::expected<std::optional<size_t>, RedisError>，size_t 为整个回复的字节数，
+     *          std::nullopt 表示需要继续调用。
+     *
+     * @code
+     * struct ScoreSum : protocol::RespVisitor {
+     *     double sum = 0;
+     *     size_t index = 0;
+     *     void onBulk(std::string_view v) override {
+     *         if (index++ % 2 == 1) sum += std::strtod(v.data(), nullptr);
+     *     }
+     * } visitor;
+     * auto result = co_await client.executeVisit("ZRANGE", {"board", "0", "-1", "WITHSCORES"}, visitor);
+     * @endcode
+     * @note 访问者必须存活到等待体完成；Redis错误回复通过 onError 交付，不会转换为 RedisError
+     */
+    class RedisVisitAwaitable : public RedisTimeoutSupport<RedisVisitAwaitable>
+    {
+    public:
+        RedisVisitAwaitable(RedisClient& client,
+                           std::string cmd,
+                           std::vector<std::string> args,
+                           protocol::RespVisitor& visitor);
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        std::expected<std::optional<size_t>, RedisError> await_resume();
+
+        bool isInvalid() const noexcept {
+            return m_state == State::Invalid;
+        }
+
+        /**
+         * @brief 重置状态并清理资源
+         */
+        void reset() noexcept {
+            m_state = State::Invalid;
+            m_send_awaitable.reset();
+            m_recv_awaitable.reset();
+            m_sent = 0;
+            m_visited = 0;
+            clearTimeout();
+            resetParser();
+        }
+
+    private:
+        void resetParser() noexcept;
+
+        enum class State {
+            Invalid,
+            Sending,
+            Receiving
+        };
+
+        RedisClient& m_client;
+        protocol::RespVisitor* m_visitor;
+        std::string m_encoded_cmd;
+        State m_state;
+        bool m_rejected = false;    // 连接已关闭，本次 co_await 没有发起 IO
+        size_t m_sent;
+        size_t m_visited;       // 已回调并释放的字节数
+
+        RedisTimedIO<SendAwaitable> m_send_awaitable;
+        RedisTimedIO<RecvAwaitable> m_recv_awaitable;
+    };
+
+    /**
+     * @brief 流式读取等待体
+     * @details 发送 GET 类命令后由 RespBulkStreamParser 把 bulk 内容分片交给 sink，交付后立即从接收缓冲区释放，
+     *          内存占用保持在 AsyncRedisConfig::buffer_size 附近，与值的大小无关。
+     *          返回 std::expected<std::optional<protocol::RespBulkStreamResult>, RedisError>，
+     *          std::nullopt 表示需要继续调用；Redis错误回复返回 REDIS_ERROR_TYPE_COMMAND_ERROR，
+     *          sink 中途返回 false 时读完剩余内容后返回 REDIS_ERROR_TYPE_INVALID_ERROR。
+     */
+    class RedisStreamAwaitable : public RedisTimeoutSupport<RedisStreamAwaitable>
+    {
+    public:
+        RedisStreamAwaitable(RedisClient& client,
+                            std::string encoded_cmd,
+                            protocol::RespBulkSink sink);
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        std::expected<std::optional<protocol::RespBulkStreamResult>, RedisError> await_resume();
+
+        bool isInvalid() const noexcept {
+            return m_state == State::Invalid;
+        }
+
+        /**
+         * @brief 重置状态并清理资源
+         */
+        void reset() noexcept {
+            m_state = State::Invalid;
+            m_send_awaitable.reset();
+            m_recv_awaitable.reset();
+            m_sent = 0;
+            clearTimeout();
+            resetParser();
+        }
+
+    private:
+        void resetParser() noexcept;
+
+        enum class State {
+            Invalid,
+            Sending,
+            Receiving
+        };
+
+        RedisClient& m_client;
+        protocol::RespBulkSink m_sink;
+        std::string m_encoded_cmd;
+        State m_state;
+        bool m_rejected = false;    // 连接已关闭，本次 co_await 没有发起 IO
+        size_t m_sent;
+
+        RedisTimedIO<SendAwaitable> m_send_awaitable;
+        RedisTimedIO<RecvAwaitable> m_recv_awaitable;
     };
 
     /**
      * @brief Redis连接等待体
-     * @details 处理连接、认证、选择数据库的完整流程
+     * @details 处理连接、认证、选择数据库的完整流程，一次 co_await 全部完成
+     *
+     * @note 支持超时设置，超时后握手停在中途，客户端标记为关闭，需要新建客户端重新连接：
+     * @code
+     * auto result = co_await client.connect("127.0.0.1", 6379).timeout(std::chrono::seconds(3));
+     * @endcode
      */
-    class RedisConnectAwaitable
+    class RedisConnectAwaitable : public RedisTimeoutSupport<RedisConnectAwaitable>,
+                                  public RedisDrivenStep
     {
     public:
         RedisConnectAwaitable(RedisClient& client,
@@ -214,14 +882,26 @@ namespace galay::redis
         }
 
     private:
+        // RedisDrivenStep：由驱动协程调用
+        bool suspendStep(std::coroutine_handle<> driver) override;
+        bool resumeStep() override;
+
         enum class State {
             Invalid,
             Connecting,
             Authenticating,
-            SelectingDB,
-            Done
+            SelectingDB
         };
 
+        // 处理认证 / SELECT 命令的一次 IO 结果，std::nullopt 表示需要继续
+        std::optional<RedisVoidResult> onCommandIO();
+
+        // 连接或认证完成后进入下一阶段，没有下一阶段时返回 false
+        bool nextStage();
+
+        // 记录最终结果并回到 Invalid 状态
+        bool finish(RedisVoidResult result);
+
         RedisClient& m_client;
         std::string m_ip;
         int32_t m_port;
@@ -231,17 +911,20 @@ namespace galay::redis
         int m_version;
         State m_state;
 
-        std::optional<galay::kernel::ConnectAwaitable> m_connect_awaitable;
-        std::optional<SendAwaitable> m_send_awaitable;
-        std::optional<ReadvAwaitable> m_recv_awaitable;
-        std::vector<RedisValue> m_temp_values;
+        RedisTimedIO<ConnectAwaitable> m_connect_awaitable;
+        RedisTimedIO<SendAwaitable> m_send_awaitable;
+        RedisTimedIO<RecvAwaitable> m_recv_awaitable;
         std::string m_encoded_cmd;
         size_t m_sent;
+        bool m_receiving = false;           // 认证 / SELECT 命令已发完，正在接收回复
+        std::optional<RedisVoidResult> m_final;
     };
 
     /**
      * @brief Redis客户端类
      * @details 提供异步Redis客户端功能，采用Awaitable模式
+     * @note 命令超时后客户端仍可使用：超时命令迟到的回复在下一条命令读取时按个数丢弃，不会与之错位；
+     *       只有命令没发完就超时（服务端收到半条命令）时连接才标记为关闭
      */
     class RedisClient
     {
@@ -304,6 +987,80 @@ namespace galay::redis
         RedisClientAwaitable& incr(const std::string& key);
         RedisClientAwaitable& decr(const std::string& key);
 
+        /**
+         * @brief SET 的分散写版本，value 不拷贝进命令缓冲区，以 iovec 原地引用后 writev 发送
+         * @details 不小于 AsyncRedisConfig::writev_threshold 的参数才会原地引用
+         * @warning key 和 value 必须在等待体完成（返回值或错误）之前保持有效且不被修改
+         */
+        RedisClientAwaitable& setVectored(std::string_view key, std::string_view value);
+
+        /**
+         * @brief 任意命令的分散写版本
+         * @warning args 引用的数据必须在等待体完成之前保持有效且不被修改
+         */
+        RedisClientAwaitable& executeVectored(std::string_view cmd, const std::vector<std::string_view>& args);
+
+        /**
+         * @brief SET 的文件版本，value 为文件 fd 中 [offset, offset + length) 的内容
+         * @details 命令头走 send，文件内容走 sendfile，不经过用户态缓冲区
+         * @warning fd 在等待体完成前不能关闭，文件内容在此期间不应被截断
+         */
+        RedisClientAwaitable& setFromFile(const std::string& key, int fd, off_t offset, size_t length);
+
+        /**
+         * @brief 任意命令的文件版本，file 作为 args 之后的最后一个参数
+         */
+        RedisClientAwaitable& executeFromFile(const std::string& cmd, const std::vector<std::string>& args,
+                                              RedisFileRegion file);
+
+        /**
+         * @brief GET 的借用式版本，值直接指向接收缓冲区，不做拷贝
+         * @details 命令编码到上一条借用式命令复用的缓冲区，预热后不申请堆内存，与值的长度无关
+         * @see RedisBorrowedReply
+         */
+        RedisViewAwaitable& getView(const std::string& key);
+
+        /**
+         * @brief 任意命令的借用式版本
+         */
+        RedisViewAwaitable& executeView(const std::string& cmd, const std::vector<std::string>& args);
+
+        /**
+         * @brief 任意命令的类型化版本，回复直接解码为 T
+         * @details 支持整数、浮点、bool、std::string、std::optional、std::vector、std::map、
+         *          std::unordered_map、std::pair、std::tuple 以及声明了 resp_fields 的结构体
+         * @see RedisTypedAwaitable, protocol::RespDecoder
+         */
+        template<typename T>
+        RedisTypedAwaitable<T> typed(const std::string& cmd, const std::vector<std::string>& args) {
+            return RedisTypedAwaitable<T>(executeView(cmd, args));
+        }
+
+        /**
+         * @brief 任意命令的访问者版本，回复逐元素回调给 visitor，不构造中间对象
+         * @see RedisVisitAwaitable
+         */
+        RedisVisitAwaitable& executeVisit(const std::string& cmd, const std::vector<std::string>& args,
+                                          protocol::RespVisitor& visitor);
+
+        /**
+         * @brief GET 的流式版本，值按到达顺序分片交给 sink，不在内存中拼接整个值
+         * @details 适合几十到几百MB的二进制值（序列化模型、图片等）
+         * @code
+         * auto result = co_await client.getStream("blob", [&](std::string_view chunk) {
+         *     hasher.update(chunk);
+         *     return true;
+         * });
+         * @endcode
+         * @see RedisStreamAwaitable
+         */
+        RedisStreamAwaitable& getStream(const std::string& key, protocol::RespBulkSink sink);
+
+        /**
+         * @brief GET 的流式版本，值直接写入文件描述符
+         */
+        RedisStreamAwaitable& getToFd(const std::string& key, int fd);
+
         // ======================== Hash操作 ========================
 
         RedisClientAwaitable& hget(const std::string& key, const std::string& field);
@@ -338,34 +1095,199 @@ namespace galay::redis
 
         RedisPipelineAwaitable& pipeline(const std::vector<std::vector<std::string>>& commands);
 
+        /**
+         * @brief 流式 Pipeline：命令按需取出，回复按顺序逐条交给 handler，内存占用受窗口限制
+         * @details 适合百万级命令的批量任务
+         * @see RedisPipelineStreamAwaitable
+         */
+        RedisPipelineStreamAwaitable& pipelineStream(RedisCommandSource source, RedisReplyHandler handler);
+
+        /**
+         * @brief 已在内存中的命令的流式版本，回复不再集中保存
+         * @warning commands 必须在等待体完成之前保持有效
+         */
+        RedisPipelineStreamAwaitable& pipelineStream(const std::vector<std::vector<std::string>>& commands,
+                                                     RedisReplyHandler handler);
+
+        /**
+         * @brief pipelineStream 的自适应窗口统计（开启 adaptive_window 时有效）
+         */
+        const RedisAdaptiveWindowStats& adaptiveWindowStats() const { return m_adaptive_window.stats(); }
+
         // ======================== 连接管理 ========================
 
+        /**
+         * @brief 关闭连接，之后的命令直接以 CONNECTION_CLOSED 结束
+         */
         auto close() {
+            m_is_closed.store(true, std::memory_order_release);
             return m_socket.close();
         }
 
-        bool isClosed() const { return m_is_closed; }
+        /**
+         * @brief 连接是否已关闭（close()、握手超时或命令发到一半超时之后）
+         * @details 可在其他线程读取，连接池的定时器据此剔除失效连接
+         */
+        bool isClosed() const { return m_is_closed.load(std::memory_order_acquire); }
+
+        /**
+         * @brief 接收缓冲区统计（当前/峰值容量、扩容与缩容次数）
+         */
+        const RedisBufferStats& bufferStats() const { return m_recv_buffer.stats(); }
+
+        /**
+         * @brief 驱动协程统计（命令数、IO 次数、被调度器恢复的次数）
+         */
+        RedisDriverStats driverStats() const { return m_driver ? m_driver->stats : RedisDriverStats{}; }
 
-        ~RedisClient() = default;
+        ~RedisClient();
 
     private:
         friend class RedisClientAwaitable;
         friend class RedisPipelineAwaitable;
+        friend class RedisPipelineStreamAwaitable;
         friend class RedisConnectAwaitable;
+        friend class RedisViewAwaitable;
+        friend class RedisVisitAwaitable;
+        friend class RedisStreamAwaitable;
+        friend class RedisBorrowedReply;
+        friend class RedisMultiplexer;
+
+        /**
+         * @brief 归还借用中的帧数据（发起新命令前调用）
+         */
+        void releaseBorrowed() noexcept;
+
+        /**
+         * @brief 丢弃之前超时的命令迟到的回复，在解析本命令的回复之前调用
+         * @return true 表示已全部丢弃；false 表示数据不足，需要继续接收
+         */
+        std::expected<bool, protocol::ParseError> skipStaleReplies();
+
+        // 是否还有迟到的回复未丢弃
+        bool hasStaleReplies() const noexcept { return m_stale_replies != 0 || m_stale_stream; }
+
+        // 新连接上没有迟到的回复
+        void clearStaleReplies() noexcept;
+
+        /**
+         * @brief 驱动协程与 RedisClient 共享的状态
+         * @details 驱动协程持有 shared_ptr，RedisClient 移动或析构后仍可安全退出
+         */
+        struct DriverState
+        {
+            RedisDrivenStep* step = nullptr;    // 正在驱动的等待体
+            std::coroutine_handle<> idle;       // 空闲中的驱动协程
+            bool stopped = false;               // 驱动协程应退出
+            RedisDriverStats stats;
+        };
+
+        // 驱动协程没有等待体时挂起在这里
+        struct DriverIdle
+        {
+            DriverState& state;
+            bool await_ready() const noexcept { return state.step != nullptr || state.stopped; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept { state.idle = handle; }
+            void await_resume() const noexcept { state.idle = {}; }
+        };
+
+        // 以驱动协程的句柄发起等待体的下一次 IO
+        struct DriverStep
+        {
+            DriverState& state;
+            RedisDrivenStep& step;
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                ++state.stats.io_steps;
+                bool suspended = step.suspendStep(handle);
+                if (suspended) {
+                    ++state.stats.io_wakeups;
+                }
+                return suspended;
+            }
+            void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief 交给驱动协程执行，在等待体的 await_suspend 中调用
+         * @return 调用方是否需要挂起（false 表示已同步得到最终结果）
+         */
+        bool drive(RedisDrivenStep& step, std::coroutine_handle<> handle);
+
+        // 让空闲的驱动协程退出
+        void stopDriver() noexcept;
+
+        static Coroutine driveLoop(std::shared_ptr<DriverState> state);
+
+        /**
+         * @brief 从帧起点解析一个回复，按 decode_mode 构造 RedisValue
+         * @return pair<帧字节数, 值>
+         */
+        std::expected<std::pair<size_t, RedisValue>, protocol::ParseError>
+            parseValue(const char* data, size_t length);
+
+        /**
+         * @brief 取出上一条命令的编码缓冲区并清空，复用其容量；仅在 m_cmd_awaitable 可重建时调用
+         */
+        std::string takeCommandBuffer();
+
+        /**
+         * @brief 同 takeCommandBuffer，取自 m_view_awaitable；仅在 m_view_awaitable 可重建时调用
+         */
+        std::string takeViewBuffer();
+
+        /**
+         * @brief 固定参数个数的命令：前缀编译期生成，只在需要新建 awaitable 时编码参数
+         */
+        template<typename Cmd, typename... Args>
+        RedisClientAwaitable& executeCommand(const Args&... args)
+        {
+            if (!m_cmd_awaitable.has_value() || m_cmd_awaitable->isInvalid()) {
+                std::string encoded = takeCommandBuffer();
+                Cmd::append(encoded, args...);
+                m_cmd_awaitable.emplace(*this, std::move(encoded), 1);
+            }
+            return *m_cmd_awaitable;
+        }
 
         // 成员变量
-        bool m_is_closed = false;
+        std::atomic<bool> m_is_closed{false};
         TcpSocket m_socket;
         IOScheduler* m_scheduler;
         protocol::RespEncoder m_encoder;
         protocol::RespParser m_parser;
         AsyncRedisConfig m_config;
-        RingBuffer m_ring_buffer;
+        RedisAdaptiveWindow m_adaptive_window;  // pipelineStream 的窗口，跨调用保留
+        RedisBuffer m_recv_buffer;
+
+        // 借用式回复状态
+        protocol::RespViewParser m_view_parser;
+        std::vector<protocol::RespViewNode> m_view_nodes;
+        protocol::RespTapeParser m_tape_parser;
+        std::vector<protocol::RespTapeEntry> m_tape_entries;
+        protocol::RespVisitParser m_visit_parser;
+        protocol::RespBulkStreamParser m_stream_parser;
+        size_t m_borrowed_bytes = 0;        // 借出中的帧长度，0表示没有借出
+        uint64_t m_borrow_generation = 0;   // 每次借出递增，用于识别已失效的句柄
+
+        // 超时命令迟到的回复：按个数跳过，不构造任何值
+        size_t m_stale_replies = 0;
+        protocol::RespVisitParser m_stale_parser;
+        bool m_stale_stream = false;                        // getStream 超时时已交付一部分的帧
+        protocol::RespBulkStreamParser m_stale_stream_parser;
 
         // 存储 awaitable 对象
         std::optional<RedisClientAwaitable> m_cmd_awaitable;
         std::optional<RedisPipelineAwaitable> m_pipeline_awaitable;
+        std::optional<RedisPipelineStreamAwaitable> m_pipeline_stream_awaitable;
         std::optional<RedisConnectAwaitable> m_connect_awaitable;
+        std::optional<RedisViewAwaitable> m_view_awaitable;
+        std::optional<RedisVisitAwaitable> m_visit_awaitable;
+        std::optional<RedisStreamAwaitable> m_stream_awaitable;
+
+        // 单次恢复等待体共用的驱动协程，第一条命令时启动
+        std::shared_ptr<DriverState> m_driver;
 
         std::shared_ptr<spdlog::logger> m_logger;
     };
@@ -1,54 +1,87 @@
 #include "RedisConnectionPool.h"
 #include "galay-redis/base/RedisLog.h"
 #include <algorithm>
+#include <functional>
 
 namespace galay::redis
 {
+    // ======================== PoolConnectAwaitable 实现 ========================
+
+    PoolConnectAwaitable::PoolConnectAwaitable(RedisConnectionPool& pool, size_t count, IOScheduler* scheduler)
+        : m_pool(pool)
+        , m_count(count)
+        , m_scheduler(scheduler)
+    {
+    }
+
+    bool PoolConnectAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        m_batch = m_pool.startConnect(m_count, m_scheduler);
+
+        // 连接协程在别的线程结束时也只会在此之后看到 waiter
+        std::lock_guard<std::mutex> lock(m_batch->mutex);
+        if (m_batch->pending == 0) {
+            return false;
+        }
+        m_batch->waiter = handle;
+        return true;
+    }
+
+    std::expected<size_t, RedisError> PoolConnectAwaitable::await_resume()
+    {
+        if (!m_batch) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(m_batch->mutex);
+        if (m_batch->requested > 0 && m_batch->connected == 0 && m_batch->last_error) {
+            return std::unexpected(*m_batch->last_error);
+        }
+        return m_batch->connected;
+    }
+
     // ======================== PoolInitializeAwaitable 实现 ========================
 
     PoolInitializeAwaitable::PoolInitializeAwaitable(RedisConnectionPool& pool)
         : m_pool(pool)
+        , m_connect(pool, pool.m_config.initial_connections)
     {
     }
 
     bool PoolInitializeAwaitable::await_suspend(std::coroutine_handle<> handle)
     {
-        // 创建初始连接（同步方式）
-        while (m_created_count < m_pool.m_config.initial_connections) {
-            auto result = m_pool.getConnectionSync();
-            if (result) {
-                m_created_count++;
-            } else {
-                // 创建失败，停止
-                RedisLogError(m_pool.m_logger, "Failed to create connection {}/{}: {}",
-                             m_created_count + 1, m_pool.m_config.initial_connections,
-                             result.error().message());
-                break;
-            }
+        // 所有初始连接并发握手
+        if (m_connect.await_ready()) {
+            return false;
         }
-
-        // 立即恢复协程
-        return false;
+        return m_connect.await_suspend(handle);
     }
 
     RedisVoidResult PoolInitializeAwaitable::await_resume()
     {
-        if (m_created_count < m_pool.m_config.min_connections) {
-            return std::unexpected(RedisError(
-                RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
-                "Failed to create minimum connections"
-            ));
+        auto result = m_connect.await_resume();
+        size_t created = result ? result.value() : 0;
+
+        if (created < m_pool.m_config.min_connections) {
+            std::string message = "Failed to create minimum connections (" + std::to_string(created) + "/" +
+                                  std::to_string(m_pool.m_config.min_connections) + ")";
+            if (!result) {
+                message += ": " + result.error().message();
+            }
+            RedisLogError(m_pool.m_logger, "{}", message);
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR, message));
         }
 
         m_pool.m_is_initialized = true;
-        RedisLogInfo(m_pool.m_logger, "Connection pool initialized with {} connections", m_created_count);
+        m_pool.startHealthCheck();
+        RedisLogInfo(m_pool.m_logger, "Connection pool initialized with {} connections", created);
         return {};
     }
 
     // ======================== PoolAcquireAwaitable 实现 ========================
 
-    PoolAcquireAwaitable::PoolAcquireAwaitable(RedisConnectionPool& pool)
+    PoolAcquireAwaitable::PoolAcquireAwaitable(RedisConnectionPool& pool, IOScheduler* scheduler)
         : m_pool(pool)
+        , m_scheduler(scheduler ? scheduler : pool.m_scheduler)
         , m_start_time(std::chrono::steady_clock::now())
     {
     }
@@ -63,62 +96,111 @@ namespace galay::redis
             return false;  // 立即恢复，返回错误
         }
 
-        m_pool.m_waiting_requests++;
+        RedisConnectionPool& pool = m_pool;
+
+        // 分片模式：先无锁地取本分片，再从其他分片窃取（亲和模式只取本调度器的分片）
+        PoolShard* shard = nullptr;
+        bool claimed = false;
+        if (pool.m_shard_count > 0) {
+            shard = m_shard = pool.shardFor(m_scheduler, &claimed);
+            if (!shard) {
+                m_error = RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                     "No shard left for scheduler, shard_count must cover every scheduler");
+                return false;
+            }
+            while (auto conn = pool.m_affinity ? pool.popShard(*shard) : pool.popAnyShard(shard)) {
+                if (!conn->isClosed() && conn->isHealthy()) {
+                    m_conn = std::move(conn);
+                    return false;  // 立即恢复
+                }
+                std::lock_guard<std::mutex> lock(pool.m_mutex);
+                if (pool.removeConnectionLocked(conn)) {
+                    pool.m_total_destroyed++;
+                }
+            }
+        }
+
+        // 亲和模式的新连接建在调用方的调度器上，否则建在连接池的调度器上
+        IOScheduler* scheduler = pool.m_affinity ? m_scheduler : nullptr;
+        size_t grow = 0;
+        bool self_served = false;
+        std::vector<PoolAcquireAwaitable*> woken;
+        std::shared_ptr<PooledConnection> retired;
+        {
+            std::lock_guard<std::mutex> lock(pool.m_mutex);
 
-        std::lock_guard<std::mutex> lock(m_pool.m_mutex);
+            // 尝试从可用连接中获取（亲和模式的空闲连接都在各调度器的分片中）
+            while (!pool.m_affinity && !pool.m_available_connections.empty()) {
+                m_conn = pool.m_available_connections.front();
+                pool.m_available_connections.pop();
 
-        // 尝试从可用连接中获取
-        while (!m_pool.m_available_connections.empty()) {
-            m_conn = m_pool.m_available_connections.front();
-            m_pool.m_available_connections.pop();
+                // 检查连接是否健康
+                if (!m_conn->isClosed() && m_conn->isHealthy()) {
+                    return false;  // 立即恢复
+                }
 
-            // 检查连接是否健康
-            if (!m_conn->isClosed() && m_conn->isHealthy()) {
-                m_conn->updateLastUsed();
-                m_pool.m_total_acquired++;
-                m_pool.m_waiting_requests--;
-                return false;  // 立即恢复
-            } else {
                 // 连接不健康，销毁并继续
-                auto it = std::find(m_pool.m_all_connections.begin(),
-                                   m_pool.m_all_connections.end(), m_conn);
-                if (it != m_pool.m_all_connections.end()) {
-                    m_pool.m_all_connections.erase(it);
+                if (pool.removeConnectionLocked(m_conn)) {
+                    pool.m_total_destroyed++;
                 }
-                m_pool.m_total_destroyed++;
                 m_conn = nullptr;
             }
-        }
 
-        // 如果还可以创建新连接
-        if (m_pool.m_all_connections.size() < m_pool.m_config.max_connections) {
-            // 释放锁后创建连接
-            m_pool.m_mutex.unlock();
-            auto result = m_pool.getConnectionSync();
-            m_pool.m_mutex.lock();
+            // 与 shutdown() 清空等待队列互斥，关闭后不再排队
+            if (pool.m_is_shutting_down) {
+                return false;
+            }
 
-            if (result) {
-                m_conn = result.value();
-                m_conn->updateLastUsed();
-                m_pool.m_total_acquired++;
-                m_pool.m_waiting_requests--;
-
-                RedisLogDebug(m_pool.m_logger, "Created and acquired new connection, total: {}",
-                             m_pool.m_all_connections.size());
-                return false;  // 立即恢复
-            } else {
-                RedisLogWarn(m_pool.m_logger, "Failed to create new connection: {}",
-                            result.error().message());
+            if (pool.m_config.acquire_timeout.count() <= 0) {
+                return false;  // 不排队（返回错误）
+            }
+
+            // 排队：release() 或新建的连接按 FIFO 移交，超时由定时器恢复
+            m_handle = handle;
+            m_deadline = m_start_time + pool.m_config.acquire_timeout;
+            pool.pushWaiterLocked(this);
+
+            // 入队后再查一次分片：无锁归还可能恰好发生在上面的窃取之后
+            if (shard) {
+                pool.serveWaitersFromShardsLocked(woken, this, self_served);
             }
+
+            if (pool.m_affinity) {
+                // 首次使用的调度器先补到每调度器最少连接数，再按排队情况补连接或迁移
+                if (claimed && shard->bound + shard->connecting < pool.m_config.min_connections_per_scheduler) {
+                    grow += pool.reserveConnectsLocked(
+                        pool.m_config.min_connections_per_scheduler - shard->bound - shard->connecting, scheduler);
+                }
+                if (!self_served && pool.provideForSchedulerLocked(*shard, scheduler, retired)) {
+                    ++grow;
+                }
+            } else if (!self_served && pool.m_waiting_requests.load() > pool.m_connecting) {
+                // 排队的调用方多于正在握手的连接时再建一个（按 max_connections 截断）
+                grow = pool.reserveConnectsLocked(1, scheduler);
+            }
+        }
+
+        for (auto* waiter : woken) {
+            RedisConnectionPool::wakeWaiter(waiter);
         }
 
-        m_pool.m_waiting_requests--;
-        return false;  // 立即恢复，返回错误
+        // 此后本对象可能已被其他线程恢复，不能再访问成员
+        if (retired) {
+            RedisConnectionPool::retireConnection(std::move(retired));
+        }
+        if (grow > 0) {
+            pool.launchConnects(grow, scheduler);
+        }
+        return !self_served;
     }
 
     std::expected<std::shared_ptr<PooledConnection>, RedisError>
     PoolAcquireAwaitable::await_resume()
     {
+        if (m_error) {
+            return std::unexpected(*m_error);
+        }
+
         if (!m_pool.m_is_initialized) {
             return std::unexpected(RedisError(
                 RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
@@ -140,6 +222,13 @@ namespace galay::redis
             ));
         }
 
+        // 亲和模式下连接的分片固定不变；否则记录获取方的分片，归还时放回这里
+        if (m_pool.m_shard_count > 0 && !m_pool.m_affinity) {
+            m_conn->m_shard = m_shard ? m_shard : m_pool.shardFor(m_scheduler);
+        }
+        m_conn->updateLastUsed();
+        m_pool.m_total_acquired++;
+
         // 更新性能指标
         auto elapsed = std::chrono::steady_clock::now() - m_start_time;
         auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
@@ -153,7 +242,7 @@ namespace galay::redis
         }
 
         // 更新峰值活跃连接数
-        size_t active = m_pool.m_all_connections.size() - m_pool.m_available_connections.size();
+        size_t active = ++m_pool.m_active_connections;
         size_t current_peak = m_pool.m_peak_active_connections.load();
         while (active > current_peak) {
             if (m_pool.m_peak_active_connections.compare_exchange_weak(current_peak, active)) {
@@ -169,12 +258,27 @@ namespace galay::redis
     RedisConnectionPool::RedisConnectionPool(IOScheduler* scheduler, ConnectionPoolConfig config)
         : m_scheduler(scheduler)
         , m_config(std::move(config))
+        , m_anchor(std::make_shared<PoolAnchor>())
     {
+        m_anchor->pool = this;
+
         // 验证配置
         if (!m_config.validate()) {
             throw std::invalid_argument("Invalid connection pool configuration");
         }
 
+        // 分片模式：每个连接一个槽位，分片栈只存槽位下标
+        if (m_config.shard_count > 0) {
+            m_shard_count = m_config.shard_count;
+            m_affinity = m_config.scheduler_affinity;
+            m_shards = std::make_unique<PoolShard[]>(m_shard_count);
+            m_slots = std::make_unique<PoolSlot[]>(m_config.max_connections);
+            m_free_slots.reserve(m_config.max_connections);
+            for (size_t i = m_config.max_connections; i > 0; --i) {
+                m_free_slots.push_back(static_cast<uint32_t>(i - 1));
+            }
+        }
+
         // 初始化日志
         try {
             m_logger = spdlog::get("RedisConnectionPool");
@@ -200,6 +304,14 @@ namespace galay::redis
             RedisLogWarn(m_logger, "Connection pool destroyed without proper shutdown");
             shutdown();
         }
+        detachAnchor();
+        stopTimer();
+    }
+
+    void RedisConnectionPool::detachAnchor()
+    {
+        std::lock_guard<std::mutex> lock(m_anchor->mutex);
+        m_anchor->pool = nullptr;
     }
 
     PoolInitializeAwaitable& RedisConnectionPool::initialize()
@@ -210,12 +322,9 @@ namespace galay::redis
         return *m_init_awaitable;
     }
 
-    PoolAcquireAwaitable& RedisConnectionPool::acquire()
+    PoolAcquireAwaitable RedisConnectionPool::acquire(IOScheduler* scheduler)
     {
-        if (!m_acquire_awaitable.has_value()) {
-            m_acquire_awaitable.emplace(*this);
-        }
-        return *m_acquire_awaitable;
+        return PoolAcquireAwaitable(*this, scheduler);
     }
 
     void RedisConnectionPool::release(std::shared_ptr<PooledConnection> conn)
@@ -229,95 +338,739 @@ namespace galay::redis
             return;
         }
 
-        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_active_connections;
+
+        // 分片模式：健康的连接无锁放回获取时所在的分片（亲和模式下即所属调度器的分片）
+        if (m_shard_count > 0 && !conn->isClosed() && conn->isHealthy()) {
+            uint32_t slot = conn->m_slot.load();
+            if (slot != PoolShard::kEmpty) {
+                m_total_released++;
+                pushShard(conn->m_shard ? *conn->m_shard : m_shards[0], slot);
+
+                // 与正在入队的调用方交错：对方入队后会再查分片，这里入栈后再查队列，二者至少有一方看到对方
+                if (m_waiting_requests.load() > 0) {
+                    std::vector<PoolAcquireAwaitable*> woken;
+                    std::vector<std::shared_ptr<PooledConnection>> retired;
+                    std::vector<IOScheduler*> targets;
+                    bool unused = false;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        serveWaitersFromShardsLocked(woken, nullptr, unused);
+                        if (m_affinity) {
+                            rebalanceLocked(retired, targets);
+                        }
+                    }
+                    for (auto* waiter : woken) {
+                        wakeWaiter(waiter);
+                    }
+                    for (auto& donor : retired) {
+                        retireConnection(std::move(donor));
+                    }
+                    for (auto* target : targets) {
+                        launchConnects(1, target);
+                    }
+                }
+                return;
+            }
+        }
+
+        PoolAcquireAwaitable* waiter = nullptr;
+        bool replace = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // 检查连接是否健康
+            if (conn->isClosed() || !conn->isHealthy()) {
+                RedisLogWarn(m_logger, "Unhealthy connection released, removing from pool");
+                if (removeConnectionLocked(conn)) {
+                    m_total_destroyed++;
+                }
+                // 有调用方在排队时补建一个连接（亲和模式下只看该连接所属调度器）
+                if (m_affinity && conn->m_shard) {
+                    replace = conn->m_shard->waiting > conn->m_shard->connecting;
+                } else {
+                    replace = m_waiting_requests.load() > m_connecting;
+                }
+            } else if (m_all_connections.size() > m_config.max_connections) {
+                // 如果连接数超过最大值，销毁连接
+                RedisLogDebug(m_logger, "Pool size exceeds max, destroying connection");
+                if (removeConnectionLocked(conn)) {
+                    m_total_destroyed++;
+                }
+            } else {
+                // 交给最早排队的调用方，或归还到可用连接池
+                m_total_released++;
+                waiter = dispatchLocked(conn);
+
+                RedisLogDebug(m_logger, "Connection released to {}, available: {}, total: {}",
+                             waiter ? "waiter" : "pool", m_available_connections.size(), m_all_connections.size());
+            }
+        }
+
+        if (waiter) {
+            wakeWaiter(waiter);
+        } else if (replace) {
+            startConnect(1, m_affinity ? conn->scheduler() : nullptr);
+        }
+    }
+
+    void RedisConnectionPool::registerConnectionLocked(const std::shared_ptr<PooledConnection>& conn)
+    {
+        conn->m_index = m_all_connections.size();
+        m_all_connections.push_back(conn);
+
+        // 亲和模式：连接固定归属其调度器的分片
+        if (m_affinity) {
+            conn->m_shard = shardFor(conn->scheduler());
+            if (conn->m_shard) {
+                conn->m_shard->bound++;
+            }
+        }
+
+        // 槽位数等于 max_connections，startConnect 已保证不会超出；万一没有槽位则只走全局队列
+        if (m_shard_count > 0 && !m_free_slots.empty()) {
+            uint32_t slot = m_free_slots.back();
+            m_free_slots.pop_back();
+            m_slots[slot].conn = conn;
+            conn->m_slot = slot;
+        }
+    }
+
+    bool RedisConnectionPool::removeConnectionLocked(const std::shared_ptr<PooledConnection>& conn)
+    {
+        size_t index = conn->m_index;
+        if (index >= m_all_connections.size() || m_all_connections[index] != conn) {
+            return false;  // 已被移除
+        }
+
+        // 与末尾交换后弹出
+        if (index + 1 != m_all_connections.size()) {
+            m_all_connections[index] = std::move(m_all_connections.back());
+            m_all_connections[index]->m_index = index;
+        }
+        m_all_connections.pop_back();
+
+        uint32_t slot = conn->m_slot.exchange(PoolShard::kEmpty);
+        if (slot != PoolShard::kEmpty) {
+            m_slots[slot].conn.reset();
+            m_free_slots.push_back(slot);
+        }
+        if (m_affinity && conn->m_shard) {
+            conn->m_shard->bound--;
+        }
+        return true;
+    }
+
+    PoolShard* RedisConnectionPool::shardFor(IOScheduler* scheduler, bool* claimed)
+    {
+        size_t start = std::hash<IOScheduler*>{}(scheduler) % m_shard_count;
+        for (size_t i = 0; i < m_shard_count; ++i) {
+            PoolShard& shard = m_shards[(start + i) % m_shard_count];
+            IOScheduler* owner = shard.owner.load(std::memory_order_acquire);
+            if (owner == nullptr && shard.owner.compare_exchange_strong(owner, scheduler)) {
+                if (claimed) {
+                    *claimed = true;
+                }
+                return &shard;
+            }
+            if (owner == scheduler) {
+                return &shard;
+            }
+        }
+        // 调度器多于分片数时共用；亲和模式下共用会让连接跨调度器，不允许
+        return m_affinity ? nullptr : &m_shards[start];
+    }
+
+    void RedisConnectionPool::pushShard(PoolShard& shard, uint32_t slot)
+    {
+        // 先计数再入栈，并发出栈时计数不会小于 0
+        shard.size++;
+        uint64_t head = shard.head.load();
+        uint64_t next;
+        do {
+            m_slots[slot].next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            next = (((head >> 32) + 1) << 32) | slot;
+        } while (!shard.head.compare_exchange_weak(head, next));
+    }
+
+    std::shared_ptr<PooledConnection> RedisConnectionPool::popShard(PoolShard& shard)
+    {
+        uint64_t head = shard.head.load();
+        while (true) {
+            uint32_t slot = static_cast<uint32_t>(head);
+            if (slot == PoolShard::kEmpty) {
+                return nullptr;
+            }
+            // 版本号随每次修改递增，栈顶被取走又放回时 CAS 失败
+            uint64_t next = (((head >> 32) + 1) << 32) | m_slots[slot].next.load(std::memory_order_relaxed);
+            if (shard.head.compare_exchange_weak(head, next)) {
+                shard.size--;
+                return m_slots[slot].conn;
+            }
+        }
+    }
 
-        // 检查连接是否健康
-        if (conn->isClosed() || !conn->isHealthy()) {
-            RedisLogWarn(m_logger, "Unhealthy connection released, removing from pool");
-            auto it = std::find(m_all_connections.begin(), m_all_connections.end(), conn);
-            if (it != m_all_connections.end()) {
-                m_all_connections.erase(it);
+    std::shared_ptr<PooledConnection> RedisConnectionPool::popAnyShard(PoolShard* preferred)
+    {
+        if (preferred) {
+            if (auto conn = popShard(*preferred)) {
+                return conn;
+            }
+        }
+        for (size_t i = 0; i < m_shard_count; ++i) {
+            if (&m_shards[i] == preferred) {
+                continue;
+            }
+            if (auto conn = popShard(m_shards[i])) {
+                return conn;
+            }
+        }
+        return nullptr;
+    }
+
+    void RedisConnectionPool::drainShardsLocked()
+    {
+        for (size_t i = 0; i < m_shard_count; ++i) {
+            while (auto conn = popShard(m_shards[i])) {
+                m_available_connections.push(std::move(conn));
             }
-            m_total_destroyed++;
+        }
+    }
+
+    void RedisConnectionPool::refillShardsLocked(std::vector<PoolAcquireAwaitable*>& woken)
+    {
+        if (m_shard_count == 0 || (!m_affinity && m_waiters_head == nullptr)) {
             return;
         }
+        // drainShardsLocked 收回的连接期间可能有调用方排队，逐个重新分发
+        std::queue<std::shared_ptr<PooledConnection>> idle;
+        idle.swap(m_available_connections);
+        while (!idle.empty()) {
+            auto conn = std::move(idle.front());
+            idle.pop();
+            if (auto* waiter = dispatchLocked(std::move(conn))) {
+                woken.push_back(waiter);
+            }
+        }
+    }
 
-        // 如果连接数超过最大值，销毁连接
-        if (m_all_connections.size() > m_config.max_connections) {
-            RedisLogDebug(m_logger, "Pool size exceeds max, destroying connection");
-            auto it = std::find(m_all_connections.begin(), m_all_connections.end(), conn);
-            if (it != m_all_connections.end()) {
-                m_all_connections.erase(it);
+    std::vector<std::pair<IOScheduler*, size_t>> RedisConnectionPool::reservePerSchedulerLocked()
+    {
+        std::vector<std::pair<IOScheduler*, size_t>> reserved;
+        if (!m_affinity || m_config.min_connections_per_scheduler == 0) {
+            return reserved;
+        }
+        for (size_t i = 0; i < m_shard_count; ++i) {
+            PoolShard& shard = m_shards[i];
+            IOScheduler* owner = shard.owner.load(std::memory_order_acquire);
+            size_t have = shard.bound + shard.connecting;
+            if (owner == nullptr || have >= m_config.min_connections_per_scheduler) {
+                continue;
+            }
+            size_t count = reserveConnectsLocked(m_config.min_connections_per_scheduler - have, owner);
+            if (count > 0) {
+                reserved.emplace_back(owner, count);
+            }
+        }
+        return reserved;
+    }
+
+    void RedisConnectionPool::serveWaitersFromShardsLocked(std::vector<PoolAcquireAwaitable*>& woken,
+                                                           PoolAcquireAwaitable* self, bool& self_served)
+    {
+        if (!m_affinity) {
+            while (m_waiters_head) {
+                auto conn = popAnyShard(nullptr);
+                if (!conn) {
+                    break;
+                }
+                if (conn->isClosed() || !conn->isHealthy()) {
+                    if (removeConnectionLocked(conn)) {
+                        m_total_destroyed++;
+                    }
+                    continue;
+                }
+                PoolAcquireAwaitable* waiter = dispatchLocked(std::move(conn));
+                if (waiter == self) {
+                    self_served = true;
+                } else {
+                    woken.push_back(waiter);
+                }
             }
-            m_total_destroyed++;
             return;
         }
 
-        // 归还到可用连接池
-        m_available_connections.push(conn);
-        m_total_released++;
+        // 亲和模式：每个调用方只能拿自己调度器分片中的连接，按排队顺序逐个匹配
+        PoolAcquireAwaitable* prev = nullptr;
+        PoolAcquireAwaitable* waiter = m_waiters_head;
+        while (waiter) {
+            auto conn = waiter->m_shard ? popShard(*waiter->m_shard) : nullptr;
+            if (!conn) {
+                prev = waiter;
+                waiter = waiter->m_next;
+                continue;
+            }
+            if (conn->isClosed() || !conn->isHealthy()) {
+                if (removeConnectionLocked(conn)) {
+                    m_total_destroyed++;
+                }
+                continue;
+            }
+            PoolAcquireAwaitable* next = waiter->m_next;
+            unlinkWaiterLocked(waiter, prev);
+            waiter->m_conn = std::move(conn);
+            if (waiter == self) {
+                self_served = true;
+            } else {
+                woken.push_back(waiter);
+            }
+            waiter = next;
+        }
+    }
+
+    PoolAcquireAwaitable* RedisConnectionPool::dispatchLocked(std::shared_ptr<PooledConnection> conn)
+    {
+        PoolAcquireAwaitable* waiter = nullptr;
+        if (!m_affinity || conn->m_shard) {
+            waiter = takeWaiterLocked(conn->m_shard);
+        }
+        if (waiter) {
+            waiter->m_conn = std::move(conn);
+            return waiter;
+        }
+
+        // 亲和模式的空闲连接放回所属调度器的分片
+        uint32_t slot = conn->m_slot.load();
+        if (m_affinity && conn->m_shard && slot != PoolShard::kEmpty) {
+            pushShard(*conn->m_shard, slot);
+        } else {
+            m_available_connections.push(std::move(conn));
+        }
+        return nullptr;
+    }
 
-        RedisLogDebug(m_logger, "Connection released to pool, available: {}, total: {}",
-                     m_available_connections.size(), m_all_connections.size());
+    void RedisConnectionPool::pushWaiterLocked(PoolAcquireAwaitable* waiter)
+    {
+        waiter->m_next = nullptr;
+        bool was_empty = m_waiters_head == nullptr;
+        if (was_empty) {
+            m_waiters_head = waiter;
+        } else {
+            m_waiters_tail->m_next = waiter;
+        }
+        m_waiters_tail = waiter;
+        m_waiting_requests++;
+        if (m_affinity && waiter->m_shard) {
+            waiter->m_shard->waiting++;
+        }
 
-        m_cv.notify_one();
+        if (!m_timer_thread.joinable() && !m_timer_stop) {
+            m_timer_thread = std::thread([this] { timerLoop(); });
+        } else if (was_empty) {
+            // 新的队首：定时器按它的截止时间重新等待
+            m_cv.notify_one();
+        }
     }
 
-    std::expected<std::shared_ptr<PooledConnection>, RedisError>
-    RedisConnectionPool::getConnectionSync()
+    PoolAcquireAwaitable* RedisConnectionPool::popWaiterLocked()
+    {
+        PoolAcquireAwaitable* waiter = m_waiters_head;
+        if (waiter) {
+            unlinkWaiterLocked(waiter, nullptr);
+        }
+        return waiter;
+    }
+
+    void RedisConnectionPool::unlinkWaiterLocked(PoolAcquireAwaitable* waiter, PoolAcquireAwaitable* prev)
     {
-        RedisLogDebug(m_logger, "Creating new connection to {}:{}", m_config.host, m_config.port);
+        // 从中间摘除不改变其余调用方的先后顺序，定时器仍只需检查队首
+        if (prev) {
+            prev->m_next = waiter->m_next;
+        } else {
+            m_waiters_head = waiter->m_next;
+        }
+        if (m_waiters_tail == waiter) {
+            m_waiters_tail = prev;
+        }
+        waiter->m_next = nullptr;
+        m_waiting_requests--;
+        if (m_affinity && waiter->m_shard) {
+            waiter->m_shard->waiting--;
+        }
+    }
 
-        // 带重试的连接创建
-        for (int attempt = 0; attempt < m_config.max_reconnect_attempts; ++attempt) {
-            if (attempt > 0) {
-                m_reconnect_attempts++;
-                RedisLogInfo(m_logger, "Reconnect attempt {}/{} for {}:{}",
-                            attempt + 1, m_config.max_reconnect_attempts,
-                            m_config.host, m_config.port);
+    PoolAcquireAwaitable* RedisConnectionPool::takeWaiterLocked(PoolShard* shard)
+    {
+        if (!m_affinity) {
+            return popWaiterLocked();
+        }
+        if (!shard || shard->waiting == 0) {
+            return nullptr;
+        }
+        PoolAcquireAwaitable* prev = nullptr;
+        for (PoolAcquireAwaitable* waiter = m_waiters_head; waiter; prev = waiter, waiter = waiter->m_next) {
+            if (waiter->m_shard == shard) {
+                unlinkWaiterLocked(waiter, prev);
+                return waiter;
             }
+        }
+        return nullptr;
+    }
 
-            try {
-                auto client = std::make_shared<RedisClient>(m_scheduler);
-                auto conn = std::make_shared<PooledConnection>(client, m_scheduler);
+    void RedisConnectionPool::wakeWaiter(PoolAcquireAwaitable* waiter)
+    {
+        // spawn 之后调用方随时可能恢复并销毁 waiter
+        IOScheduler* scheduler = waiter->m_scheduler;
+        std::coroutine_handle<> handle = waiter->m_handle;
+        scheduler->spawn(resumeTask(handle));
+    }
 
-                // 注意：这里需要在协程上下文中调用 co_await client->connect()
-                // 由于当前是同步方法，暂时创建未连接的客户端
-                // 实际使用时，连接会在第一次使用时建立
+    Coroutine RedisConnectionPool::resumeTask(std::coroutine_handle<> handle)
+    {
+        handle.resume();
+        co_return;
+    }
 
-                {
-                    std::lock_guard<std::mutex> lock(m_mutex);
-                    m_all_connections.push_back(conn);
-                    m_total_created++;
+    void RedisConnectionPool::timerLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_timer_stop) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= m_next_health_check) {
+                // 健康检查只发起探测，不在定时器线程上等待结果
+                m_next_health_check = now + m_config.health_check_interval;
+                lock.unlock();
+                triggerHealthCheck();
+                lock.lock();
+                continue;
+            }
+
+            auto deadline = m_next_health_check;
+            if (m_waiters_head) {
+                if (now >= m_waiters_head->m_deadline) {
+                    PoolAcquireAwaitable* waiter = popWaiterLocked();
+                    waiter->m_error = RedisError(
+                        RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR,
+                        "Timed out waiting for a connection after " +
+                            std::to_string(m_config.acquire_timeout.count()) + " ms");
+                    lock.unlock();
+                    wakeWaiter(waiter);
+                    lock.lock();
+                    continue;
                 }
+                deadline = std::min(deadline, m_waiters_head->m_deadline);
+            }
+
+            if (deadline == std::chrono::steady_clock::time_point::max()) {
+                m_cv.wait(lock);
+            } else {
+                m_cv.wait_until(lock, deadline);
+            }
+        }
+    }
+
+    void RedisConnectionPool::startHealthCheck()
+    {
+        if (!m_config.enable_health_check || m_config.health_check_interval.count() <= 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_next_health_check = std::chrono::steady_clock::now() + m_config.health_check_interval;
+        if (!m_timer_thread.joinable() && !m_timer_stop) {
+            m_timer_thread = std::thread([this] { timerLoop(); });
+        } else {
+            m_cv.notify_one();
+        }
+    }
+
+    void RedisConnectionPool::stopTimer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_timer_stop = true;
+        }
+        m_cv.notify_all();
+        if (m_timer_thread.joinable()) {
+            m_timer_thread.join();
+        }
+    }
 
-                if (attempt > 0) {
+    std::shared_ptr<PoolConnectBatch> RedisConnectionPool::startConnect(size_t count, IOScheduler* scheduler)
+    {
+        if (m_is_shutting_down) {
+            return std::make_shared<PoolConnectBatch>();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            count = reserveConnectsLocked(count, scheduler);
+        }
+        return launchConnects(count, scheduler);
+    }
+
+    size_t RedisConnectionPool::reserveConnectsLocked(size_t count, IOScheduler* scheduler)
+    {
+        // 正在握手的连接也占用名额
+        size_t used = m_all_connections.size() + m_connecting;
+        size_t room = used < m_config.max_connections ? m_config.max_connections - used : 0;
+        count = std::min(count, room);
+        m_connecting += count;
+        if (m_affinity && count > 0) {
+            if (PoolShard* shard = shardFor(scheduler ? scheduler : m_scheduler)) {
+                shard->connecting += count;
+            }
+        }
+        return count;
+    }
+
+    std::shared_ptr<PoolConnectBatch> RedisConnectionPool::launchConnects(size_t count, IOScheduler* scheduler)
+    {
+        auto batch = std::make_shared<PoolConnectBatch>();
+        if (count == 0) {
+            return batch;
+        }
+
+        // 连接在目标调度器上建立，此后它的 IO 都由该调度器驱动
+        IOScheduler* target = scheduler ? scheduler : m_scheduler;
+        batch->requested = count;
+        batch->pending = count;
+        RedisLogDebug(m_logger, "Creating {} connections to {}:{}", count, m_config.host, m_config.port);
+        for (size_t i = 0; i < count; ++i) {
+            target->spawn(connectTask(m_anchor, batch, target, m_config));
+        }
+        return batch;
+    }
+
+    Coroutine RedisConnectionPool::connectTask(std::shared_ptr<PoolAnchor> anchor,
+                                               std::shared_ptr<PoolConnectBatch> batch,
+                                               IOScheduler* scheduler,
+                                               ConnectionPoolConfig config)
+    {
+        std::shared_ptr<RedisClient> client;
+        std::optional<RedisError> error;
+        int attempts = 0;
+        int max_attempts = std::max(config.max_reconnect_attempts, 1);
+
+        while (attempts < max_attempts) {
+            ++attempts;
+            client = std::make_shared<RedisClient>(scheduler);
+            auto result = co_await client->connect(config.host, config.port,
+                                                   config.username, config.password,
+                                                   config.db_index).timeout(config.connect_timeout);
+            if (result) {
+                error.reset();
+                break;
+            }
+            error = result.error();
+            // 超时作用在连接/认证的内核 IO 上，返回时 IO 已被取消，内核不再引用客户端；
+            // 握手失败的客户端已标记为关闭，这里关闭 socket 后放弃唯一的引用，客户端随之析构
+            co_await client->close();
+            client.reset();
+        }
+
+        bool registered = false;
+        PoolAcquireAwaitable* woken = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(anchor->mutex);
+            if (anchor->pool) {
+                woken = anchor->pool->onConnectFinished(scheduler, client, attempts, error);
+                registered = client != nullptr;
+            }
+        }
+        if (woken) {
+            wakeWaiter(woken);
+        }
+        if (!registered && client) {
+            // 连接池已关闭：握手成功的连接直接关闭
+            co_await client->close();
+        }
+
+        std::coroutine_handle<> waiter;
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            if (registered) {
+                ++batch->connected;
+            } else {
+                batch->last_error = error.value_or(RedisError(
+                    RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR, "Connection pool is shutting down"));
+            }
+            if (--batch->pending == 0) {
+                waiter = std::exchange(batch->waiter, {});
+            }
+        }
+        if (waiter) {
+            waiter.resume();
+        }
+    }
+
+    PoolAcquireAwaitable* RedisConnectionPool::onConnectFinished(IOScheduler* scheduler,
+                                                                 std::shared_ptr<RedisClient> client, int attempts,
+                                                                 const std::optional<RedisError>& error)
+    {
+        if (attempts > 1) {
+            m_reconnect_attempts += attempts - 1;
+        }
+
+        PoolAcquireAwaitable* waiter = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_connecting;
+            PoolShard* shard = m_affinity ? shardFor(scheduler) : nullptr;
+            if (shard) {
+                --shard->connecting;
+            }
+            if (!client) {
+                RedisLogError(m_logger, "Failed to create connection to {}:{} after {} attempts",
+                             m_config.host, m_config.port, attempts);
+                // 为排队的调用方建的连接失败：最早的调用方直接返回错误，不必等到超时
+                if (m_affinity) {
+                    if (shard && shard->waiting > shard->connecting) {
+                        waiter = takeWaiterLocked(shard);
+                    }
+                } else if (m_waiting_requests.load() > m_connecting) {
+                    waiter = popWaiterLocked();
+                }
+                if (waiter) {
+                    waiter->m_error = RedisError(
+                        RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
+                        "Failed to create connection: " +
+                            (error ? error->message() : std::string("unknown error")));
+                }
+            } else {
+                if (attempts > 1) {
                     m_reconnect_successes++;
-                    RedisLogInfo(m_logger, "Reconnect succeeded on attempt {}", attempt + 1);
+                    RedisLogInfo(m_logger, "Reconnect succeeded on attempt {}", attempts);
                 }
 
-                RedisLogDebug(m_logger, "Connection created successfully, total: {}",
-                             m_all_connections.size());
-                return conn;
+                auto conn = std::make_shared<PooledConnection>(std::move(client), scheduler);
+                registerConnectionLocked(conn);
+                m_total_created++;
+                waiter = dispatchLocked(std::move(conn));
+
+                RedisLogDebug(m_logger, "Connection created successfully, total: {}", m_all_connections.size());
+            }
+        }
+        return waiter;
+    }
 
-            } catch (const std::exception& e) {
-                RedisLogError(m_logger, "Failed to create connection (attempt {}): {}",
-                             attempt + 1, e.what());
+    bool RedisConnectionPool::provideForSchedulerLocked(PoolShard& shard, IOScheduler* scheduler,
+                                                        std::shared_ptr<PooledConnection>& retired)
+    {
+        // 在建的连接已足够覆盖该调度器上排队的调用方
+        if (shard.waiting <= shard.connecting) {
+            return false;
+        }
+        if (m_all_connections.size() + m_connecting < m_config.max_connections) {
+            return reserveConnectsLocked(1, scheduler) > 0;
+        }
 
-                if (attempt == m_config.max_reconnect_attempts - 1) {
-                    return std::unexpected(RedisError(
-                        RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
-                        std::string("Failed to create connection after ") +
-                        std::to_string(m_config.max_reconnect_attempts) + " attempts: " + e.what()
-                    ));
+        // 已达上限：从连接更多的调度器借一个空闲连接的名额，关闭它并在本调度器上重建；
+        // 只从多往少迁移，两个调度器之间不会来回搬同一个名额
+        for (size_t i = 0; i < m_shard_count; ++i) {
+            PoolShard& donor_shard = m_shards[i];
+            if (&donor_shard == &shard || donor_shard.bound <= shard.bound + shard.connecting) {
+                continue;
+            }
+            while (auto donor = popShard(donor_shard)) {
+                bool healthy = !donor->isClosed() && donor->isHealthy();
+                if (removeConnectionLocked(donor)) {
+                    m_total_destroyed++;
                 }
+                if (!healthy) {
+                    continue;
+                }
+                retired = std::move(donor);
+                m_total_migrated++;
+                RedisLogDebug(m_logger, "Migrating an idle connection to scheduler {}",
+                              static_cast<const void*>(scheduler));
+                return reserveConnectsLocked(1, scheduler) > 0;
+            }
+        }
+        return false;
+    }
+
+    void RedisConnectionPool::rebalanceLocked(std::vector<std::shared_ptr<PooledConnection>>& retired,
+                                              std::vector<IOScheduler*>& targets)
+    {
+        for (size_t i = 0; i < m_shard_count && m_waiters_head; ++i) {
+            PoolShard& shard = m_shards[i];
+            IOScheduler* owner = shard.owner.load(std::memory_order_acquire);
+            if (owner == nullptr) {
+                continue;
+            }
+            std::shared_ptr<PooledConnection> donor;
+            if (provideForSchedulerLocked(shard, owner, donor)) {
+                targets.push_back(owner);
+            }
+            if (donor) {
+                retired.push_back(std::move(donor));
             }
         }
+    }
+
+    void RedisConnectionPool::retireConnection(std::shared_ptr<PooledConnection> conn)
+    {
+        if (conn) {
+            // 在连接所属的调度器上关闭，不跨线程触碰它的 socket
+            conn->scheduler()->spawn(closeTask(std::move(conn)));
+        }
+    }
 
-        return std::unexpected(RedisError(
-            RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
-            "Failed to create connection"
-        ));
+    Coroutine RedisConnectionPool::closeTask(std::shared_ptr<PooledConnection> conn)
+    {
+        co_await conn->get()->close();
+    }
+
+    Coroutine RedisConnectionPool::probeTask(std::shared_ptr<PoolAnchor> anchor,
+                                             std::shared_ptr<PooledConnection> conn,
+                                             std::chrono::milliseconds timeout)
+    {
+        // 探测期间连接不在可用队列中，不会同时被调用方使用
+        auto result = co_await conn->get()->ping().timeout(timeout);
+        bool healthy = result && result->has_value() && !result->value().empty() &&
+                       result->value()[0].isStatus();
+        if (!healthy) {
+            conn->setHealthy(false);
+            // 超时作用在 PING 的内核 IO 上，返回时 IO 已被取消，内核不再引用客户端；
+            // 关闭 socket 后连接被移出连接池，最后一个引用释放时客户端随之析构
+            co_await conn->get()->close();
+        }
+
+        PoolAcquireAwaitable* woken = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(anchor->mutex);
+            if (anchor->pool) {
+                woken = anchor->pool->onProbeFinished(conn, healthy);
+            }
+        }
+        if (woken) {
+            wakeWaiter(woken);
+        }
+    }
+
+    PoolAcquireAwaitable* RedisConnectionPool::onProbeFinished(const std::shared_ptr<PooledConnection>& conn,
+                                                               bool healthy)
+    {
+        PoolAcquireAwaitable* waiter = nullptr;
+        bool reconnect = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!healthy) {
+                m_health_check_failures++;
+                if (removeConnectionLocked(conn)) {
+                    m_total_destroyed++;
+                    reconnect = m_config.enable_auto_reconnect && !m_is_shutting_down;
+                }
+                RedisLogWarn(m_logger, "Health check PING failed, {}",
+                             reconnect ? "reconnecting in background" : "connection removed");
+            } else if (conn->m_index < m_all_connections.size() && m_all_connections[conn->m_index] == conn) {
+                // 探测期间未被移除：交给排队的调用方或放回可用连接
+                waiter = dispatchLocked(conn);
+            }
+        }
+        if (reconnect) {
+            startConnect(1, m_affinity ? conn->scheduler() : nullptr);
+        }
+        return waiter;
     }
 
     bool RedisConnectionPool::checkConnectionHealthSync(std::shared_ptr<PooledConnection> conn)
@@ -326,75 +1079,104 @@ namespace galay::redis
             return false;
         }
 
-        // TODO: 实现同步健康检查
-        // 在实际使用中，需要在协程上下文中调用 co_await conn->get()->ping()
-
+        // 不在这里发请求：已知失效的连接直接剔除，其余由 probeTask 在后台 PING
         return conn->isHealthy();
     }
 
     void RedisConnectionPool::triggerHealthCheck()
     {
-        if (!m_config.enable_health_check) {
+        if (!m_config.enable_health_check || m_is_shutting_down) {
             return;
         }
 
-        RedisLogInfo(m_logger, "Running health check on {} connections", m_all_connections.size());
-
         std::vector<std::shared_ptr<PooledConnection>> unhealthy_connections;
+        std::vector<std::shared_ptr<PooledConnection>> probes;
+        std::vector<PoolAcquireAwaitable*> woken;
 
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            drainShardsLocked();
+            RedisLogInfo(m_logger, "Running health check on {} idle of {} connections",
+                         m_available_connections.size(), m_all_connections.size());
 
-            for (auto& conn : m_all_connections) {
-                if (!checkConnectionHealthSync(conn)) {
-                    unhealthy_connections.push_back(conn);
-                }
-            }
-
-            if (!unhealthy_connections.empty()) {
-                // 从可用连接中移除
+            // 只检查空闲连接：借出的连接正被所属调度器使用，归还时由 release 检查
+            {
                 std::queue<std::shared_ptr<PooledConnection>> temp_queue;
                 while (!m_available_connections.empty()) {
-                    auto c = m_available_connections.front();
+                    auto c = std::move(m_available_connections.front());
                     m_available_connections.pop();
-                    if (c->isHealthy()) {
-                        temp_queue.push(c);
+                    if (checkConnectionHealthSync(c)) {
+                        temp_queue.push(std::move(c));
+                    } else {
+                        unhealthy_connections.push_back(std::move(c));
                     }
                 }
                 m_available_connections = std::move(temp_queue);
+            }
 
+            if (!unhealthy_connections.empty()) {
                 // 从所有连接中移除
-                m_all_connections.erase(
-                    std::remove_if(m_all_connections.begin(), m_all_connections.end(),
-                        [](const auto& conn) { return !conn->isHealthy(); }),
-                    m_all_connections.end()
-                );
+                for (auto& conn : unhealthy_connections) {
+                    removeConnectionLocked(conn);
+                }
 
                 m_total_destroyed += unhealthy_connections.size();
 
                 RedisLogWarn(m_logger, "Removed {} unhealthy connections, remaining: {}",
                             unhealthy_connections.size(), m_all_connections.size());
             }
-        }
 
-        // 如果连接数低于最小值，创建新连接
-        size_t current_size = m_all_connections.size();
-        while (current_size < m_config.min_connections) {
-            auto result = getConnectionSync();
-            if (!result) {
-                RedisLogError(m_logger, "Failed to create replacement connection: {}",
-                             result.error().message());
-                break;
+            // 只探测一个周期内没被用过的空闲连接（刚用过的已证明可用）；
+            // 有调用方排队时跳过本轮，不和 acquire 抢连接
+            if (!m_waiters_head) {
+                std::queue<std::shared_ptr<PooledConnection>> temp_queue;
+                while (!m_available_connections.empty()) {
+                    auto conn = std::move(m_available_connections.front());
+                    m_available_connections.pop();
+                    if (conn->getIdleTime() >= m_config.health_check_interval) {
+                        probes.push_back(std::move(conn));
+                    } else {
+                        temp_queue.push(std::move(conn));
+                    }
+                }
+                m_available_connections = std::move(temp_queue);
             }
+            refillShardsLocked(woken);
+        }
+        for (auto* waiter : woken) {
+            wakeWaiter(waiter);
+        }
+        // 在各自的调度器上关闭并释放，最后一个引用不落在定时器线程上
+        for (auto& conn : unhealthy_connections) {
+            retireConnection(std::move(conn));
+        }
 
-            // 将新连接加入可用队列
-            {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                m_available_connections.push(result.value());
-                current_size = m_all_connections.size();
-            }
+        // 所有探测并发进行，每个连接在自己的调度器上 PING，结果由 onProbeFinished 处理
+        if (!probes.empty()) {
+            RedisLogDebug(m_logger, "Probing {} idle connections", probes.size());
+        }
+        for (auto& conn : probes) {
+            IOScheduler* scheduler = conn->scheduler();
+            scheduler->spawn(probeTask(m_anchor, std::move(conn), m_config.health_check_timeout));
+        }
 
-            RedisLogInfo(m_logger, "Created replacement connection, total: {}", current_size);
+        // 如果连接数低于最小值，在后台并发创建补充连接，建立后进入可用队列
+        size_t current_size;
+        std::vector<std::pair<IOScheduler*, size_t>> per_scheduler;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // 亲和模式先按调度器补足，再看全局最小值
+            per_scheduler = reservePerSchedulerLocked();
+            current_size = m_all_connections.size() + m_connecting;
+        }
+        for (auto& [scheduler, count] : per_scheduler) {
+            launchConnects(count, scheduler);
+            RedisLogInfo(m_logger, "Creating {} replacement connections for scheduler {} in background",
+                         count, static_cast<const void*>(scheduler));
+        }
+        if (current_size < m_config.min_connections) {
+            auto batch = startConnect(m_config.min_connections - current_size);
+            RedisLogInfo(m_logger, "Creating {} replacement connections in background", batch->requested);
         }
     }
 
@@ -403,70 +1185,78 @@ namespace galay::redis
         RedisLogInfo(m_logger, "Running idle connection cleanup");
 
         std::vector<std::shared_ptr<PooledConnection>> idle_connections;
+        std::vector<PoolAcquireAwaitable*> woken;
+        size_t remaining = 0;
 
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            drainShardsLocked();
 
-            // 检查可用连接中的空闲连接
+            // 检查可用连接中的空闲连接，逐个移除以便按剩余数量判断
             std::queue<std::shared_ptr<PooledConnection>> temp_queue;
             while (!m_available_connections.empty()) {
                 auto conn = m_available_connections.front();
                 m_available_connections.pop();
 
+                // 亲和模式下同时保留每个调度器的最少连接数
+                bool keep_for_scheduler = m_affinity && conn->m_shard &&
+                                          conn->m_shard->bound <= m_config.min_connections_per_scheduler;
                 if (conn->getIdleTime() > m_config.idle_timeout &&
-                    m_all_connections.size() > m_config.min_connections) {
-                    idle_connections.push_back(conn);
+                    m_all_connections.size() > m_config.min_connections && !keep_for_scheduler) {
+                    if (removeConnectionLocked(conn)) {
+                        m_total_destroyed++;
+                    }
+                    idle_connections.push_back(std::move(conn));
                 } else {
-                    temp_queue.push(conn);
+                    temp_queue.push(std::move(conn));
                 }
             }
             m_available_connections = std::move(temp_queue);
+            remaining = m_all_connections.size();
+            refillShardsLocked(woken);
+        }
+        for (auto* waiter : woken) {
+            wakeWaiter(waiter);
         }
 
-        // 移除空闲连接
         if (!idle_connections.empty()) {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            for (auto& conn : idle_connections) {
-                auto it = std::find(m_all_connections.begin(), m_all_connections.end(), conn);
-                if (it != m_all_connections.end()) {
-                    m_all_connections.erase(it);
-                    m_total_destroyed++;
-                }
-            }
-
             RedisLogInfo(m_logger, "Cleaned up {} idle connections, remaining: {}",
-                        idle_connections.size(), m_all_connections.size());
+                        idle_connections.size(), remaining);
+        }
+        for (auto& conn : idle_connections) {
+            retireConnection(std::move(conn));
         }
     }
 
-    void RedisConnectionPool::warmup()
+    PoolConnectAwaitable RedisConnectionPool::warmup()
     {
-        RedisLogInfo(m_logger, "Warming up connection pool to {} connections", m_config.min_connections);
-
         size_t current_size;
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            current_size = m_all_connections.size();
+            current_size = m_all_connections.size() + m_connecting;
         }
 
-        size_t created = 0;
-        while (current_size < m_config.min_connections) {
-            auto result = getConnectionSync();
-            if (!result) {
-                RedisLogError(m_logger, "Failed to create warmup connection: {}", result.error().message());
-                break;
-            }
+        size_t count = current_size < m_config.min_connections ? m_config.min_connections - current_size : 0;
+        RedisLogInfo(m_logger, "Warming up connection pool to {} connections, creating {}",
+                     m_config.min_connections, count);
+        return PoolConnectAwaitable(*this, count);
+    }
 
-            // 将新连接加入可用队列
-            {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                m_available_connections.push(result.value());
-                current_size = m_all_connections.size();
+    PoolConnectAwaitable RedisConnectionPool::warmup(IOScheduler* scheduler)
+    {
+        size_t count = 0;
+        if (m_affinity) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (PoolShard* shard = shardFor(scheduler)) {
+                size_t have = shard->bound + shard->connecting;
+                if (have < m_config.min_connections_per_scheduler) {
+                    count = m_config.min_connections_per_scheduler - have;
+                }
             }
-            created++;
         }
-
-        RedisLogInfo(m_logger, "Warmup complete, created {} connections, total: {}", created, current_size);
+        RedisLogInfo(m_logger, "Warming up scheduler {} to {} connections, creating {}",
+                     static_cast<const void*>(scheduler), m_config.min_connections_per_scheduler, count);
+        return PoolConnectAwaitable(*this, count, scheduler);
     }
 
     size_t RedisConnectionPool::cleanupUnhealthyConnections()
@@ -474,38 +1264,34 @@ namespace galay::redis
         RedisLogInfo(m_logger, "Cleaning up unhealthy connections");
 
         std::vector<std::shared_ptr<PooledConnection>> unhealthy_connections;
+        std::vector<PoolAcquireAwaitable*> woken;
 
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            drainShardsLocked();
 
-            // 找出所有不健康的连接
-            for (auto& conn : m_all_connections) {
-                if (conn->isClosed() || !conn->isHealthy()) {
-                    unhealthy_connections.push_back(conn);
+            // 只处理空闲连接：借出的连接正被所属调度器使用，不能在这里关闭，归还时由 release 检查并移除
+            std::queue<std::shared_ptr<PooledConnection>> temp_queue;
+            while (!m_available_connections.empty()) {
+                auto c = std::move(m_available_connections.front());
+                m_available_connections.pop();
+                if (!c->isClosed() && c->isHealthy()) {
+                    temp_queue.push(std::move(c));
+                } else {
+                    unhealthy_connections.push_back(std::move(c));
                 }
             }
+            m_available_connections = std::move(temp_queue);
 
-            if (!unhealthy_connections.empty()) {
-                // 从可用连接中移除
-                std::queue<std::shared_ptr<PooledConnection>> temp_queue;
-                while (!m_available_connections.empty()) {
-                    auto c = m_available_connections.front();
-                    m_available_connections.pop();
-                    if (!c->isClosed() && c->isHealthy()) {
-                        temp_queue.push(c);
-                    }
-                }
-                m_available_connections = std::move(temp_queue);
-
-                // 从所有连接中移除
-                m_all_connections.erase(
-                    std::remove_if(m_all_connections.begin(), m_all_connections.end(),
-                        [](const auto& conn) { return conn->isClosed() || !conn->isHealthy(); }),
-                    m_all_connections.end()
-                );
-
-                m_total_destroyed += unhealthy_connections.size();
+            // 从所有连接中移除
+            for (auto& conn : unhealthy_connections) {
+                removeConnectionLocked(conn);
             }
+            m_total_destroyed += unhealthy_connections.size();
+            refillShardsLocked(woken);
+        }
+        for (auto* waiter : woken) {
+            wakeWaiter(waiter);
         }
 
         size_t removed = unhealthy_connections.size();
@@ -513,50 +1299,17 @@ namespace galay::redis
             RedisLogInfo(m_logger, "Cleaned up {} unhealthy connections, remaining: {}",
                         removed, m_all_connections.size());
         }
+        for (auto& conn : unhealthy_connections) {
+            retireConnection(std::move(conn));
+        }
 
         return removed;
     }
 
-    size_t RedisConnectionPool::expandPool(size_t count)
+    PoolConnectAwaitable RedisConnectionPool::expandPool(size_t count)
     {
-        if (count == 0) {
-            return 0;
-        }
-
         RedisLogInfo(m_logger, "Expanding pool by {} connections", count);
-
-        size_t created = 0;
-        for (size_t i = 0; i < count; ++i) {
-            size_t current_size;
-            {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                current_size = m_all_connections.size();
-            }
-
-            // 检查是否超过最大连接数
-            if (current_size >= m_config.max_connections) {
-                RedisLogWarn(m_logger, "Cannot expand pool: reached max connections ({})", m_config.max_connections);
-                break;
-            }
-
-            auto result = getConnectionSync();
-            if (!result) {
-                RedisLogError(m_logger, "Failed to create connection during expansion: {}",
-                             result.error().message());
-                break;
-            }
-
-            // 将新连接加入可用队列
-            {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                m_available_connections.push(result.value());
-            }
-            created++;
-        }
-
-        RedisLogInfo(m_logger, "Pool expansion complete, created {} connections, total: {}",
-                     created, m_all_connections.size());
-        return created;
+        return PoolConnectAwaitable(*this, count);
     }
 
     size_t RedisConnectionPool::shrinkPool(size_t target_size)
@@ -564,9 +1317,11 @@ namespace galay::redis
         RedisLogInfo(m_logger, "Shrinking pool to {} connections", target_size);
 
         std::vector<std::shared_ptr<PooledConnection>> connections_to_remove;
+        std::vector<PoolAcquireAwaitable*> woken;
 
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            drainShardsLocked();
 
             // 确保不低于最小连接数
             if (target_size < m_config.min_connections) {
@@ -574,44 +1329,49 @@ namespace galay::redis
                 RedisLogWarn(m_logger, "Target size adjusted to min_connections: {}", target_size);
             }
 
-            // 如果当前连接数已经小于等于目标，不需要缩容
             if (m_all_connections.size() <= target_size) {
+                // 如果当前连接数已经小于等于目标，不需要缩容
                 RedisLogInfo(m_logger, "Current size ({}) <= target size ({}), no shrink needed",
                             m_all_connections.size(), target_size);
-                return 0;
-            }
-
-            // 从可用连接中移除多余的连接
-            size_t to_remove = m_all_connections.size() - target_size;
-            std::queue<std::shared_ptr<PooledConnection>> temp_queue;
+            } else {
+                // 从可用连接中移除多余的连接
+                size_t to_remove = m_all_connections.size() - target_size;
+                std::queue<std::shared_ptr<PooledConnection>> temp_queue;
 
-            while (!m_available_connections.empty() && connections_to_remove.size() < to_remove) {
-                auto conn = m_available_connections.front();
-                m_available_connections.pop();
-                connections_to_remove.push_back(conn);
-            }
+                while (!m_available_connections.empty() && connections_to_remove.size() < to_remove) {
+                    auto conn = m_available_connections.front();
+                    m_available_connections.pop();
+                    connections_to_remove.push_back(conn);
+                }
 
-            // 将剩余的连接放回队列
-            while (!m_available_connections.empty()) {
-                temp_queue.push(m_available_connections.front());
-                m_available_connections.pop();
-            }
-            m_available_connections = std::move(temp_queue);
+                // 将剩余的连接放回队列
+                while (!m_available_connections.empty()) {
+                    temp_queue.push(m_available_connections.front());
+                    m_available_connections.pop();
+                }
+                m_available_connections = std::move(temp_queue);
 
-            // 从所有连接中移除
-            for (auto& conn : connections_to_remove) {
-                auto it = std::find(m_all_connections.begin(), m_all_connections.end(), conn);
-                if (it != m_all_connections.end()) {
-                    m_all_connections.erase(it);
+                // 从所有连接中移除
+                for (auto& conn : connections_to_remove) {
+                    removeConnectionLocked(conn);
                 }
-            }
 
-            m_total_destroyed += connections_to_remove.size();
+                m_total_destroyed += connections_to_remove.size();
+            }
+            refillShardsLocked(woken);
+        }
+        for (auto* waiter : woken) {
+            wakeWaiter(waiter);
         }
 
         size_t removed = connections_to_remove.size();
-        RedisLogInfo(m_logger, "Pool shrink complete, removed {} connections, remaining: {}",
-                     removed, m_all_connections.size());
+        if (removed > 0) {
+            RedisLogInfo(m_logger, "Pool shrink complete, removed {} connections, remaining: {}",
+                         removed, m_all_connections.size());
+        }
+        for (auto& conn : connections_to_remove) {
+            retireConnection(std::move(conn));
+        }
         return removed;
     }
 
@@ -624,17 +1384,36 @@ namespace galay::redis
         m_is_shutting_down = true;
         RedisLogInfo(m_logger, "Shutting down connection pool");
 
+        // 仍在握手的连接建立后直接丢弃
+        detachAnchor();
+
         std::vector<std::shared_ptr<PooledConnection>> all_connections;
+        std::vector<PoolAcquireAwaitable*> waiters;
 
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            drainShardsLocked();
             all_connections = m_all_connections;
-            m_all_connections.clear();
+            for (auto& conn : all_connections) {
+                removeConnectionLocked(conn);
+            }
 
             // 清空可用连接队列
             while (!m_available_connections.empty()) {
                 m_available_connections.pop();
             }
+
+            // 排队的调用方全部以错误结束
+            while (auto* waiter = popWaiterLocked()) {
+                waiter->m_error = RedisError(RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
+                                             "Connection pool is shutting down");
+                waiters.push_back(waiter);
+            }
+        }
+
+        stopTimer();
+        for (auto* waiter : waiters) {
+            wakeWaiter(waiter);
         }
 
         m_is_initialized = false;
@@ -649,8 +1428,12 @@ namespace galay::redis
         PoolStats stats;
         stats.total_connections = m_all_connections.size();
         stats.available_connections = m_available_connections.size();
+        for (size_t i = 0; i < m_shard_count; ++i) {
+            stats.available_connections += m_shards[i].size.load();
+        }
         stats.active_connections = stats.total_connections - stats.available_connections;
         stats.waiting_requests = m_waiting_requests.load();
+        stats.pending_connections = m_connecting;
         stats.total_acquired = m_total_acquired.load();
         stats.total_released = m_total_released.load();
         stats.total_created = m_total_created.load();
@@ -659,6 +1442,7 @@ namespace galay::redis
         stats.reconnect_attempts = m_reconnect_attempts.load();
         stats.reconnect_successes = m_reconnect_successes.load();
         stats.validation_failures = m_validation_failures.load();
+        stats.total_migrated = m_total_migrated.load();
 
         // 性能监控指标
         stats.total_acquire_time_ms = m_total_acquire_time_ms.load();
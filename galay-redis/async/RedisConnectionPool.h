@@ -11,6 +11,9 @@
 #include <atomic>
 #include <chrono>
 #include <coroutine>
+#include <cstdint>
+#include <optional>
+#include <thread>
 
 namespace galay::redis
 {
@@ -34,13 +37,14 @@ namespace galay::redis
         size_t initial_connections = 2;  // 初始连接数
 
         // 超时配置
-        std::chrono::milliseconds acquire_timeout = std::chrono::seconds(5);  // 获取连接超时
+        std::chrono::milliseconds acquire_timeout = std::chrono::seconds(5);  // 获取连接时排队等待的上限，0 表示不等待
         std::chrono::milliseconds idle_timeout = std::chrono::minutes(5);     // 空闲连接超时
         std::chrono::milliseconds connect_timeout = std::chrono::seconds(3);  // 连接超时
 
-        // 健康检查
+        // 健康检查：每隔 health_check_interval 在后台并发 PING 空闲超过该间隔的连接
         bool enable_health_check = true;
         std::chrono::milliseconds health_check_interval = std::chrono::seconds(30);
+        std::chrono::milliseconds health_check_timeout = std::chrono::seconds(1);  // 单次 PING 的超时，超时即判定失败
 
         // 重连配置
         bool enable_auto_reconnect = true;
@@ -51,13 +55,25 @@ namespace galay::redis
         bool validate_on_acquire = false;          // 每次获取时都验证（性能开销较大）
         bool validate_on_return = false;           // 归还时验证
 
+        // 分片配置
+        // >0 时按调度器分片：每个 IOScheduler 一个无锁空闲栈，acquire / release 不加锁；
+        // 本分片为空时从其他分片窃取，再回落到全局队列。调用方需通过 acquire(scheduler) 传入所在调度器
+        size_t shard_count = 0;
+
+        // 调度器亲和（需 shard_count > 0 且不少于调度器数量）
+        // 连接在获取方的调度器上创建并始终只交给该调度器上的协程，所有 IO 留在同一线程；
+        // 某个调度器缺连接且已达 max_connections 时，把其他调度器的一个空闲连接迁移过来（关闭后在本调度器重建）
+        bool scheduler_affinity = false;
+        size_t min_connections_per_scheduler = 0;  // 亲和模式下每个调度器保持的最少连接数
+
         // 验证配置
         bool validate() const
         {
             return min_connections <= max_connections &&
                    initial_connections >= min_connections &&
                    initial_connections <= max_connections &&
-                   max_connections > 0;
+                   max_connections > 0 &&
+                   (!scheduler_affinity || shard_count > 0);
         }
 
         // 创建默认配置
@@ -80,6 +96,24 @@ namespace galay::redis
         }
     };
 
+    /**
+     * @brief 分片模式下一个调度器的空闲连接栈
+     * @details Treiber 栈，元素是连接槽位下标；head 低 32 位为栈顶下标，高 32 位为版本号，避免 ABA
+     */
+    struct PoolShard
+    {
+        static constexpr uint32_t kEmpty = UINT32_MAX;
+
+        std::atomic<IOScheduler*> owner{nullptr};   // 首次使用时认领
+        std::atomic<uint64_t> head{kEmpty};
+        std::atomic<size_t> size{0};
+
+        // 调度器亲和模式的计数，受连接池 m_mutex 保护
+        size_t bound = 0;                           // 绑定到该调度器的连接（含已借出）
+        size_t connecting = 0;                      // 正在为该调度器握手的连接
+        size_t waiting = 0;                         // 该调度器上排队的调用方
+    };
+
     /**
      * @brief 连接包装器，用于管理连接的生命周期
      */
@@ -117,24 +151,74 @@ namespace galay::redis
         }
 
         // 健康状态
-        bool isHealthy() const { return m_is_healthy; }
-        void setHealthy(bool healthy) { m_is_healthy = healthy; }
+        bool isHealthy() const { return m_is_healthy.load(std::memory_order_relaxed); }
+        void setHealthy(bool healthy) { m_is_healthy.store(healthy, std::memory_order_relaxed); }
 
         // 检查是否已关闭
         bool isClosed() const { return m_client->isClosed(); }
 
+        // 连接所属的调度器，其 IO 都在该调度器线程上完成
+        IOScheduler* scheduler() const { return m_scheduler; }
+
     private:
+        friend class RedisConnectionPool;
+        friend class PoolAcquireAwaitable;
+
         std::shared_ptr<RedisClient> m_client;
         IOScheduler* m_scheduler;
         std::chrono::steady_clock::time_point m_last_used;
-        bool m_is_healthy;
+        std::atomic<bool> m_is_healthy;                     // 后台探测与维护线程都会读写
+
+        // 连接池登记信息：按下标定位，不做线性查找
+        size_t m_index = 0;                                 // 在 m_all_connections 中的位置，受 m_mutex 保护
+        std::atomic<uint32_t> m_slot{PoolShard::kEmpty};    // 分片模式的槽位，未登记时为 kEmpty
+        PoolShard* m_shard = nullptr;                       // 归还时放回的分片：最近一次获取所在的分片，亲和模式下为所属调度器的分片
     };
 
     // 前向声明
     class RedisConnectionPool;
 
+    /**
+     * @brief 一批并发建立的连接
+     * @details 每个连接由独立的协程完成 connect、AUTH、SELECT，全部结束后恢复等待方
+     */
+    struct PoolConnectBatch
+    {
+        std::mutex mutex;
+        size_t requested = 0;                                       // 实际发起的连接数
+        size_t pending = 0;                                         // 尚未结束的连接协程
+        size_t connected = 0;                                       // 成功建立的连接数
+        std::optional<RedisError> last_error;
+        std::coroutine_handle<> waiter;
+    };
+
+    /**
+     * @brief 建立连接的等待体（expandPool / warmup）
+     * @details 所有连接并发握手，总耗时约为一次握手，而不是 N 次；不超过 max_connections
+     */
+    class PoolConnectAwaitable
+    {
+    public:
+        PoolConnectAwaitable(RedisConnectionPool& pool, size_t count, IOScheduler* scheduler = nullptr);
+
+        bool await_ready() const noexcept { return m_count == 0; }
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        /**
+         * @return 成功建立的连接数；发起了连接却一个都没建立时返回最后一次的错误
+         */
+        std::expected<size_t, RedisError> await_resume();
+
+    private:
+        RedisConnectionPool& m_pool;
+        size_t m_count;
+        IOScheduler* m_scheduler;                   // 新连接所属的调度器，为空时使用连接池的调度器
+        std::shared_ptr<PoolConnectBatch> m_batch;
+    };
+
     /**
      * @brief 连接池初始化等待体
+     * @details 并发建立 initial_connections 个连接（含 AUTH / SELECT），至少成功 min_connections 个才算初始化成功
      */
     class PoolInitializeAwaitable
     {
@@ -147,25 +231,42 @@ namespace galay::redis
 
     private:
         RedisConnectionPool& m_pool;
-        size_t m_created_count = 0;
+        PoolConnectAwaitable m_connect;
     };
 
     /**
      * @brief 连接池获取连接等待体
+     * @details 有空闲连接时立即返回；否则进入 FIFO 等待队列，由 release() 或新建的连接按先来先得移交，
+     *          在调用方的调度器上恢复。超过 acquire_timeout 仍未拿到连接时由定时器恢复并返回超时错误。
+     *          未达 max_connections 时排队的同时会新建连接。
      */
     class PoolAcquireAwaitable
     {
     public:
-        PoolAcquireAwaitable(RedisConnectionPool& pool);
+        PoolAcquireAwaitable(RedisConnectionPool& pool, IOScheduler* scheduler);
+
+        // 排队期间自身挂在等待队列中，不可拷贝或移动
+        PoolAcquireAwaitable(const PoolAcquireAwaitable&) = delete;
+        PoolAcquireAwaitable& operator=(const PoolAcquireAwaitable&) = delete;
 
         bool await_ready() const noexcept { return false; }
         bool await_suspend(std::coroutine_handle<> handle);
         std::expected<std::shared_ptr<PooledConnection>, RedisError> await_resume();
 
     private:
+        friend class RedisConnectionPool;
+
         RedisConnectionPool& m_pool;
+        IOScheduler* m_scheduler;                   // 排队后在此调度器上恢复
+        PoolShard* m_shard = nullptr;               // 分片模式下调用方调度器对应的分片
         std::shared_ptr<PooledConnection> m_conn;
+        std::optional<RedisError> m_error;          // 排队超时、建连失败或连接池关闭
         std::chrono::steady_clock::time_point m_start_time;
+
+        // 等待队列节点，受连接池 m_mutex 保护
+        std::chrono::steady_clock::time_point m_deadline;
+        std::coroutine_handle<> m_handle;
+        PoolAcquireAwaitable* m_next = nullptr;
     };
 
     /**
@@ -198,18 +299,21 @@ namespace galay::redis
 
         /**
          * @brief 获取连接（协程安全）
-         * @return 连接获取等待体
+         * @param scheduler 调用方所在的调度器，排队后在其上恢复；为空时使用连接池的调度器
+         * @return 连接获取等待体，每次调用各自一个；没有空闲连接时最多排队 acquire_timeout
          */
-        PoolAcquireAwaitable& acquire();
+        PoolAcquireAwaitable acquire(IOScheduler* scheduler = nullptr);
 
         /**
          * @brief 归还连接
-         * @param conn 要归还的连接
+         * @param conn 要归还的连接，有排队的调用方时直接交给最早的一个
          */
         void release(std::shared_ptr<PooledConnection> conn);
 
         /**
-         * @brief 手动触发健康检查
+         * @brief 手动触发健康检查（启用后也由后台定时器每隔 health_check_interval 触发）
+         * @details 不等待探测结果：空闲超过 health_check_interval 的连接移出可用队列，
+         *          在各自的调度器上并发 PING；成功的放回，失败的标记为不健康、移除并在后台重连
          */
         void triggerHealthCheck();
 
@@ -219,21 +323,29 @@ namespace galay::redis
         void triggerIdleCleanup();
 
         /**
-         * @brief 预热连接池（创建到最小连接数）
+         * @brief 预热连接池（并发创建到最小连接数）
+         * @return 建立连接的等待体，结果为新建的连接数
          */
-        void warmup();
+        PoolConnectAwaitable warmup();
 
         /**
-         * @brief 清理所有不健康的连接
+         * @brief 预热指定调度器（亲和模式：在该调度器上创建到 min_connections_per_scheduler）
+         * @return 建立连接的等待体，结果为新建的连接数
+         */
+        PoolConnectAwaitable warmup(IOScheduler* scheduler);
+
+        /**
+         * @brief 清理空闲的不健康连接
+         * @details 移除的连接在各自的调度器上关闭；借出中的连接不在这里处理，归还时由 release 检查并移除
          */
         size_t cleanupUnhealthyConnections();
 
         /**
-         * @brief 扩容连接池（创建指定数量的连接）
-         * @param count 要创建的连接数
-         * @return 实际创建的连接数
+         * @brief 扩容连接池（并发创建指定数量的连接）
+         * @param count 要创建的连接数，超出 max_connections 的部分忽略
+         * @return 建立连接的等待体，结果为实际创建的连接数
          */
-        size_t expandPool(size_t count);
+        PoolConnectAwaitable expandPool(size_t count);
 
         /**
          * @brief 缩容连接池（移除空闲连接到目标数量）
@@ -256,6 +368,7 @@ namespace galay::redis
             size_t available_connections;  // 可用连接数
             size_t active_connections;     // 活跃连接数
             size_t waiting_requests;       // 等待中的请求数
+            size_t pending_connections;    // 正在握手的连接数
             uint64_t total_acquired;       // 总获取次数
             uint64_t total_released;       // 总归还次数
             uint64_t total_created;        // 总创建次数
@@ -264,6 +377,7 @@ namespace galay::redis
             uint64_t reconnect_attempts;   // 重连尝试次数
             uint64_t reconnect_successes;  // 重连成功次数
             uint64_t validation_failures;  // 验证失败次数
+            uint64_t total_migrated;       // 亲和模式下迁移到其他调度器的连接数
 
             // 性能监控指标
             double avg_acquire_time_ms;    // 平均获取连接时间（毫秒）
@@ -284,14 +398,164 @@ namespace galay::redis
     private:
         friend class PoolInitializeAwaitable;
         friend class PoolAcquireAwaitable;
+        friend class PoolConnectAwaitable;
+
+        /**
+         * @brief 连接协程与连接池之间的纽带
+         * @details 连接池关闭或析构时置空 pool，仍在握手的协程结束后不再回写连接池
+         */
+        struct PoolAnchor
+        {
+            std::mutex mutex;
+            RedisConnectionPool* pool = nullptr;
+        };
+
+        /**
+         * @brief 并发发起 count 个连接，不超过 max_connections（含正在握手的连接）
+         * @details 建立的连接交给排队的调用方，没有排队时放入可用队列
+         */
+        std::shared_ptr<PoolConnectBatch> startConnect(size_t count, IOScheduler* scheduler = nullptr);
+
+        /**
+         * @brief 预留握手名额（持有 m_mutex 时调用），返回实际可发起的数量
+         */
+        size_t reserveConnectsLocked(size_t count, IOScheduler* scheduler);
+
+        /**
+         * @brief 为已预留的名额启动握手协程（不持有 m_mutex 时调用），连接协程运行在所属调度器上
+         */
+        std::shared_ptr<PoolConnectBatch> launchConnects(size_t count, IOScheduler* scheduler);
+
+        /**
+         * @brief 亲和模式：调度器上排队的调用方多于正在握手的连接时补一个连接（持有 m_mutex 时调用）
+         * @details 未达上限时直接预留；已达上限时从连接更多的调度器取一个空闲连接迁移（移除后由调用方关闭）
+         * @return 是否预留了一个握手名额
+         */
+        bool provideForSchedulerLocked(PoolShard& shard, IOScheduler* scheduler,
+                                       std::shared_ptr<PooledConnection>& retired);
 
         /**
-         * @brief 获取或创建连接（内部方法，同步）
+         * @brief 亲和模式：归还连接后为仍有调用方缺连接的调度器补连接或迁移（持有 m_mutex 时调用）
+         * @details 没有绑定连接的调度器只能靠迁移获得连接，否则要等到超时
          */
-        std::expected<std::shared_ptr<PooledConnection>, RedisError> getConnectionSync();
+        void rebalanceLocked(std::vector<std::shared_ptr<PooledConnection>>& retired,
+                             std::vector<IOScheduler*>& targets);
 
         /**
-         * @brief 检查连接健康状态（同步）
+         * @brief 在连接所属调度器上关闭连接
+         */
+        static void retireConnection(std::shared_ptr<PooledConnection> conn);
+        static Coroutine closeTask(std::shared_ptr<PooledConnection> conn);
+
+        /**
+         * @brief 单个连接的握手协程：connect + AUTH + SELECT，受 connect_timeout 限制，失败时按 max_reconnect_attempts 重试
+         */
+        static Coroutine connectTask(std::shared_ptr<PoolAnchor> anchor,
+                                     std::shared_ptr<PoolConnectBatch> batch,
+                                     IOScheduler* scheduler,
+                                     ConnectionPoolConfig config);
+
+        /**
+         * @brief 握手结束（持有 anchor 锁时调用），登记连接与统计
+         * @details 成功时连接交给最早排队的调用方或放入可用队列；
+         *          失败且排队的调用方多于正在握手的连接时，最早的调用方以该错误结束
+         * @return 需要唤醒的调用方（由连接协程在释放 anchor 锁后唤醒），没有时为空
+         */
+        PoolAcquireAwaitable* onConnectFinished(IOScheduler* scheduler, std::shared_ptr<RedisClient> client,
+                                                int attempts, const std::optional<RedisError>& error);
+
+        /**
+         * @brief 单个连接的健康探测协程：PING 受 health_check_timeout 限制，运行在连接所属的调度器上
+         */
+        static Coroutine probeTask(std::shared_ptr<PoolAnchor> anchor,
+                                   std::shared_ptr<PooledConnection> conn,
+                                   std::chrono::milliseconds timeout);
+
+        /**
+         * @brief 探测结束（持有 anchor 锁时调用）：健康的连接重新分发，失败的移除并在后台补建
+         * @return 需要唤醒的调用方，没有时为空
+         */
+        PoolAcquireAwaitable* onProbeFinished(const std::shared_ptr<PooledConnection>& conn, bool healthy);
+
+        /**
+         * @brief 空闲连接交给最早排队的调用方，没有排队时放入可用队列（持有 m_mutex 时调用）
+         * @return 需要唤醒的调用方，没有时为空
+         */
+        PoolAcquireAwaitable* dispatchLocked(std::shared_ptr<PooledConnection> conn);
+
+        // 等待队列（持有 m_mutex 时调用）
+        void pushWaiterLocked(PoolAcquireAwaitable* waiter);
+        PoolAcquireAwaitable* popWaiterLocked();
+        void unlinkWaiterLocked(PoolAcquireAwaitable* waiter, PoolAcquireAwaitable* prev);
+
+        /**
+         * @brief 取最早排队的调用方；亲和模式下只取该分片（调度器）上的调用方
+         */
+        PoolAcquireAwaitable* takeWaiterLocked(PoolShard* shard);
+
+        /**
+         * @brief 在调用方的调度器上恢复（不持有 m_mutex 时调用，之后不能再访问 waiter）
+         */
+        static void wakeWaiter(PoolAcquireAwaitable* waiter);
+        static Coroutine resumeTask(std::coroutine_handle<> handle);
+
+        /**
+         * @brief 定时器线程：按队首的截止时间等待，到期的调用方以超时错误恢复；到点时触发后台健康检查
+         * @details acquire_timeout 对所有调用方相同，FIFO 顺序即截止时间顺序，只需检查队首
+         */
+        void timerLoop();
+        void stopTimer();
+
+        /**
+         * @brief 初始化成功后启动周期健康检查（enable_health_check 且 health_check_interval > 0）
+         */
+        void startHealthCheck();
+
+        // 登记 / 移除连接（持有 m_mutex 时调用），O(1)
+        void registerConnectionLocked(const std::shared_ptr<PooledConnection>& conn);
+        bool removeConnectionLocked(const std::shared_ptr<PooledConnection>& conn);
+
+        // 分片：查找调度器的分片，无锁出入栈
+        // 亲和模式下分片不够时返回空；claimed 为真表示本次调用认领了新分片
+        PoolShard* shardFor(IOScheduler* scheduler, bool* claimed = nullptr);
+        void pushShard(PoolShard& shard, uint32_t slot);
+        std::shared_ptr<PooledConnection> popShard(PoolShard& shard);
+
+        /**
+         * @brief 先取本分片，再依次从其他分片窃取
+         */
+        std::shared_ptr<PooledConnection> popAnyShard(PoolShard* preferred);
+
+        /**
+         * @brief 把各分片中的空闲连接移回全局队列（持有 m_mutex 时调用），供维护操作统一处理
+         */
+        void drainShardsLocked();
+
+        /**
+         * @brief 维护操作结束后重新分发被收回全局队列的空闲连接（持有 m_mutex 时调用）
+         * @details 先交给排队的调用方，亲和模式下其余放回所属调度器的分片；需要唤醒的调用方放入 woken
+         */
+        void refillShardsLocked(std::vector<PoolAcquireAwaitable*>& woken);
+
+        /**
+         * @brief 亲和模式：为已登记的调度器补足 min_connections_per_scheduler 的名额（持有 m_mutex 时调用）
+         */
+        std::vector<std::pair<IOScheduler*, size_t>> reservePerSchedulerLocked();
+
+        /**
+         * @brief 分片中的空闲连接交给排队的调用方（持有 m_mutex 时调用），补上入栈与入队交错时漏掉的唤醒
+         * @param self 正在入队的调用方，轮到它时不唤醒而是通过 self_served 告知
+         */
+        void serveWaitersFromShardsLocked(std::vector<PoolAcquireAwaitable*>& woken,
+                                          PoolAcquireAwaitable* self, bool& self_served);
+
+        /**
+         * @brief 断开与仍在握手的连接协程的关联
+         */
+        void detachAnchor();
+
+        /**
+         * @brief 检查连接的本地状态（同步，不发请求）；实际的 PING 探测由 probeTask 完成
          */
         bool checkConnectionHealthSync(std::shared_ptr<PooledConnection> conn);
 
@@ -303,7 +567,26 @@ namespace galay::redis
         std::queue<std::shared_ptr<PooledConnection>> m_available_connections;
         std::vector<std::shared_ptr<PooledConnection>> m_all_connections;
         mutable std::mutex m_mutex;
-        std::condition_variable m_cv;
+        std::condition_variable m_cv;  // 唤醒排队超时定时器
+
+        // 分片模式：槽位持有连接，分片栈只存槽位下标
+        struct PoolSlot
+        {
+            std::shared_ptr<PooledConnection> conn;
+            std::atomic<uint32_t> next{PoolShard::kEmpty};
+        };
+        size_t m_shard_count = 0;
+        bool m_affinity = false;
+        std::unique_ptr<PoolShard[]> m_shards;
+        std::unique_ptr<PoolSlot[]> m_slots;            // max_connections 个
+        std::vector<uint32_t> m_free_slots;             // 受 m_mutex 保护
+
+        // 排队等待连接的调用方（FIFO），受 m_mutex 保护
+        PoolAcquireAwaitable* m_waiters_head = nullptr;
+        PoolAcquireAwaitable* m_waiters_tail = nullptr;
+        std::thread m_timer_thread;
+        bool m_timer_stop = false;
+        std::chrono::steady_clock::time_point m_next_health_check = std::chrono::steady_clock::time_point::max();
 
         // 状态标志
         std::atomic<bool> m_is_initialized{false};
@@ -315,7 +598,8 @@ namespace galay::redis
         std::atomic<uint64_t> m_total_created{0};
         std::atomic<uint64_t> m_total_destroyed{0};
         std::atomic<uint64_t> m_health_check_failures{0};
-        std::atomic<size_t> m_waiting_requests{0};
+        std::atomic<size_t> m_waiting_requests{0};  // 等待队列长度
+        size_t m_connecting = 0;  // 正在握手的连接数，受 m_mutex 保护
         std::atomic<uint64_t> m_reconnect_attempts{0};
         std::atomic<uint64_t> m_reconnect_successes{0};
         std::atomic<uint64_t> m_validation_failures{0};
@@ -324,10 +608,13 @@ namespace galay::redis
         std::atomic<uint64_t> m_total_acquire_time_ms{0};
         std::atomic<double> m_max_acquire_time_ms{0.0};
         std::atomic<size_t> m_peak_active_connections{0};
+        std::atomic<size_t> m_active_connections{0};    // 已借出的连接数
+        std::atomic<uint64_t> m_total_migrated{0};
 
         // awaitable 对象
         std::optional<PoolInitializeAwaitable> m_init_awaitable;
-        std::optional<PoolAcquireAwaitable> m_acquire_awaitable;
+
+        std::shared_ptr<PoolAnchor> m_anchor;
 
         // 日志
         std::shared_ptr<spdlog::logger> m_logger;
@@ -0,0 +1,407 @@
+#include "RedisMultiplexer.h"
+#include "base/RedisLog.h"
+#include <utility>
+
+namespace galay::redis
+{
+    // ======================== RedisMuxAwaitable ========================
+
+    RedisMuxAwaitableBase::RedisMuxAwaitableBase(RedisMultiplexer& mux, std::shared_ptr<RedisMuxRequest> request)
+        : m_mux(&mux)
+        , m_request(std::move(request))
+    {
+    }
+
+    bool RedisMuxAwaitableBase::await_suspend(std::coroutine_handle<> handle)
+    {
+        // 先交给写协程，发送失败会在 flush 中直接给出结果，此时不挂起
+        if (m_mux->config().pipeline_flush_on_yield) {
+            m_mux->flush();
+        }
+        if (m_request->done) {
+            return false;
+        }
+        m_request->waiter = handle;
+        return true;
+    }
+
+    std::expected<RedisValue, RedisError> RedisMuxAwaitable::await_resume()
+    {
+        if (m_request->error.has_value()) {
+            return std::unexpected(std::move(*m_request->error));
+        }
+        return std::move(m_request->value);
+    }
+
+    std::expected<std::vector<RedisValue>, RedisError> RedisMuxPipelineAwaitable::await_resume()
+    {
+        if (m_request->error.has_value()) {
+            return std::unexpected(std::move(*m_request->error));
+        }
+        return std::move(m_request->values);
+    }
+
+    // ======================== RedisMultiplexer ========================
+
+    std::shared_ptr<RedisMultiplexer> RedisMultiplexer::create(IOScheduler* scheduler, AsyncRedisConfig config)
+    {
+        return std::shared_ptr<RedisMultiplexer>(new RedisMultiplexer(scheduler, std::move(config)));
+    }
+
+    RedisMultiplexer::RedisMultiplexer(IOScheduler* scheduler, AsyncRedisConfig config)
+        : m_client(scheduler, std::move(config))
+        , m_scheduler(scheduler)
+        , m_window(RedisAdaptiveWindowConfig{
+              .initial_window = m_client.m_config.adaptive_window_initial,
+              .max_window = m_client.m_config.adaptive_window_max})
+    {
+        if (this->config().adaptive_window) {
+            m_stats.window = m_window.window();
+        }
+    }
+
+    RedisConnectAwaitable& RedisMultiplexer::connect(const std::string& url)
+    {
+        return m_client.connect(url);
+    }
+
+    RedisConnectAwaitable& RedisMultiplexer::connect(const std::string& ip, int32_t port,
+                                                     const std::string& username,
+                                                     const std::string& password)
+    {
+        return m_client.connect(ip, port, username, password);
+    }
+
+    RedisMuxAwaitable RedisMultiplexer::execute(const std::string& cmd, const std::vector<std::string>& args)
+    {
+        if (!m_closed) {
+            size_t before = m_send_buffer.size();
+            protocol::RespEncoder::appendCommand(m_send_buffer, cmd, args);
+            m_command_sizes.push_back(m_send_buffer.size() - before);
+        }
+        return RedisMuxAwaitable(*this, enqueue(1));
+    }
+
+    RedisMuxAwaitable RedisMultiplexer::ping()
+    {
+        return submitCommand<protocol::Command<"PING", 0>>();
+    }
+
+    RedisMuxAwaitable RedisMultiplexer::get(const std::string& key)
+    {
+        return submitCommand<protocol::Command<"GET", 1>>(key);
+    }
+
+    RedisMuxAwaitable RedisMultiplexer::set(const std::string& key, const std::string& value)
+    {
+        return submitCommand<protocol::Command<"SET", 2>>(key, value);
+    }
+
+    RedisMuxAwaitable RedisMultiplexer::del(const std::string& key)
+    {
+        return submitCommand<protocol::Command<"DEL", 1>>(key);
+    }
+
+    RedisMuxAwaitable RedisMultiplexer::incr(const std::string& key)
+    {
+        return submitCommand<protocol::Command<"INCR", 1>>(key);
+    }
+
+    RedisMuxPipelineAwaitable RedisMultiplexer::pipeline(const std::vector<std::vector<std::string>>& commands)
+    {
+        if (!m_closed) {
+            for (const auto& command : commands) {
+                size_t before = m_send_buffer.size();
+                protocol::RespEncoder::appendCommand(m_send_buffer, command);
+                m_command_sizes.push_back(m_send_buffer.size() - before);
+            }
+        }
+        return RedisMuxPipelineAwaitable(*this, enqueue(commands.size()));
+    }
+
+    std::shared_ptr<RedisMuxRequest> RedisMultiplexer::enqueue(size_t replies)
+    {
+        auto request = std::make_shared<RedisMuxRequest>();
+        request->expected_replies = replies;
+        if (m_closed) {
+            request->error = RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED, "Multiplexer closed");
+            request->done = true;
+            return request;
+        }
+        if (replies == 0) {
+            request->done = true;
+            return request;
+        }
+        if (replies > 1) {
+            request->values.reserve(replies);
+        }
+        m_pending.push_back(request);
+        m_queued_commands += replies;
+        m_stats.submitted += replies;
+        m_stats.max_in_flight = std::max(m_stats.max_in_flight, m_command_sizes.size());
+
+        const auto& config = this->config();
+        if (m_send_buffer.size() >= config.pipeline_max_bytes ||
+            m_queued_commands >= config.pipeline_max_commands) {
+            ++m_stats.limit_flushes;
+            flush();
+        }
+        return request;
+    }
+
+    bool RedisMultiplexer::hasDataToSend() const noexcept
+    {
+        return m_sending_offset < m_sending.size() || (m_flush_requested && !m_send_buffer.empty());
+    }
+
+    bool RedisMultiplexer::writerReady() const noexcept
+    {
+        if (m_closed) {
+            return true;
+        }
+        if (!hasDataToSend()) {
+            return false;
+        }
+        if (config().adaptive_window && m_sent_times.size() >= m_window.window()) {
+            return false;
+        }
+        size_t limit = config().pipeline_max_inflight_bytes;
+        if (limit == 0 || unackedBytes() < limit) {
+            return true;
+        }
+        // 最早的未回复命令还没发完时服务端不会回复，必须继续发送
+        return !m_command_sizes.empty() && m_bytes_sent < m_bytes_acked + m_command_sizes.front();
+    }
+
+    size_t RedisMultiplexer::windowSendLimit(size_t length) const noexcept
+    {
+        // 从第一条未发完的命令起，最多发到窗口内最后一条命令的结尾
+        size_t end = m_sent_end;
+        size_t window = m_window.window();
+        for (size_t i = m_sent_times.size();
+             i < window && i < m_command_sizes.size() && end < m_bytes_sent + length; ++i) {
+            end += m_command_sizes[i];
+        }
+        return std::min(length, end - m_bytes_sent);
+    }
+
+    void RedisMultiplexer::recordSentCommands()
+    {
+        auto now = std::chrono::steady_clock::now();
+        while (m_sent_times.size() < m_command_sizes.size()) {
+            size_t end = m_sent_end + m_command_sizes[m_sent_times.size()];
+            if (end > m_bytes_sent) {
+                break;
+            }
+            m_sent_end = end;
+            m_sent_times.push_back(now);
+        }
+    }
+
+    void RedisMultiplexer::wakeWriter()
+    {
+        if (m_writer && writerReady()) {
+            std::exchange(m_writer, {}).resume();
+        }
+    }
+
+    void RedisMultiplexer::flush()
+    {
+        if (m_closed || m_send_buffer.empty()) {
+            return;
+        }
+        m_flush_requested = true;
+        if (!m_started) {
+            m_started = true;
+            m_scheduler->spawn(writeLoop(shared_from_this()));
+            m_scheduler->spawn(readLoop(shared_from_this()));
+            return;
+        }
+        wakeWriter();
+    }
+
+    void RedisMultiplexer::shutdown(const RedisError& error)
+    {
+        if (m_closed) {
+            return;
+        }
+        m_closed = true;
+        m_send_buffer.clear();
+        m_sending.clear();
+        m_sending_offset = 0;
+        m_queued_commands = 0;
+        m_command_sizes.clear();
+        m_sent_times.clear();
+        m_bytes_acked = m_bytes_sent;
+        m_sent_end = m_bytes_sent;
+        auto pending = std::move(m_pending);
+        m_pending.clear();
+        for (auto& request : pending) {
+            request->error = error;
+            complete(*request);
+        }
+        // 让空闲的写协程退出
+        if (m_writer) {
+            std::exchange(m_writer, {}).resume();
+        }
+    }
+
+    void RedisMultiplexer::complete(RedisMuxRequest& request)
+    {
+        request.done = true;
+        if (request.waiter) {
+            std::exchange(request.waiter, {}).resume();
+        }
+    }
+
+    Coroutine RedisMultiplexer::writeLoop(std::shared_ptr<RedisMultiplexer> self)
+    {
+        auto& mux = *self;
+        while (true) {
+            bool adaptive = mux.config().adaptive_window;
+            if (mux.hasDataToSend() && !mux.writerReady()) {
+                if (adaptive && mux.m_sent_times.size() >= mux.m_window.window()) {
+                    ++mux.m_stats.window_waits;
+                } else {
+                    ++mux.m_stats.budget_waits;
+                }
+            }
+            co_await WriterIdle{mux};
+            if (mux.m_closed) {
+                break;
+            }
+            if (mux.m_sending_offset == mux.m_sending.size()) {
+                // 上一批已发完：发送期间新到的命令作为下一批
+                mux.m_sending.clear();
+                mux.m_sending.swap(mux.m_send_buffer);
+                mux.m_sending_offset = 0;
+                mux.m_queued_commands = 0;
+                mux.m_flush_requested = false;
+                ++mux.m_stats.send_batches;
+            }
+
+            // 超大批次按在途字节上限分段，读协程收到回复后再继续
+            size_t length = mux.m_sending.size() - mux.m_sending_offset;
+            size_t limit = mux.config().pipeline_max_inflight_bytes;
+            if (limit != 0 && mux.unackedBytes() < limit) {
+                length = std::min(length, limit - mux.unackedBytes());
+            } else if (limit != 0) {
+                // 超出上限时只把最早的未回复命令发完
+                length = std::min(length, mux.m_bytes_acked + mux.m_command_sizes.front() - mux.m_bytes_sent);
+            }
+            if (adaptive) {
+                length = mux.windowSendLimit(length);
+            }
+            auto result = co_await mux.m_client.m_socket.send(mux.m_sending.data() + mux.m_sending_offset, length);
+            if (!result) {
+                RedisLogDebug(mux.m_client.m_logger, "mux send failed: {}", result.error().message());
+                mux.shutdown(RedisError(RedisErrorType::REDIS_ERROR_TYPE_SEND_ERROR, result.error().message()));
+                co_return;
+            }
+            if (mux.m_closed) {
+                break;
+            }
+            ++mux.m_stats.send_calls;
+            mux.m_sending_offset += result.value();
+            mux.m_bytes_sent += result.value();
+            if (adaptive) {
+                mux.recordSentCommands();
+            }
+            mux.m_stats.max_unacked_bytes = std::max(mux.m_stats.max_unacked_bytes, mux.unackedBytes());
+        }
+    }
+
+    Coroutine RedisMultiplexer::readLoop(std::shared_ptr<RedisMultiplexer> self)
+    {
+        auto& mux = *self;
+        auto& buffer = mux.m_client.m_recv_buffer;
+        std::vector<std::shared_ptr<RedisMuxRequest>> ready;
+        while (!mux.m_closed) {
+            auto region = buffer.getWriteSpan();
+            // 关闭 socket 不会唤醒挂起的 recv：每次接收有时限，到期后内核取消 IO，
+            // 读协程检查 m_closed，close() 之后最多一个周期即退出并释放 shared_ptr
+            auto recv = mux.m_client.m_socket.recv(region.data(), region.size());
+            auto result = co_await recv.timeout(kReaderPollInterval);
+            if (!result && result.error().code() == galay::kernel::kTimeout) {
+                continue;
+            }
+            if (!result) {
+                RedisLogDebug(mux.m_client.m_logger, "mux receive failed: {}", result.error().message());
+                mux.shutdown(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR, result.error().message()));
+                break;
+            }
+            if (result.value() == 0) {
+                RedisLogDebug(mux.m_client.m_logger, "mux connection closed by peer");
+                mux.shutdown(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED, "Connection closed"));
+                break;
+            }
+            if (mux.m_closed) {
+                break;
+            }
+            buffer.produce(result.value());
+            ++mux.m_stats.read_wakeups;
+
+            // 先解析出缓冲区内所有完整回复，再按顺序恢复等待者
+            bool parse_failed = false;
+            bool adaptive = mux.config().adaptive_window;
+            auto now = std::chrono::steady_clock::now();
+            size_t replies = 0;
+            while (!buffer.empty()) {
+                auto parsed = mux.m_client.parseValue(buffer.data(), buffer.readable());
+                if (!parsed) {
+                    parse_failed = parsed.error() != protocol::ParseError::Incomplete;
+                    break;
+                }
+                auto& [consumed, value] = parsed.value();
+                buffer.consume(consumed);
+                if (mux.m_pending.empty()) {
+                    RedisLogDebug(mux.m_client.m_logger, "mux dropped reply without pending request");
+                    continue;
+                }
+                ++replies;
+                if (adaptive) {
+                    if (!mux.m_sent_times.empty()) {
+                        mux.m_window.onReply(now - mux.m_sent_times.front());
+                        mux.m_sent_times.pop_front();
+                    } else {
+                        // 读协程先于写协程看到发送完成，这条命令没有记录发送时刻
+                        mux.m_sent_end += mux.m_command_sizes.front();
+                    }
+                }
+                mux.m_bytes_acked += mux.m_command_sizes.front();
+                mux.m_command_sizes.pop_front();
+
+                auto& request = mux.m_pending.front();
+                if (request->expected_replies == 1) {
+                    request->value = std::move(value);
+                } else {
+                    request->values.push_back(std::move(value));
+                    if (request->values.size() < request->expected_replies) {
+                        continue;
+                    }
+                }
+                ready.push_back(std::move(request));
+                mux.m_pending.pop_front();
+            }
+            mux.m_stats.completed += replies;
+            mux.m_stats.max_replies_per_wakeup = std::max(mux.m_stats.max_replies_per_wakeup, replies);
+            if (adaptive) {
+                mux.m_stats.window = mux.m_window.window();
+            }
+
+            // 回复释放了在途字节额度（和窗口），等待中的写协程可以继续
+            mux.wakeWriter();
+
+            for (auto& request : ready) {
+                complete(*request);
+            }
+            ready.clear();
+
+            if (parse_failed) {
+                RedisLogDebug(mux.m_client.m_logger, "mux parse error");
+                mux.shutdown(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR, "Parse error"));
+                break;
+            }
+        }
+    }
+}
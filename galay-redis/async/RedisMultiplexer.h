@@ -0,0 +1,264 @@
+#ifndef GALAY_REDIS_MULTIPLEXER_H
+#define GALAY_REDIS_MULTIPLEXER_H
+
+#include "RedisClient.h"
+#include <deque>
+
+namespace galay::redis
+{
+    class RedisMultiplexer;
+
+    /**
+     * @brief 多路复用连接上的一条在途命令
+     * @details 由等待体和 RedisMultiplexer 的待回复队列共同持有，
+     *          等待体先于回复销毁时，读协程照常消费回复后丢弃
+     */
+    struct RedisMuxRequest
+    {
+        std::coroutine_handle<> waiter;
+        size_t expected_replies = 1;        // pipeline 请求对应多条回复
+        RedisValue value;                   // 单条命令的回复
+        std::vector<RedisValue> values;     // pipeline 的回复
+        std::optional<RedisError> error;
+        bool done = false;
+    };
+
+    /**
+     * @brief 多路复用统计
+     */
+    struct RedisMuxStats
+    {
+        uint64_t submitted = 0;             // 已提交的命令数
+        uint64_t completed = 0;             // 已收到回复的命令数
+        uint64_t send_batches = 0;          // 写协程发起的发送批次
+        uint64_t send_calls = 0;            // send 调用次数（部分发送时一个批次多次调用）
+        uint64_t limit_flushes = 0;         // 因达到字节数或命令数上限触发的发送
+        uint64_t budget_waits = 0;          // 在途字节数达到上限、写协程等待回复的次数
+        size_t max_unacked_bytes = 0;       // 已发送未收到回复的字节数峰值
+        uint64_t read_wakeups = 0;          // 读协程被唤醒的次数
+        size_t max_in_flight = 0;           // 同时在途命令数的峰值
+        size_t max_replies_per_wakeup = 0;  // 单次唤醒解析出的最多回复数
+        uint64_t window_waits = 0;          // 在途命令数达到自适应窗口、写协程等待回复的次数
+        size_t window = 0;                  // 当前自适应窗口，未开启 adaptive_window 时为0
+    };
+
+    /**
+     * @brief 多路复用等待体的公共部分：登记等待者，回复到齐后恢复一次
+     */
+    class RedisMuxAwaitableBase
+    {
+    public:
+        RedisMuxAwaitableBase(RedisMultiplexer& mux, std::shared_ptr<RedisMuxRequest> request);
+
+        bool await_ready() const noexcept { return m_request->done; }
+        bool await_suspend(std::coroutine_handle<> handle);
+
+    protected:
+        RedisMultiplexer* m_mux;
+        std::shared_ptr<RedisMuxRequest> m_request;
+    };
+
+    /**
+     * @brief 多路复用命令等待体
+     * @details 每次调用各自持有一个等待体，只恢复一次：
+     *          返回 std::expected<RedisValue, RedisError>，错误回复以 isError() 的 RedisValue 返回
+     */
+    class RedisMuxAwaitable : public RedisMuxAwaitableBase
+    {
+    public:
+        using RedisMuxAwaitableBase::RedisMuxAwaitableBase;
+
+        std::expected<RedisValue, RedisError> await_resume();
+    };
+
+    /**
+     * @brief 多路复用 pipeline 等待体
+     * @details 返回 std::expected<std::vector<RedisValue>, RedisError>，回复与命令一一对应
+     */
+    class RedisMuxPipelineAwaitable : public RedisMuxAwaitableBase
+    {
+    public:
+        using RedisMuxAwaitableBase::RedisMuxAwaitableBase;
+
+        std::expected<std::vector<RedisValue>, RedisError> await_resume();
+    };
+
+    /**
+     * @brief 多个协程共享一条连接的 Redis 客户端
+     * @details 命令在调用时直接编码进发送队列，写协程把积累的命令合并成一次发送（自动流水线）；
+     *          读协程按 FIFO 顺序把回复交给对应的等待者，每次唤醒解析完缓冲区内所有完整回复。
+     *          一条连接可以同时承载成千上万条在途命令。
+     *
+     *          发送时机由 AsyncRedisConfig 的 pipeline_* 配置决定：调用方 co_await 挂起时、
+     *          队列达到 pipeline_max_bytes / pipeline_max_commands 时，或显式调用 flush() 时。
+     *          上一批发送期间到达的命令在其完成后作为下一批一起发出。
+     *
+     *          读写协程相互独立（全双工）：回复在发送的同时被读取。已发送未收到回复的字节数
+     *          不超过 pipeline_max_inflight_bytes，超大批次按该上限分段发送，不会因为双方
+     *          缓冲区同时写满而互相阻塞。
+     *
+     *          开启 adaptive_window 后，已发送未收到回复的命令数还受自适应窗口限制：
+     *          读协程按每条命令从发完到收到回复的延迟调节窗口，见 RedisAdaptiveWindow。
+     *
+     * @code
+     * auto mux = RedisMultiplexer::create(scheduler);
+     * co_await mux->connect("redis://127.0.0.1:6379");
+     * // 任意多个协程并发使用同一个 mux
+     * auto value = co_await mux->get("key");
+     * @endcode
+     *
+     * @note 读写协程与调用方必须运行在同一个 IOScheduler 上
+     * @warning 读写协程持有 shared_ptr，不再使用时必须 co_await close()，否则连接不会释放；
+     *          close() 之后读协程最多在 kReaderPollInterval 内退出，对象随最后一个引用析构
+     */
+    class RedisMultiplexer : public std::enable_shared_from_this<RedisMultiplexer>
+    {
+    public:
+        static std::shared_ptr<RedisMultiplexer> create(IOScheduler* scheduler,
+                                                        AsyncRedisConfig config = AsyncRedisConfig::noTimeout());
+
+        // 读写协程持有 this，禁止拷贝和移动
+        RedisMultiplexer(const RedisMultiplexer&) = delete;
+        RedisMultiplexer& operator=(const RedisMultiplexer&) = delete;
+
+        // ======================== 连接方法 ========================
+
+        /**
+         * @brief 连接并完成握手，之后第一条命令启动读写协程
+         */
+        RedisConnectAwaitable& connect(const std::string& url);
+        RedisConnectAwaitable& connect(const std::string& ip, int32_t port,
+                                      const std::string& username = "",
+                                      const std::string& password = "");
+
+        // ======================== 命令 ========================
+
+        RedisMuxAwaitable execute(const std::string& cmd, const std::vector<std::string>& args);
+        RedisMuxAwaitable ping();
+        RedisMuxAwaitable get(const std::string& key);
+        RedisMuxAwaitable set(const std::string& key, const std::string& value);
+        RedisMuxAwaitable del(const std::string& key);
+        RedisMuxAwaitable incr(const std::string& key);
+
+        /**
+         * @brief 批量命令，与其他协程的命令共享发送队列，按在途字节上限分段发送
+         */
+        RedisMuxPipelineAwaitable pipeline(const std::vector<std::vector<std::string>>& commands);
+
+        // ======================== 连接管理 ========================
+
+        /**
+         * @brief 关闭连接，所有在途命令以 CONNECTION_CLOSED 结束
+         * @details 空闲的写协程立即退出；挂在 recv 上的读协程在本轮接收时限到期后退出
+         */
+        auto close() {
+            shutdown(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_CLOSED, "Multiplexer closed"));
+            return m_client.close();
+        }
+
+        /**
+         * @brief 请求发送队列中的命令（首次调用时启动读写协程）
+         * @details pipeline_flush_on_yield 关闭时，co_await 之前需要调用
+         */
+        void flush();
+
+        bool isClosed() const { return m_closed; }
+
+        // 已发送（或待发送）但尚未收到回复的命令数
+        size_t inFlight() const { return m_command_sizes.size(); }
+
+        // 已发送但尚未收到回复的字节数
+        size_t unackedBytes() const { return m_bytes_sent - m_bytes_acked; }
+
+        const RedisMuxStats& stats() const { return m_stats; }
+
+        // 自适应窗口的详细统计（基准延迟、增减次数等）
+        const RedisAdaptiveWindowStats& windowStats() const { return m_window.stats(); }
+
+        ~RedisMultiplexer() = default;
+
+    private:
+        friend class RedisMuxAwaitableBase;
+
+        RedisMultiplexer(IOScheduler* scheduler, AsyncRedisConfig config);
+
+        const AsyncRedisConfig& config() const { return m_client.m_config; }
+
+        /**
+         * @brief 固定参数个数的命令直接编码进发送队列
+         */
+        template<typename Cmd, typename... Args>
+        RedisMuxAwaitable submitCommand(const Args&... args)
+        {
+            if (!m_closed) {
+                size_t before = m_send_buffer.size();
+                Cmd::append(m_send_buffer, args...);
+                m_command_sizes.push_back(m_send_buffer.size() - before);
+            }
+            return RedisMuxAwaitable(*this, enqueue(1));
+        }
+
+        // 命令已写入 m_send_buffer 并记录了长度，登记等待 replies 条回复
+        std::shared_ptr<RedisMuxRequest> enqueue(size_t replies);
+
+        // 有未发完的批次，或已请求发送的新命令
+        bool hasDataToSend() const noexcept;
+
+        // 写协程是否可以继续发送（有数据且未超出在途字节上限和自适应窗口）
+        bool writerReady() const noexcept;
+
+        // 自适应窗口允许的发送终点（累计字节偏移），length 为本次最多发送的字节数
+        size_t windowSendLimit(size_t length) const noexcept;
+
+        // 记录本次发送后完整发出的命令的发送时刻
+        void recordSentCommands();
+
+        // 写协程空闲且有数据可发时恢复它
+        void wakeWriter();
+
+        // 连接不可用：在途命令全部以 error 结束
+        void shutdown(const RedisError& error);
+
+        // 标记请求完成，等待者已 co_await 时恢复它
+        static void complete(RedisMuxRequest& request);
+
+        // 读协程单次 recv 的时限：到期后检查是否已 close()，空闲连接每个周期唤醒一次
+        static constexpr std::chrono::milliseconds kReaderPollInterval{100};
+
+        static Coroutine writeLoop(std::shared_ptr<RedisMultiplexer> self);
+        static Coroutine readLoop(std::shared_ptr<RedisMultiplexer> self);
+
+        // 写协程没有数据可发（或在途字节达到上限）时挂起在这里
+        struct WriterIdle
+        {
+            RedisMultiplexer& mux;
+            bool await_ready() const noexcept { return mux.writerReady(); }
+            void await_suspend(std::coroutine_handle<> handle) noexcept { mux.m_writer = handle; }
+            void await_resume() const noexcept {}
+        };
+
+        RedisClient m_client;
+        IOScheduler* m_scheduler;
+        bool m_started = false;
+        bool m_closed = false;
+        bool m_flush_requested = false;
+
+        std::string m_send_buffer;          // 等待发送的命令
+        size_t m_queued_commands = 0;       // m_send_buffer 中的命令数
+        std::string m_sending;              // 写协程正在发送的批次，与 m_send_buffer 交换使用
+        size_t m_sending_offset = 0;        // m_sending 中已发送的字节数
+        std::deque<std::shared_ptr<RedisMuxRequest>> m_pending;    // 按发送顺序等待回复
+        std::deque<size_t> m_command_sizes; // 尚未收到回复的每条命令的编码长度，按发送顺序
+        size_t m_bytes_sent = 0;            // 累计已发送字节数
+        size_t m_bytes_acked = 0;           // 累计已收到回复的命令字节数
+        // 已完整发出、尚未收到回复的命令的发送时刻，与 m_command_sizes 的前端一一对应
+        std::deque<std::chrono::steady_clock::time_point> m_sent_times;
+        size_t m_sent_end = 0;              // m_sent_times 中最后一条命令的结束偏移（累计字节）
+        RedisAdaptiveWindow m_window;
+        std::coroutine_handle<> m_writer;   // 空闲中的写协程
+
+        RedisMuxStats m_stats;
+    };
+}
+
+#endif // GALAY_REDIS_MULTIPLEXER_H
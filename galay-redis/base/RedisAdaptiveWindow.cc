@@ -0,0 +1,92 @@
+#include "RedisAdaptiveWindow.h"
+#include <algorithm>
+#include <utility>
+
+namespace galay::redis
+{
+    RedisAdaptiveWindow::RedisAdaptiveWindow(RedisAdaptiveWindowConfig config)
+        : m_config(config)
+    {
+        m_config.min_window = std::max<size_t>(m_config.min_window, 1);
+        m_config.max_window = std::max(m_config.max_window, m_config.min_window);
+        m_config.probe_window = std::max(m_config.probe_window, m_config.min_window);
+        m_config.base_confirm_rounds = std::max<size_t>(m_config.base_confirm_rounds, 1);
+        reset();
+    }
+
+    void RedisAdaptiveWindow::reset()
+    {
+        m_window = std::clamp(m_config.initial_window, m_config.min_window, m_config.max_window);
+        m_slow_start = true;
+        m_base_latency = std::chrono::nanoseconds(0);
+        m_round_latency = std::chrono::nanoseconds(0);
+        m_round_min = std::chrono::nanoseconds(0);
+        m_round_replies = 0;
+        m_probe_min = std::chrono::nanoseconds(0);
+        m_probe_rounds = 0;
+        m_stats = {};
+        m_stats.window = m_window;
+        m_stats.peak_window = m_window;
+    }
+
+    void RedisAdaptiveWindow::onReply(std::chrono::nanoseconds latency)
+    {
+        latency = std::max(latency, std::chrono::nanoseconds(1));
+        if (m_base_latency.count() == 0 || latency < m_base_latency) {
+            m_base_latency = latency;
+            m_stats.base_latency = latency;
+        }
+        if (m_round_min.count() == 0 || latency < m_round_min) {
+            m_round_min = latency;
+        }
+        m_round_latency += latency;
+        ++m_round_replies;
+        ++m_stats.samples;
+        if (m_round_replies >= m_window) {
+            endRound();
+        }
+    }
+
+    void RedisAdaptiveWindow::endRound()
+    {
+        size_t round_window = m_window;
+        auto average = m_round_latency / static_cast<int64_t>(m_round_replies);
+        m_stats.last_latency = average;
+        m_round_latency = std::chrono::nanoseconds(0);
+        m_round_replies = 0;
+        auto round_min = std::exchange(m_round_min, std::chrono::nanoseconds(0));
+
+        double limit = static_cast<double>(m_base_latency.count()) * (1.0 + m_config.tolerance);
+        if (static_cast<double>(average.count()) <= limit) {
+            // 延迟平稳：服务端还有余量
+            size_t next = m_slow_start ? m_window * 2 : m_window + 1;
+            m_window = std::min(next, m_config.max_window);
+            ++m_stats.increases;
+        } else {
+            // 延迟上升：请求开始排队，乘性收缩
+            m_slow_start = false;
+            size_t next = static_cast<size_t>(static_cast<double>(m_window) * m_config.decrease);
+            m_window = std::max(next, m_config.min_window);
+            ++m_stats.decreases;
+        }
+
+        // 大窗口下服务端可能一直有积压，一轮中最早的回复也在排队，其延迟不能用来抬高基准，这样的轮次不计入。
+        // 只有窗口已收缩到几乎不排队的轮次反复高于基准，才说明网络或服务端整体变慢；其中一轮回到基准即作废
+        if (round_window <= m_config.probe_window) {
+            if (round_min <= m_base_latency) {
+                m_probe_rounds = 0;
+            } else {
+                if (m_probe_rounds == 0 || round_min < m_probe_min) {
+                    m_probe_min = round_min;
+                }
+                if (++m_probe_rounds >= m_config.base_confirm_rounds) {
+                    m_base_latency = m_probe_min;
+                    m_stats.base_latency = m_probe_min;
+                    m_probe_rounds = 0;
+                }
+            }
+        }
+        m_stats.window = m_window;
+        m_stats.peak_window = std::max(m_stats.peak_window, m_window);
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef GALAY_REDIS_ADAPTIVE_WINDOW_H
+#define GALAY_REDIS_ADAPTIVE_WINDOW_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace galay::redis
+{
+    /**
+     * @brief 自适应窗口参数
+     */
+    struct RedisAdaptiveWindowConfig
+    {
+        size_t initial_window = 16;     // 初始在途命令数
+        size_t min_window = 1;
+        size_t max_window = 4096;
+        double tolerance = 0.5;         // 一轮平均延迟超过基准延迟的 (1 + tolerance) 倍视为排队，收缩窗口
+        double decrease = 0.5;          // 收缩时窗口乘以该系数
+        size_t probe_window = 4;        // 窗口不超过该值时几乎没有排队，这样的轮次才用来重新测量基准延迟
+        size_t base_confirm_rounds = 8; // 这么多个小窗口轮次的最小延迟都高于基准（中间没有回到基准），才上调基准
+    };
+
+    /**
+     * @brief 自适应窗口统计
+     */
+    struct RedisAdaptiveWindowStats
+    {
+        size_t window = 0;                          // 当前窗口
+        size_t peak_window = 0;                     // 历史最大窗口
+        std::chrono::nanoseconds base_latency{0};   // 无排队时的单命令延迟基准
+        std::chrono::nanoseconds last_latency{0};   // 上一轮的平均单命令延迟
+        uint64_t samples = 0;                       // 已统计的回复数
+        uint64_t increases = 0;                     // 扩大窗口的轮数
+        uint64_t decreases = 0;                     // 收缩窗口的轮数
+    };
+
+    /**
+     * @brief 按延迟调节在途命令数的控制器（Vegas 式的延迟信号 + AIMD）
+     * @details 以 window 条回复为一轮（约一个往返）。一轮的平均延迟接近基准延迟时说明服务端没有排队，
+     *          窗口增大：首次收缩前每轮翻倍（慢启动），之后每轮加一；平均延迟明显升高时窗口乘以 decrease。
+     *          基准延迟是长期的最小值（同 Vegas / BBR 的 min RTT），大窗口下的延迟含有排队，不会抬高基准。
+     *          服务端整体变慢时窗口会收缩到 probe_window 以下，base_confirm_rounds 个小窗口轮次的
+     *          最小延迟都高于基准（期间没有一轮回到基准），才把基准上调为这些轮次的最小值，之后窗口重新增长。
+     */
+    class RedisAdaptiveWindow
+    {
+    public:
+        explicit RedisAdaptiveWindow(RedisAdaptiveWindowConfig config = {});
+
+        // 当前允许的在途命令数
+        size_t window() const { return m_window; }
+
+        // 每收到一条回复调用一次，latency 为该命令发出到收到回复的时间
+        void onReply(std::chrono::nanoseconds latency);
+
+        // 回到初始窗口并重新探测基准延迟
+        void reset();
+
+        const RedisAdaptiveWindowStats& stats() const { return m_stats; }
+        const RedisAdaptiveWindowConfig& config() const { return m_config; }
+
+    private:
+        void endRound();
+
+        RedisAdaptiveWindowConfig m_config;
+        size_t m_window;
+        bool m_slow_start = true;
+        std::chrono::nanoseconds m_base_latency{0};
+        std::chrono::nanoseconds m_round_latency{0};    // 本轮延迟之和
+        std::chrono::nanoseconds m_round_min{0};        // 本轮最小延迟
+        size_t m_round_replies = 0;
+        std::chrono::nanoseconds m_probe_min{0};        // 连续小窗口轮次的最小延迟
+        size_t m_probe_rounds = 0;                      // 连续小窗口轮次数
+        RedisAdaptiveWindowStats m_stats;
+    };
+}
+
+#endif // GALAY_REDIS_ADAPTIVE_WINDOW_H
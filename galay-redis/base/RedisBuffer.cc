@@ -0,0 +1,141 @@
+#include "RedisBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace galay::redis
+{
+    RedisBuffer::RedisBuffer(size_t initial_capacity)
+        : m_capacity(std::max<size_t>(initial_capacity, 64))
+        , m_initial_capacity(m_capacity)
+    {
+        m_data = std::make_unique_for_overwrite<char[]>(m_capacity);
+        m_stats.capacity = m_capacity;
+        m_stats.peak_capacity = m_capacity;
+    }
+
+    RedisBuffer::RedisBuffer(RedisBuffer&& other) noexcept
+        : m_data(std::move(other.m_data))
+        , m_capacity(other.m_capacity)
+        , m_initial_capacity(other.m_initial_capacity)
+        , m_read(other.m_read)
+        , m_write(other.m_write)
+        , m_round_peak(other.m_round_peak)
+        , m_small_rounds(other.m_small_rounds)
+        , m_stats(other.m_stats)
+    {
+        other.m_capacity = 0;
+        other.m_read = 0;
+        other.m_write = 0;
+    }
+
+    RedisBuffer& RedisBuffer::operator=(RedisBuffer&& other) noexcept
+    {
+        if (this != &other) {
+            m_data = std::move(other.m_data);
+            m_capacity = other.m_capacity;
+            m_initial_capacity = other.m_initial_capacity;
+            m_read = other.m_read;
+            m_write = other.m_write;
+            m_round_peak = other.m_round_peak;
+            m_small_rounds = other.m_small_rounds;
+            m_stats = other.m_stats;
+            other.m_capacity = 0;
+            other.m_read = 0;
+            other.m_write = 0;
+        }
+        return *this;
+    }
+
+    std::vector<iovec> RedisBuffer::getWriteIovecs()
+    {
+        prepareWrite();
+        return {iovec{m_data.get() + m_write, m_capacity - m_write}};
+    }
+
+    std::span<char> RedisBuffer::getWriteSpan()
+    {
+        prepareWrite();
+        return {m_data.get() + m_write, m_capacity - m_write};
+    }
+
+    void RedisBuffer::produce(size_t n)
+    {
+        m_write = std::min(m_write + n, m_capacity);
+        m_round_peak = std::max(m_round_peak, m_write);
+    }
+
+    void RedisBuffer::consume(size_t n)
+    {
+        m_read = std::min(m_read + n, m_write);
+        if (m_read != m_write) {
+            return;
+        }
+        size_t used = m_round_peak;
+        m_read = 0;
+        m_write = 0;
+        m_round_peak = 0;
+        if (m_capacity <= m_initial_capacity) {
+            m_small_rounds = 0;
+            return;
+        }
+        // 一轮用量超过四分之一说明大回复还在出现，保留容量，否则下一个大回复又要逐级扩容
+        if (used > m_capacity / 4) {
+            m_small_rounds = 0;
+            return;
+        }
+        if (++m_small_rounds >= kShrinkAfterRounds) {
+            // 大回复已经有一段时间没出现，归还内存
+            reallocate(m_initial_capacity);
+            m_small_rounds = 0;
+            ++m_stats.shrink_count;
+        }
+    }
+
+    size_t RedisBuffer::minWritable(size_t capacity) const
+    {
+        // 小缓冲区保留一半空闲，大缓冲区保留四分之一，避免大帧把容量放大到4倍
+        return std::max(m_initial_capacity / 2, capacity / 4);
+    }
+
+    void RedisBuffer::prepareWrite()
+    {
+        if (m_capacity - m_write >= minWritable(m_capacity)) {
+            return;
+        }
+        // 把未消费的数据搬到头部，通常只是一个帧的前半部分
+        if (m_read > 0) {
+            size_t length = readable();
+            std::memmove(m_data.get(), m_data.get() + m_read, length);
+            m_read = 0;
+            m_write = length;
+            ++m_stats.compact_count;
+            m_stats.compact_bytes += length;
+            if (m_capacity - m_write >= minWritable(m_capacity)) {
+                return;
+            }
+        }
+        // 正在接收的帧占满了缓冲区，扩容
+        size_t capacity = std::max(m_capacity, m_initial_capacity);
+        while (capacity - m_write < minWritable(capacity)) {
+            capacity *= 2;
+        }
+        reallocate(capacity);
+        ++m_stats.grow_count;
+    }
+
+    void RedisBuffer::reallocate(size_t capacity)
+    {
+        auto data = std::make_unique_for_overwrite<char[]>(capacity);
+        size_t length = readable();
+        if (length > 0) {
+            std::memcpy(data.get(), m_data.get() + m_read, length);
+        }
+        m_data = std::move(data);
+        m_capacity = capacity;
+        m_read = 0;
+        m_write = length;
+        m_stats.capacity = capacity;
+        m_stats.peak_capacity = std::max(m_stats.peak_capacity, capacity);
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef GALAY_REDIS_BUFFER_H
+#define GALAY_REDIS_BUFFER_H
+
+#include <memory>
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <sys/uio.h>
+
+namespace galay::redis
+{
+    /**
+     * @brief 接收缓冲区统计
+     */
+    struct RedisBufferStats
+    {
+        size_t capacity = 0;        // 当前容量
+        size_t peak_capacity = 0;   // 历史最大容量
+        size_t grow_count = 0;      // 扩容次数
+        size_t shrink_count = 0;    // 缩回初始容量的次数
+        size_t compact_count = 0;   // 把未消费数据搬到头部的次数
+        size_t compact_bytes = 0;   // 搬移的总字节数
+    };
+
+    /**
+     * @brief 自适应接收缓冲区
+     * @details 可读数据始终连续存放在 [read, write) 中，解析器直接拿到完整的一段，不存在回绕拼接。
+     *          尾部空闲不足时先把未消费的数据（通常只是半个帧）搬到头部；
+     *          搬移后仍不足，说明正在接收的帧超过了容量，按2倍扩容，直到能装下为止。
+     *          数据全部消费后读写位置归零；容量大于初始值时，连续 kShrinkAfterRounds 轮
+     *          （每轮从空到再次清空）都只用到容量的四分之一以内，才缩回初始容量，
+     *          避免大小回复交替时每个大回复都重新扩容。
+     */
+    class RedisBuffer
+    {
+    public:
+        // 连续多少轮小用量之后缩回初始容量
+        static constexpr size_t kShrinkAfterRounds = 16;
+
+        explicit RedisBuffer(size_t initial_capacity);
+
+        RedisBuffer(RedisBuffer&& other) noexcept;
+        RedisBuffer& operator=(RedisBuffer&& other) noexcept;
+        RedisBuffer(const RedisBuffer&) = delete;
+        RedisBuffer& operator=(const RedisBuffer&) = delete;
+
+        /**
+         * @brief 可写区域，用于 readv；必要时先搬移或扩容，保证留有足够的空闲
+         */
+        std::vector<iovec> getWriteIovecs();
+
+        /**
+         * @brief 同 getWriteIovecs，但只返回这一段连续区域，用于 recv，不分配 iovec 数组
+         */
+        std::span<char> getWriteSpan();
+
+        // 写入 n 字节后调用
+        void produce(size_t n);
+        // 消费 n 字节；全部消费后重置位置，满足缩容条件时缩回初始容量
+        void consume(size_t n);
+
+        // 连续的可读数据
+        const char* data() const { return m_data.get() + m_read; }
+        size_t readable() const { return m_write - m_read; }
+        bool empty() const { return m_read == m_write; }
+
+        size_t capacity() const { return m_capacity; }
+        const RedisBufferStats& stats() const { return m_stats; }
+
+    private:
+        void prepareWrite();
+        size_t minWritable(size_t capacity) const;
+        void reallocate(size_t capacity);
+
+        std::unique_ptr<char[]> m_data;
+        size_t m_capacity;
+        size_t m_initial_capacity;
+        size_t m_read = 0;
+        size_t m_write = 0;
+        size_t m_round_peak = 0;    // 本轮写入位置的最大值
+        size_t m_small_rounds = 0;  // 连续小用量的轮数
+        RedisBufferStats m_stats;
+    };
+}
+
+#endif // GALAY_REDIS_BUFFER_H
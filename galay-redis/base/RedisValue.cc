@@ -13,27 +13,41 @@ namespace galay::redis
     {
     }
 
+    RedisValue::RedisValue(std::shared_ptr<const protocol::RespArenaReply> arena, uint32_t index)
+        : m_reply()
+        , m_arena(std::move(arena))
+        , m_arena_index(index)
+    {
+    }
+
+    RedisValue::RedisValue(std::shared_ptr<const protocol::RespTapeReply> tape, uint32_t index)
+        : m_reply()
+        , m_tape(std::move(tape))
+        , m_tape_index(index)
+    {
+    }
+
     RedisValue::RedisValue(RedisValue&& other) noexcept
         : m_reply(std::move(other.m_reply))
-        , m_cached_array(std::move(other.m_cached_array))
-        , m_cached_map(std::move(other.m_cached_map))
-        , m_array_cached(other.m_array_cached)
-        , m_map_cached(other.m_map_cached)
+        , m_arena(std::move(other.m_arena))
+        , m_arena_index(other.m_arena_index)
+        , m_tape(std::move(other.m_tape))
+        , m_tape_index(other.m_tape_index)
+        , m_materialized(other.m_materialized)
     {
-        other.m_array_cached = false;
-        other.m_map_cached = false;
+        other.m_materialized = false;
     }
 
     RedisValue& RedisValue::operator=(RedisValue&& other) noexcept
     {
         if (this != &other) {
             m_reply = std::move(other.m_reply);
-            m_cached_array = std::move(other.m_cached_array);
-            m_cached_map = std::move(other.m_cached_map);
-            m_array_cached = other.m_array_cached;
-            m_map_cached = other.m_map_cached;
-            other.m_array_cached = false;
-            other.m_map_cached = false;
+            m_arena = std::move(other.m_arena);
+            m_arena_index = other.m_arena_index;
+            m_tape = std::move(other.m_tape);
+            m_tape_index = other.m_tape_index;
+            m_materialized = other.m_materialized;
+            other.m_materialized = false;
         }
         return *this;
     }
@@ -45,135 +59,191 @@ namespace galay::redis
         return RedisValue(std::move(reply));
     }
 
+    void RedisValue::materialize() const
+    {
+        if (m_materialized) {
+            return;
+        }
+        if (m_arena) {
+            m_reply = arenaView().toReply();
+            m_materialized = true;
+        } else if (m_tape) {
+            m_reply = tapeView().toReply();
+            m_materialized = true;
+        }
+    }
+
+    protocol::RedisReply& RedisValue::getReply()
+    {
+        materialize();
+        // 调用方可能修改返回的树：以它为准，否则 is/to 接口仍读取 arena/tape 中的旧值
+        m_arena.reset();
+        m_arena_index = 0;
+        m_tape.reset();
+        m_tape_index = 0;
+        return m_reply;
+    }
+
+    std::vector<RedisValue> RedisValue::flatChildren() const
+    {
+        std::vector<RedisValue> result;
+        if (m_arena) {
+            // 子节点连续存放，按下标访问
+            auto view = arenaView();
+            result.reserve(view.size());
+            for (size_t i = 0; i < view.size(); ++i) {
+                result.emplace_back(m_arena, view.at(i).index());
+            }
+        } else if (m_tape) {
+            // 沿兄弟链顺序前进，每一步O(1)
+            auto view = tapeView();
+            result.reserve(view.size());
+            auto child = view.firstChild();
+            for (size_t i = 0; i < view.size(); ++i, child = child.nextSibling()) {
+                result.emplace_back(m_tape, child.index());
+            }
+        }
+        return result;
+    }
+
     bool RedisValue::isNull() const
     {
-        return m_reply.isNull();
+        return dispatch([](const auto& r) { return r.isNull(); });
     }
 
     bool RedisValue::isStatus() const
     {
-        return m_reply.isSimpleString();
+        return dispatch([](const auto& r) { return r.isSimpleString(); });
     }
 
     std::string RedisValue::toStatus() const
     {
-        return m_reply.asString();
+        return dispatch([](const auto& r) { return std::string(r.asString()); });
     }
 
     bool RedisValue::isError() const
     {
-        return m_reply.isError();
+        return dispatch([](const auto& r) { return r.isError(); });
     }
 
     std::string RedisValue::toError() const
     {
-        return m_reply.asString();
+        return dispatch([](const auto& r) { return std::string(r.asString()); });
     }
 
     bool RedisValue::isInteger() const
     {
-        return m_reply.isInteger();
+        return dispatch([](const auto& r) { return r.isInteger(); });
     }
 
     int64_t RedisValue::toInteger() const
     {
-        return m_reply.asInteger();
+        return dispatch([](const auto& r) { return r.asInteger(); });
     }
 
     bool RedisValue::isString() const
     {
-        return m_reply.isBulkString();
+        return dispatch([](const auto& r) { return r.isBulkString(); });
     }
 
     std::string RedisValue::toString() const
     {
-        return m_reply.asString();
+        return dispatch([](const auto& r) { return std::string(r.asString()); });
     }
 
     bool RedisValue::isArray() const
     {
-        return m_reply.isArray();
+        return dispatch([](const auto& r) { return r.isArray(); });
     }
 
     std::vector<RedisValue> RedisValue::toArray() const
     {
-        if (!m_array_cached) {
-            m_cached_array.clear();
-            if (m_reply.isArray()) {
-                const auto& arr = m_reply.asArray();
-                m_cached_array.reserve(arr.size());
-                for (const auto& elem : arr) {
-                    // 使用拷贝构造，避免 const_cast
-                    m_cached_array.push_back(RedisValue(elem));
-                }
-            }
-            m_array_cached = true;
+        if (m_arena || m_tape) {
+            // 子元素共享同一块内存，不拷贝字符串
+            return isArray() ? flatChildren() : std::vector<RedisValue>{};
         }
-        // 返回拷贝，保持接口不变
+        // 直接从回复拷贝一次；需要避免拷贝时使用 decode<T> 或 arena/tape 模式
         std::vector<RedisValue> result;
-        result.reserve(m_cached_array.size());
-        for (const auto& elem : m_cached_array) {
-            result.push_back(RedisValue(elem.m_reply));
+        if (m_reply.isArray()) {
+            const auto& arr = m_reply.asArray();
+            result.reserve(arr.size());
+            for (const auto& elem : arr) {
+                result.push_back(RedisValue(elem));
+            }
         }
         return result;
     }
 
     bool RedisValue::isDouble() const
     {
-        return m_reply.isDouble();
+        return dispatch([](const auto& r) { return r.isDouble(); });
     }
 
     double RedisValue::toDouble() const
     {
-        return m_reply.asDouble();
+        return dispatch([](const auto& r) { return r.asDouble(); });
     }
 
     bool RedisValue::isBool() const
     {
-        return m_reply.isBoolean();
+        return dispatch([](const auto& r) { return r.isBoolean(); });
     }
 
     bool RedisValue::toBool() const
     {
-        return m_reply.asBoolean();
+        return dispatch([](const auto& r) { return r.asBoolean(); });
     }
 
     bool RedisValue::isMap() const
     {
-        return m_reply.isMap();
+        return dispatch([](const auto& r) { return r.isMap(); });
     }
 
     std::map<std::string, RedisValue> RedisValue::toMap() const
     {
-        if (!m_map_cached) {
-            m_cached_map.clear();
-            if (m_reply.isMap()) {
-                const auto& map_data = m_reply.asMap();
-                for (const auto& [key, value] : map_data) {
-                    // 使用拷贝构造，避免 const_cast
-                    m_cached_map.emplace(
-                        key.asString(),
-                        RedisValue(value)
-                    );
+        if (m_arena) {
+            std::map<std::string, RedisValue> result;
+            auto view = arenaView();
+            if (view.isMap()) {
+                for (size_t i = 0; i < view.size(); ++i) {
+                    result.emplace(std::string(view.key(i).asString()),
+                                   RedisValue(m_arena, view.value(i).index()));
+                }
+            }
+            return result;
+        }
+        if (m_tape) {
+            std::map<std::string, RedisValue> result;
+            auto view = tapeView();
+            if (view.isMap()) {
+                auto key = view.firstChild();
+                for (size_t i = 0; i < view.size(); ++i) {
+                    auto value = key.nextSibling();
+                    result.emplace(std::string(key.asString()), RedisValue(m_tape, value.index()));
+                    key = value.nextSibling();
                 }
             }
-            m_map_cached = true;
+            return result;
         }
-        // 返回拷贝，保持接口不变
         std::map<std::string, RedisValue> result;
-        for (const auto& [key, value] : m_cached_map) {
-            result.emplace(key, RedisValue(value.m_reply));
+        if (m_reply.isMap()) {
+            for (const auto& [key, value] : m_reply.asMap()) {
+                result.emplace(key.asString(), RedisValue(value));
+            }
         }
         return result;
     }
 
     bool RedisValue::isSet() const
     {
-        return m_reply.isSet();
+        return dispatch([](const auto& r) { return r.isSet(); });
     }
 
     std::vector<RedisValue> RedisValue::toSet() const
     {
+        if (m_arena || m_tape) {
+            return isSet() ? flatChildren() : std::vector<RedisValue>{};
+        }
         std::vector<RedisValue> result;
         if (m_reply.isSet()) {
             const auto& set_data = m_reply.asArray();  // Set uses array internally
@@ -193,11 +263,14 @@ namespace galay::redis
 
     bool RedisValue::isPush() const
     {
-        return m_reply.isPush();
+        return dispatch([](const auto& r) { return r.isPush(); });
     }
 
     std::vector<RedisValue> RedisValue::toPush() const
     {
+        if (m_arena || m_tape) {
+            return isPush() ? flatChildren() : std::vector<RedisValue>{};
+        }
         std::vector<RedisValue> result;
         if (m_reply.isPush()) {
             const auto& push_data = m_reply.asArray();
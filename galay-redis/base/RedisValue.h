@@ -2,18 +2,27 @@
 #define GALAY_REDIS_VALUE_H
 
 #include "../protocol/RedisProtocol.h"
+#include "../protocol/RespArena.h"
+#include "../protocol/RespTape.h"
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 namespace galay::redis
 {
     // RedisValue类，基于protocol::RedisReply实现
+    // 也可以基于 protocol::RespArenaReply / protocol::RespTapeReply：整个回复位于同一块内存，
+    // 子元素共享该内存并按需访问
     class RedisValue
     {
     public:
         RedisValue();
         explicit RedisValue(protocol::RedisReply reply);
+        // arena模式：index为节点下标，0为根
+        explicit RedisValue(std::shared_ptr<const protocol::RespArenaReply> arena, uint32_t index = 0);
+        // tape模式：index为记录下标，0为根
+        explicit RedisValue(std::shared_ptr<const protocol::RespTapeReply> tape, uint32_t index = 0);
         RedisValue(RedisValue&& other) noexcept;
         RedisValue& operator=(RedisValue&& other) noexcept;
         RedisValue(const RedisValue&) = delete;
@@ -58,21 +67,49 @@ namespace galay::redis
         bool isVerb() const;
         std::string toVerb() const;
 
-        // 获取底层RedisReply
-        const protocol::RedisReply& getReply() const { return m_reply; }
-        protocol::RedisReply& getReply() { return m_reply; }
+        // 获取底层RedisReply（arena/tape模式下首次调用时物化）
+        const protocol::RedisReply& getReply() const { materialize(); return m_reply; }
+        // 可修改的RedisReply：arena/tape模式下物化后不再引用共享内存，之后的修改对 is/to 接口可见；
+        // 只读访问请用 const 重载，以保留惰性表示
+        protocol::RedisReply& getReply();
+
+        // 是否为arena模式
+        bool isArenaBacked() const { return m_arena != nullptr; }
+
+        // 是否为tape模式
+        bool isTapeBacked() const { return m_tape != nullptr; }
+
+        // tape模式下的游标，可用 firstChild/nextSibling 顺序遍历并O(1)跳过子聚合
+        protocol::RespTapeView tapeView() const { return m_tape ? m_tape->view(m_tape_index) : protocol::RespTapeView(); }
 
         virtual ~RedisValue() = default;
 
     protected:
-        protocol::RedisReply m_reply;
+        mutable protocol::RedisReply m_reply;
 
     private:
-        // 缓存转换后的数组和map
-        mutable std::vector<RedisValue> m_cached_array;
-        mutable std::map<std::string, RedisValue> m_cached_map;
-        mutable bool m_array_cached = false;
-        mutable bool m_map_cached = false;
+        protocol::RedisReplyView arenaView() const { return m_arena->view(m_arena_index); }
+        void materialize() const;
+
+        // 按存储方式分发：三种表示的访问接口同名
+        template<typename F>
+        decltype(auto) dispatch(F&& f) const
+        {
+            if (m_arena) return f(arenaView());
+            if (m_tape) return f(tapeView());
+            return f(m_reply);
+        }
+
+        // arena/tape模式下数组类子元素
+        std::vector<RedisValue> flatChildren() const;
+
+        // arena模式
+        std::shared_ptr<const protocol::RespArenaReply> m_arena;
+        uint32_t m_arena_index = 0;
+        // tape模式
+        std::shared_ptr<const protocol::RespTapeReply> m_tape;
+        uint32_t m_tape_index = 0;
+        mutable bool m_materialized = false;
     };
 
     class RedisAsyncValue: public RedisValue
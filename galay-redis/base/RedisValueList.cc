@@ -0,0 +1,83 @@
+#include "RedisValueList.h"
+#include <algorithm>
+
+namespace galay::redis
+{
+    RedisValueList::RedisValueList(std::vector<RedisValue> values)
+        : m_values(std::move(values))
+    {
+    }
+
+    RedisValueList::RedisValueList(RedisValueList&& other) noexcept
+        : m_single(std::move(other.m_single))
+        , m_values(std::move(other.m_values))
+    {
+        other.clear();
+    }
+
+    RedisValueList& RedisValueList::operator=(RedisValueList&& other) noexcept
+    {
+        if (this != &other) {
+            m_single = std::move(other.m_single);
+            m_values = std::move(other.m_values);
+            other.clear();
+        }
+        return *this;
+    }
+
+    void RedisValueList::push_back(RedisValue&& value)
+    {
+        if (!m_single && m_values.empty()) {
+            m_single.emplace(std::move(value));
+            return;
+        }
+        if (m_single) {
+            // 第二个回复：连同第一个一起搬到堆上，保证元素连续
+            m_values.reserve(std::max<size_t>(m_values.capacity(), 2));
+            m_values.push_back(std::move(*m_single));
+            m_single.reset();
+        }
+        m_values.push_back(std::move(value));
+    }
+
+    void RedisValueList::reserve(size_t capacity)
+    {
+        // 单个回复不需要堆内存
+        if (capacity > 1) {
+            m_values.reserve(capacity);
+        }
+    }
+
+    void RedisValueList::clear() noexcept
+    {
+        m_single.reset();
+        m_values.clear();
+    }
+
+    RedisValue& RedisValueList::at(size_t index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range("RedisValueList::at");
+        }
+        return data()[index];
+    }
+
+    const RedisValue& RedisValueList::at(size_t index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("RedisValueList::at");
+        }
+        return data()[index];
+    }
+
+    std::vector<RedisValue> RedisValueList::toVector() &&
+    {
+        if (m_single) {
+            std::vector<RedisValue> values;
+            values.push_back(std::move(*m_single));
+            m_single.reset();
+            return values;
+        }
+        return std::move(m_values);
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef GALAY_REDIS_VALUE_LIST_H
+#define GALAY_REDIS_VALUE_LIST_H
+
+#include "RedisValue.h"
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace galay::redis
+{
+    /**
+     * @brief 单条命令的回复列表
+     * @details 接口与 std::vector<RedisValue> 的常用部分一致（size/empty/[]/front/back/迭代）。
+     *          只有一个回复时存放在对象内部，不申请堆内存；第二个回复到来时整体搬到 std::vector 中。
+     *          需要 std::vector 时可以用 toVector() 或直接移动赋值。
+     */
+    class RedisValueList
+    {
+    public:
+        using value_type = RedisValue;
+        using iterator = RedisValue*;
+        using const_iterator = const RedisValue*;
+
+        RedisValueList() = default;
+        RedisValueList(std::vector<RedisValue> values);
+        RedisValueList(RedisValueList&& other) noexcept;
+        RedisValueList& operator=(RedisValueList&& other) noexcept;
+        RedisValueList(const RedisValueList&) = delete;
+        RedisValueList& operator=(const RedisValueList&) = delete;
+
+        void push_back(RedisValue&& value);
+        void reserve(size_t capacity);
+        void clear() noexcept;
+
+        size_t size() const noexcept { return m_single ? 1 : m_values.size(); }
+        bool empty() const noexcept { return size() == 0; }
+
+        RedisValue* data() noexcept { return m_single ? &*m_single : m_values.data(); }
+        const RedisValue* data() const noexcept { return m_single ? &*m_single : m_values.data(); }
+
+        iterator begin() noexcept { return data(); }
+        iterator end() noexcept { return data() + size(); }
+        const_iterator begin() const noexcept { return data(); }
+        const_iterator end() const noexcept { return data() + size(); }
+
+        RedisValue& operator[](size_t index) noexcept { return data()[index]; }
+        const RedisValue& operator[](size_t index) const noexcept { return data()[index]; }
+        RedisValue& at(size_t index);
+        const RedisValue& at(size_t index) const;
+
+        RedisValue& front() noexcept { return data()[0]; }
+        const RedisValue& front() const noexcept { return data()[0]; }
+        RedisValue& back() noexcept { return data()[size() - 1]; }
+        const RedisValue& back() const noexcept { return data()[size() - 1]; }
+
+        // 转为 std::vector（一个回复时会申请内存）
+        std::vector<RedisValue> toVector() &&;
+        operator std::vector<RedisValue>() && { return std::move(*this).toVector(); }
+
+    private:
+        std::optional<RedisValue> m_single;     // 只有一个回复时使用
+        std::vector<RedisValue> m_values;       // 两个及以上；与 m_single 不会同时非空
+    };
+}
+
+#endif // GALAY_REDIS_VALUE_LIST_H
@@ -160,6 +160,8 @@ namespace galay::redis::protocol
 
         std::vector<char> buffer;
         buffer.reserve(BUFFER_SIZE);
+        // 每次从新缓冲区开始解析，丢弃上次可能残留的未完成帧
+        m_parser.reset();
 
         while (true) {
             // 尝试解析已接收的数据
@@ -205,4 +207,70 @@ namespace galay::redis::protocol
 
         return receiveReply();
     }
+
+    std::expected<RespBulkStreamResult, RedisError> Connection::receiveBulkStream(const RespBulkSink& sink)
+    {
+        if (!m_connected || m_socket_fd < 0) {
+            return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
+                "Not connected"));
+        }
+
+        RespBulkStreamParser parser;
+        // m_recv_buffer[0, filled) 为尚未处理的字节：首行或结尾的\r\n被截断时留待下次
+        size_t filled = 0;
+
+        while (true) {
+            if (filled == m_recv_buffer.size()) {
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_BUFFER_OVERFLOW_ERROR,
+                    "Reply header too large"));
+            }
+
+            ssize_t received = ::recv(m_socket_fd, m_recv_buffer.data() + filled, m_recv_buffer.size() - filled, 0);
+            if (received < 0) {
+                if (errno == EINTR) continue;
+                m_connected = false;
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_RECV_ERROR,
+                    "Receive failed: " + std::string(strerror(errno))));
+            } else if (received == 0) {
+                m_connected = false;
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_CONNECTION_ERROR,
+                    "Connection closed by peer"));
+            }
+            filled += received;
+
+            auto progress = parser.parse(m_recv_buffer.data(), filled, sink);
+            if (!progress) {
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_PARSE_ERROR,
+                    "Failed to parse response"));
+            }
+            filled -= progress->consumed;
+            if (filled > 0) {
+                std::memmove(m_recv_buffer.data(), m_recv_buffer.data() + progress->consumed, filled);
+            }
+            if (!progress->done) {
+                continue;
+            }
+
+            if (parser.isError()) {
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_COMMAND_ERROR,
+                    parser.errorMessage()));
+            }
+            if (parser.sinkStopped()) {
+                return std::unexpected(RedisError(RedisErrorType::REDIS_ERROR_TYPE_INVALID_ERROR,
+                    "Stream sink stopped"));
+            }
+            return parser.result();
+        }
+    }
+
+    std::expected<RespBulkStreamResult, RedisError> Connection::executeStream(const std::string& encoded_command,
+                                                                              const RespBulkSink& sink)
+    {
+        auto send_result = send(encoded_command);
+        if (!send_result) {
+            return std::unexpected(send_result.error());
+        }
+
+        return receiveBulkStream(sink);
+    }
 }
@@ -2,6 +2,7 @@
 #define GALAY_REDIS_PROTOCOL_CONNECTION_H
 
 #include "RedisProtocol.h"
+#include "RespStream.h"
 #include "../base/RedisError.h"
 #include <string>
 #include <expected>
@@ -35,6 +36,14 @@ namespace galay::redis::protocol
         // 发送命令并接收响应（便捷方法）
         std::expected<RedisReply, RedisError> execute(const std::string& encoded_command);
 
+        // 流式接收 bulk 回复：内容按到达顺序分片交给 sink，内存占用固定为接收缓冲区大小
+        // 错误回复返回 REDIS_ERROR_TYPE_COMMAND_ERROR，sink 中途返回 false 时读完剩余内容后返回 REDIS_ERROR_TYPE_INVALID_ERROR
+        std::expected<RespBulkStreamResult, RedisError> receiveBulkStream(const RespBulkSink& sink);
+
+        // 发送命令并流式接收（便捷方法），如 executeStream(RespEncoder().encodeCommand("GET", {key}), makeFdSink(fd))
+        std::expected<RespBulkStreamResult, RedisError> executeStream(const std::string& encoded_command,
+                                                                      const RespBulkSink& sink);
+
     private:
         int m_socket_fd;
         bool m_connected;
@@ -1,7 +1,9 @@
 #include "RedisProtocol.h"
+#include "RespScanner.h"
 #include <cstring>
 #include <charconv>
 #include <sstream>
+#include <algorithm>
 
 namespace galay::redis::protocol
 {
@@ -103,18 +105,21 @@ namespace galay::redis::protocol
     {
     }
 
-    void RespParser::reset()
+    void RespParser::reset() noexcept
     {
+        m_frames.clear();
+        m_offset = 0;
+        m_scan_offset = 0;
+        m_bulk_length = -1;
     }
 
     std::optional<size_t> RespParser::findCRLF(const char* data, size_t length, size_t offset)
     {
-        for (size_t i = offset; i < length - 1; ++i) {
-            if (data[i] == '\r' && data[i + 1] == '\n') {
-                return i;
-            }
+        size_t pos = RespScanner::findCRLF(data, length, offset);
+        if (pos == RespScanner::npos) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        return pos;
     }
 
     std::expected<int64_t, ParseError> RespParser::parseIntegerValue(const char* data, size_t length)
@@ -144,341 +149,306 @@ namespace galay::redis::protocol
         return negative ? -result : result;
     }
 
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parse(const char* data, size_t length)
-    {
-        if (length < 1) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        char type_marker = data[0];
-        switch (type_marker) {
-            case '+':  // Simple String
-                return parseSimpleString(data, length);
-            case '-':  // Error
-                return parseError(data, length);
-            case ':':  // Integer
-                return parseInteger(data, length);
-            case '$':  // Bulk String
-                return parseBulkString(data, length);
-            case '*':  // Array
-                return parseArray(data, length);
-            case ',':  // Double (RESP3)
-                return parseDouble(data, length);
-            case '#':  // Boolean (RESP3)
-                return parseBoolean(data, length);
-            case '%':  // Map (RESP3)
-                return parseMap(data, length);
-            case '~':  // Set (RESP3)
-                return parseSet(data, length);
-            default:
-                return std::unexpected(ParseError::InvalidType);
-        }
-    }
-
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseSimpleString(const char* data, size_t length)
-    {
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        std::string value(data + 1, *crlf_pos - 1);
-        RedisReply result(RespType::SimpleString, value);
-        return std::make_pair(*crlf_pos + 2, std::move(result));
-    }
-
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseError(const char* data, size_t length)
-    {
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        std::string value(data + 1, *crlf_pos - 1);
-        RedisReply result(RespType::Error, value);
-        return std::make_pair(*crlf_pos + 2, std::move(result));
-    }
-
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseInteger(const char* data, size_t length)
+    bool RespParser::complete(RedisReply&& reply, RedisReply& out)
     {
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
+        while (!m_frames.empty()) {
+            Frame& top = m_frames.back();
+            top.elements.push_back(std::move(reply));
+            if (--top.remaining > 0) {
+                return false;
+            }
 
-        auto int_result = parseIntegerValue(data + 1, *crlf_pos - 1);
-        if (!int_result) {
-            return std::unexpected(int_result.error());
+            // 栈顶聚合已满，收尾后继续挂到上一层
+            if (top.type == RespType::Map) {
+                std::vector<std::pair<RedisReply, RedisReply>> map_data;
+                map_data.reserve(top.elements.size() / 2);
+                for (size_t i = 0; i + 1 < top.elements.size(); i += 2) {
+                    map_data.emplace_back(std::move(top.elements[i]), std::move(top.elements[i + 1]));
+                }
+                reply = RedisReply(RespType::Map, std::move(map_data));
+            } else {
+                reply = RedisReply(top.type, std::move(top.elements));
+            }
+            m_frames.pop_back();
         }
 
-        RedisReply result(RespType::Integer, *int_result);
-        return std::make_pair(*crlf_pos + 2, std::move(result));
+        out = std::move(reply);
+        return true;
     }
 
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseBulkString(const char* data, size_t length)
+    bool RespParser::beginAggregate(RespType type, int64_t count, RedisReply& out)
     {
-        // 解析长度
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        auto len_result = parseIntegerValue(data + 1, *crlf_pos - 1);
-        if (!len_result) {
-            return std::unexpected(len_result.error());
-        }
-
-        int64_t str_len = *len_result;
-
-        // 处理空值
-        if (str_len == -1) {
-            RedisReply result(RespType::Null, std::monostate{});
-            return std::make_pair(*crlf_pos + 2, std::move(result));
-        }
-
-        if (str_len < 0) {
-            return std::unexpected(ParseError::InvalidLength);
-        }
-
-        size_t content_start = *crlf_pos + 2;
-        size_t content_end = content_start + str_len;
-
-        // 检查是否有足够的数据
-        if (content_end + 2 > length) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        // 验证结尾的\r\n
-        if (data[content_end] != '\r' || data[content_end + 1] != '\n') {
-            return std::unexpected(ParseError::InvalidFormat);
+        if (count == 0) {
+            if (type == RespType::Map) {
+                return complete(RedisReply(type, std::vector<std::pair<RedisReply, RedisReply>>{}), out);
+            }
+            return complete(RedisReply(type, std::vector<RedisReply>{}), out);
         }
 
-        std::string value(data + content_start, str_len);
-        RedisReply result(RespType::BulkString, value);
-        return std::make_pair(content_end + 2, std::move(result));
+        Frame frame{type, type == RespType::Map ? count * 2 : count, {}};
+        frame.elements.reserve(frame.remaining);
+        m_frames.push_back(std::move(frame));
+        return false;
     }
 
     std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseArray(const char* data, size_t length)
+    RespParser::parse(const char* data, size_t length)
     {
-        // 解析数组长度
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        auto len_result = parseIntegerValue(data + 1, *crlf_pos - 1);
-        if (!len_result) {
-            return std::unexpected(len_result.error());
-        }
-
-        int64_t array_len = *len_result;
-
-        // 处理空数组
-        if (array_len == -1) {
-            RedisReply result(RespType::Null, std::monostate{});
-            return std::make_pair(*crlf_pos + 2, std::move(result));
-        }
-
-        if (array_len < 0) {
-            return std::unexpected(ParseError::InvalidLength);
-        }
-
-        std::vector<RedisReply> elements;
-        elements.reserve(array_len);
-        size_t offset = *crlf_pos + 2;
+        // 调用方换了一段更短的数据，之前的进度已无意义
+        if (length < m_offset) {
+            reset();
+        }
+
+        RedisReply out;
+        while (true) {
+            // 等待bulk内容：头部已解析，只需判断数据是否到齐
+            if (m_bulk_length >= 0) {
+                size_t content_end = m_offset + static_cast<size_t>(m_bulk_length);
+                if (content_end + 2 > length) {
+                    return std::unexpected(ParseError::Incomplete);
+                }
+                if (data[content_end] != '\r' || data[content_end + 1] != '\n') {
+                    reset();
+                    return std::unexpected(ParseError::InvalidFormat);
+                }
+
+                RedisReply bulk(RespType::BulkString, std::string(data + m_offset, m_bulk_length));
+                m_offset = content_end + 2;
+                m_bulk_length = -1;
+                if (complete(std::move(bulk), out)) {
+                    break;
+                }
+                continue;
+            }
 
-        for (int64_t i = 0; i < array_len; ++i) {
-            if (offset >= length) {
+            if (m_offset >= length) {
                 return std::unexpected(ParseError::Incomplete);
             }
 
-            auto elem_result = parse(data + offset, length - offset);
-            if (!elem_result) {
-                return std::unexpected(elem_result.error());
+            // 从上次扫描断点继续查找行结束符
+            size_t line_start = m_offset + 1;
+            auto crlf_pos = findCRLF(data, length, std::max(line_start, m_scan_offset));
+            if (!crlf_pos) {
+                m_scan_offset = std::max(line_start, length - 1);
+                return std::unexpected(ParseError::Incomplete);
+            }
+            m_scan_offset = 0;
+
+            const char* line = data + line_start;
+            size_t line_len = *crlf_pos - line_start;
+            size_t next = *crlf_pos + 2;
+            char type_marker = data[m_offset];
+
+            bool done = false;
+            switch (type_marker) {
+                case '+':  // Simple String
+                    m_offset = next;
+                    done = complete(RedisReply(RespType::SimpleString, std::string(line, line_len)), out);
+                    break;
+                case '-':  // Error
+                    m_offset = next;
+                    done = complete(RedisReply(RespType::Error, std::string(line, line_len)), out);
+                    break;
+                case ':':  // Integer
+                {
+                    auto int_result = parseIntegerValue(line, line_len);
+                    if (!int_result) {
+                        reset();
+                        return std::unexpected(int_result.error());
+                    }
+                    m_offset = next;
+                    done = complete(RedisReply(RespType::Integer, *int_result), out);
+                    break;
+                }
+                case '$':  // Bulk String
+                {
+                    auto len_result = parseIntegerValue(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    m_offset = next;
+                    if (*len_result == -1) {
+                        done = complete(RedisReply(RespType::Null, std::monostate{}), out);
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        m_bulk_length = *len_result;
+                    }
+                    break;
+                }
+                case '*':  // Array
+                case '~':  // Set (RESP3)
+                case '%':  // Map (RESP3)
+                {
+                    auto len_result = parseIntegerValue(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    m_offset = next;
+                    RespType type = type_marker == '*' ? RespType::Array
+                                  : type_marker == '~' ? RespType::Set : RespType::Map;
+                    if (*len_result == -1 && type == RespType::Array) {
+                        done = complete(RedisReply(RespType::Null, std::monostate{}), out);
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        done = beginAggregate(type, *len_result, out);
+                    }
+                    break;
+                }
+                case ',':  // Double (RESP3)
+                {
+                    double value;
+                    try {
+                        value = std::stod(std::string(line, line_len));
+                    } catch (...) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    m_offset = next;
+                    done = complete(RedisReply(RespType::Double, value), out);
+                    break;
+                }
+                case '#':  // Boolean (RESP3)
+                {
+                    if (line_len != 1 || (line[0] != 't' && line[0] != 'f')) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    m_offset = next;
+                    done = complete(RedisReply(RespType::Boolean, line[0] == 't'), out);
+                    break;
+                }
+                default:
+                    reset();
+                    return std::unexpected(ParseError::InvalidType);
             }
 
-            offset += elem_result->first;
-            elements.push_back(std::move(elem_result->second));
+            if (done) {
+                break;
+            }
         }
 
-        RedisReply result(RespType::Array, std::move(elements));
-        return std::make_pair(offset, std::move(result));
+        size_t consumed = m_offset;
+        reset();
+        return std::make_pair(consumed, std::move(out));
     }
 
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseDouble(const char* data, size_t length)
+    // RespEncoder实现
+    RespEncoder::RespEncoder()
     {
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        std::string str(data + 1, *crlf_pos - 1);
-        double value;
-
-        try {
-            value = std::stod(str);
-        } catch (...) {
-            return std::unexpected(ParseError::InvalidFormat);
-        }
-
-        RedisReply result(RespType::Double, value);
-        return std::make_pair(*crlf_pos + 2, std::move(result));
     }
 
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseBoolean(const char* data, size_t length)
+    RespEncoder::~RespEncoder()
     {
-        if (length < 4) {  // #t\r\n or #f\r\n
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        bool value;
-        if (data[1] == 't') {
-            value = true;
-        } else if (data[1] == 'f') {
-            value = false;
-        } else {
-            return std::unexpected(ParseError::InvalidFormat);
-        }
-
-        if (data[2] != '\r' || data[3] != '\n') {
-            return std::unexpected(ParseError::InvalidFormat);
-        }
-
-        RedisReply result(RespType::Boolean, value);
-        return std::make_pair(4, std::move(result));
     }
 
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseMap(const char* data, size_t length)
+    size_t RespEncoder::formatInteger(int64_t value, char* buf)
     {
-        // 解析映射大小
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        auto len_result = parseIntegerValue(data + 1, *crlf_pos - 1);
-        if (!len_result) {
-            return std::unexpected(len_result.error());
-        }
-
-        int64_t map_size = *len_result;
-
-        if (map_size < 0) {
-            return std::unexpected(ParseError::InvalidLength);
-        }
-
-        std::vector<std::pair<RedisReply, RedisReply>> map_data;
-        map_data.reserve(map_size);
-        size_t offset = *crlf_pos + 2;
-
-        for (int64_t i = 0; i < map_size; ++i) {
-            // 解析key
-            if (offset >= length) {
-                return std::unexpected(ParseError::Incomplete);
-            }
-
-            auto key_result = parse(data + offset, length - offset);
-            if (!key_result) {
-                return std::unexpected(key_result.error());
-            }
-            offset += key_result->first;
-
-            // 解析value
-            if (offset >= length) {
-                return std::unexpected(ParseError::Incomplete);
-            }
-
-            auto val_result = parse(data + offset, length - offset);
-            if (!val_result) {
-                return std::unexpected(val_result.error());
-            }
-            offset += val_result->first;
-
-            map_data.emplace_back(std::move(key_result->second), std::move(val_result->second));
-        }
-
-        RedisReply result(RespType::Map, std::move(map_data));
-        return std::make_pair(offset, std::move(result));
+        return static_cast<size_t>(std::to_chars(buf, buf + kMaxNumberLength, value).ptr - buf);
     }
 
-    std::expected<std::pair<size_t, RedisReply>, ParseError>
-    RespParser::parseSet(const char* data, size_t length)
+    size_t RespEncoder::formatDouble(double value, char* buf)
     {
-        // 解析集合大小
-        auto crlf_pos = findCRLF(data, length, 1);
-        if (!crlf_pos) {
-            return std::unexpected(ParseError::Incomplete);
-        }
-
-        auto len_result = parseIntegerValue(data + 1, *crlf_pos - 1);
-        if (!len_result) {
-            return std::unexpected(len_result.error());
-        }
+        return static_cast<size_t>(std::to_chars(buf, buf + kMaxNumberLength, value).ptr - buf);
+    }
 
-        int64_t set_size = *len_result;
+    std::string RespEncoder::formatDouble(double value)
+    {
+        char buf[kMaxNumberLength];
+        return std::string(buf, formatDouble(value, buf));
+    }
 
-        if (set_size < 0) {
-            return std::unexpected(ParseError::InvalidLength);
+    size_t RespEncoder::bulkStringSize(size_t length)
+    {
+        // $ + 长度位数 + \r\n + 内容 + \r\n
+        size_t digits = 1;
+        for (size_t n = length; n >= 10; n /= 10) {
+            ++digits;
         }
+        return 1 + digits + 2 + length + 2;
+    }
 
-        std::vector<RedisReply> set_data;
-        set_data.reserve(set_size);
-        size_t offset = *crlf_pos + 2;
-
-        for (int64_t i = 0; i < set_size; ++i) {
-            if (offset >= length) {
-                return std::unexpected(ParseError::Incomplete);
-            }
-
-            auto elem_result = parse(data + offset, length - offset);
-            if (!elem_result) {
-                return std::unexpected(elem_result.error());
-            }
+    void RespEncoder::appendBulkHeader(std::string& out, size_t length)
+    {
+        char header[kMaxNumberLength];
+        size_t header_len = formatInteger(static_cast<int64_t>(length), header);
+        out.push_back('$');
+        out.append(header, header_len);
+        out.append("\r\n", 2);
+    }
 
-            offset += elem_result->first;
-            set_data.push_back(std::move(elem_result->second));
-        }
+    void RespEncoder::appendBulkString(std::string& out, std::string_view str)
+    {
+        appendBulkHeader(out, str.size());
+        out.append(str);
+        out.append("\r\n", 2);
+    }
 
-        RedisReply result(RespType::Set, std::move(set_data));
-        return std::make_pair(offset, std::move(result));
+    void RespEncoder::appendArrayHeader(std::string& out, size_t count)
+    {
+        char header[kMaxNumberLength];
+        size_t header_len = formatInteger(static_cast<int64_t>(count), header);
+        out.push_back('*');
+        out.append(header, header_len);
+        out.append("\r\n", 2);
     }
 
-    // RespEncoder实现
-    RespEncoder::RespEncoder()
+    void RespEncoder::appendInteger(std::string& out, int64_t value)
     {
+        char buf[kMaxNumberLength];
+        size_t len = formatInteger(value, buf);
+        out.push_back(':');
+        out.append(buf, len);
+        out.append("\r\n", 2);
     }
 
-    RespEncoder::~RespEncoder()
+    void RespEncoder::appendDouble(std::string& out, double value)
     {
+        char buf[kMaxNumberLength];
+        size_t len = formatDouble(value, buf);
+        out.push_back(',');
+        out.append(buf, len);
+        out.append("\r\n", 2);
     }
 
     std::string RespEncoder::encodeSimpleString(const std::string& str)
     {
-        return "+" + str + "\r\n";
+        std::string result;
+        result.reserve(str.size() + 3);
+        result.push_back('+');
+        result.append(str);
+        result.append("\r\n", 2);
+        return result;
     }
 
     std::string RespEncoder::encodeError(const std::string& error)
     {
-        return "-" + error + "\r\n";
+        std::string result;
+        result.reserve(error.size() + 3);
+        result.push_back('-');
+        result.append(error);
+        result.append("\r\n", 2);
+        return result;
     }
 
     std::string RespEncoder::encodeInteger(int64_t value)
     {
-        return ":" + std::to_string(value) + "\r\n";
+        std::string result;
+        appendInteger(result, value);
+        return result;
     }
 
     std::string RespEncoder::encodeBulkString(const std::string& str)
     {
-        return "$" + std::to_string(str.length()) + "\r\n" + str + "\r\n";
+        std::string result;
+        result.reserve(bulkStringSize(str.size()));
+        appendBulkString(result, str);
+        return result;
     }
 
     std::string RespEncoder::encodeNull()
@@ -488,39 +458,30 @@ namespace galay::redis::protocol
 
     std::string RespEncoder::encodeArray(const std::vector<std::string>& elements)
     {
-        std::string result = "*" + std::to_string(elements.size()) + "\r\n";
-        for (const auto& elem : elements) {
-            result += encodeBulkString(elem);
-        }
+        std::string result;
+        appendCommand(result, elements);
         return result;
     }
 
     std::string RespEncoder::encodeCommand(std::initializer_list<std::string> cmd_parts)
     {
-        if (cmd_parts.size() == 0) {
-            return "*0\r\n";
-        }
-
-        std::string result = "*" + std::to_string(cmd_parts.size()) + "\r\n";
-        for (const auto& part : cmd_parts) {
-            result += encodeBulkString(part);
-        }
+        std::string result;
+        appendCommand(result, cmd_parts);
         return result;
     }
 
     std::string RespEncoder::encodeCommand(const std::string& cmd, std::initializer_list<std::string> args)
     {
-        std::string result = "*" + std::to_string(1 + args.size()) + "\r\n";
-        result += encodeBulkString(cmd);
-        for (const auto& arg : args) {
-            result += encodeBulkString(arg);
-        }
+        std::string result;
+        appendCommand(result, cmd, args);
         return result;
     }
 
     std::string RespEncoder::encodeDouble(double value)
     {
-        return "," + std::to_string(value) + "\r\n";
+        std::string result;
+        appendDouble(result, value);
+        return result;
     }
 
     std::string RespEncoder::encodeBoolean(bool value)
@@ -8,6 +8,10 @@
 #include <optional>
 #include <expected>
 #include <cstdint>
+#include <string_view>
+#include <span>
+#include <charconv>
+#include <type_traits>
 
 namespace galay::redis::protocol
 {
@@ -97,6 +101,9 @@ namespace galay::redis::protocol
     };
 
     // Redis协议解析器
+    // 可恢复的增量状态机：返回 Incomplete 时保留已解析的进度（帧栈、待读bulk长度、行扫描位置），
+    // 下一次以同一帧起点、更长的数据再次调用 parse 时从断点继续，每个字节只检查一次。
+    // 若改为解析另一段不相关的数据，需先调用 reset()。
     class RespParser
     {
     public:
@@ -104,55 +111,42 @@ namespace galay::redis::protocol
         ~RespParser();
 
         // 解析RESP数据
+        // data 必须从当前帧的起点开始；Incomplete 后再次调用时 length 不能小于上次
         // 返回: pair<解析的字节数, 解析结果>
         std::expected<std::pair<size_t, RedisReply>, ParseError>
             parse(const char* data, size_t length);
 
         // 重置解析器状态
-        void reset();
+        void reset() noexcept;
 
-    private:
-        // 解析简单字符串 (+OK\r\n)
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseSimpleString(const char* data, size_t length);
-
-        // 解析错误 (-Error message\r\n)
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseError(const char* data, size_t length);
-
-        // 解析整数 (:1000\r\n)
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseInteger(const char* data, size_t length);
-
-        // 解析批量字符串 ($6\r\nfoobar\r\n)
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseBulkString(const char* data, size_t length);
+        // 是否有未完成的帧
+        bool inProgress() const noexcept { return m_offset != 0 || !m_frames.empty(); }
 
-        // 解析数组 (*2\r\n$3\r\nfoo\r\n$3\r\nbar\r\n)
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseArray(const char* data, size_t length);
-
-        // 解析双精度浮点数 (,1.23\r\n) - RESP3
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseDouble(const char* data, size_t length);
-
-        // 解析布尔值 (#t\r\n or #f\r\n) - RESP3
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseBoolean(const char* data, size_t length);
+    private:
+        // 未完成的聚合类型（Array/Set/Map），按嵌套层级入栈
+        struct Frame
+        {
+            RespType type;
+            int64_t remaining;                  // 剩余待解析元素数（Map按key和value分别计数）
+            std::vector<RedisReply> elements;
+        };
 
-        // 解析映射 (%2\r\n+key1\r\n+val1\r\n+key2\r\n+val2\r\n) - RESP3
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseMap(const char* data, size_t length);
+        // 将完成的元素挂到栈顶聚合上，逐层收尾；整帧完成时写入 out 并返回 true
+        bool complete(RedisReply&& reply, RedisReply& out);
 
-        // 解析集合 (~2\r\n+item1\r\n+item2\r\n) - RESP3
-        std::expected<std::pair<size_t, RedisReply>, ParseError>
-            parseSet(const char* data, size_t length);
+        // 聚合头部：count为0或-1时直接完成，否则入栈
+        bool beginAggregate(RespType type, int64_t count, RedisReply& out);
 
-        // 辅助函数：查找\r\n
+        // 辅助函数：查找\r\n（由RespScanner按CPU能力选择SIMD内核）
         std::optional<size_t> findCRLF(const char* data, size_t length, size_t offset = 0);
 
         // 辅助函数：解析整数
         std::expected<int64_t, ParseError> parseIntegerValue(const char* data, size_t length);
+
+        std::vector<Frame> m_frames;    // 帧栈
+        size_t m_offset = 0;            // 当前帧中已解析完成的字节数
+        size_t m_scan_offset = 0;       // 行结束符扫描断点
+        int64_t m_bulk_length = -1;     // 已读取头部、等待内容的bulk长度，-1表示无
     };
 
     // Redis协议编码器
@@ -180,7 +174,7 @@ namespace galay::redis::protocol
         // 编码数组
         std::string encodeArray(const std::vector<std::string>& elements);
 
-        // 编码Redis命令 (特殊的数组格式) - 模板化版本
+        // 编码Redis命令 (特殊的数组格式) - 模板化版本，参数可以是字符串或数值
         template<typename... Args>
         std::string encodeCommand(const std::string& cmd, Args&&... args);
 
@@ -194,76 +188,150 @@ namespace galay::redis::protocol
         // 编码完整的Redis命令 - 支持初始化列表
         std::string encodeCommand(std::initializer_list<std::string> cmd_parts);
 
-    private:
-        // 辅助函数：将参数转换为字符串
-        template<typename T>
-        std::string toString(T&& value);
+        // ======================== 追加式编码 ========================
+        // 直接追加到调用方提供的缓冲区末尾，不产生临时字符串；
+        // 命令先计算精确长度再一次 reserve，缓冲区 clear() 后可复用容量，稳定状态下零分配。
+
+        // 数值格式化所需的最大缓冲区长度
+        static constexpr size_t kMaxNumberLength = 32;
+
+        // 整数的十进制表示，返回写入长度
+        static size_t formatInteger(int64_t value, char* buf);
+
+        // 浮点数的最短往返表示（std::to_chars），返回写入长度
+        // 与 std::to_string 不同，不会丢失精度（如 ZADD 的 score）
+        static size_t formatDouble(double value, char* buf);
+        static std::string formatDouble(double value);
+
+        // $<len>\r\n<str>\r\n 的长度
+        static size_t bulkStringSize(size_t length);
+
+        // 只追加 bulk 头 "$<length>\r\n"，内容和结尾的 \r\n 由调用方另行发送（writev、sendfile）
+        static void appendBulkHeader(std::string& out, size_t length);
+        static void appendBulkString(std::string& out, std::string_view str);
+        static void appendArrayHeader(std::string& out, size_t count);
+        static void appendInteger(std::string& out, int64_t value);
+        static void appendDouble(std::string& out, double value);
 
-        // 辅助函数：递归构建命令参数
-        template<typename T, typename... Rest>
-        void buildCommandArgs(std::string& result, T&& first, Rest&&... rest);
+        // 追加命令：cmd + args，args 的元素可以是字符串（转为 string_view）或数值
+        template<typename Container>
+        static void appendCommand(std::string& out, std::string_view cmd, const Container& args);
+
+        // 追加命令：parts[0] 为命令名
+        template<typename Container>
+        static void appendCommand(std::string& out, const Container& parts);
+
+        // 追加命令：参数逐个给出，可以混合字符串和数值
+        template<typename... Args>
+        static void appendCommandArgs(std::string& out, const Args&... parts);
+
+        // 单个参数的文本：字符串直接引用，数值格式化到 buf（至少 kMaxNumberLength 字节）
+        template<typename T>
+        static std::string_view toArgument(const T& value, char* buf);
 
+    private:
         // RESP3扩展
         std::string encodeDouble(double value);
         std::string encodeBoolean(bool value);
+
+        template<typename Container>
+        static size_t partsSize(const Container& parts);
+
+        template<typename Container>
+        static void appendParts(std::string& out, const Container& parts);
     };
 
     // 模板实现必须在头文件中
     template<typename T>
-    std::string RespEncoder::toString(T&& value)
+    std::string_view RespEncoder::toArgument(const T& value, char* buf)
     {
-        if constexpr (std::is_same_v<std::decay_t<T>, std::string> ||
-                      std::is_same_v<std::decay_t<T>, const char*> ||
-                      std::is_convertible_v<T, std::string_view>) {
-            return std::string(std::forward<T>(value));
-        } else if constexpr (std::is_integral_v<std::decay_t<T>>) {
-            return std::to_string(value);
-        } else if constexpr (std::is_floating_point_v<std::decay_t<T>>) {
-            return std::to_string(value);
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return std::string_view(value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return value ? std::string_view("1") : std::string_view("0");
+        } else if constexpr (std::is_integral_v<T>) {
+            auto result = std::to_chars(buf, buf + kMaxNumberLength, value);
+            return std::string_view(buf, result.ptr - buf);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return std::string_view(buf, formatDouble(static_cast<double>(value), buf));
         } else {
-            // 对于其他类型，尝试转换为字符串
-            return std::string(value);
+            static_assert(std::is_convertible_v<const T&, std::string_view>,
+                          "command argument must be a string or a number");
+        }
+    }
+
+    template<typename Container>
+    size_t RespEncoder::partsSize(const Container& parts)
+    {
+        size_t size = 0;
+        char buf[kMaxNumberLength];
+        for (const auto& part : parts) {
+            size += bulkStringSize(toArgument(part, buf).size());
         }
+        return size;
     }
 
-    template<typename T, typename... Rest>
-    void RespEncoder::buildCommandArgs(std::string& result, T&& first, Rest&&... rest)
+    template<typename Container>
+    void RespEncoder::appendParts(std::string& out, const Container& parts)
     {
-        result += encodeBulkString(toString(std::forward<T>(first)));
-        if constexpr (sizeof...(rest) > 0) {
-            buildCommandArgs(result, std::forward<Rest>(rest)...);
+        char buf[kMaxNumberLength];
+        for (const auto& part : parts) {
+            appendBulkString(out, toArgument(part, buf));
         }
     }
 
+    template<typename Container>
+    void RespEncoder::appendCommand(std::string& out, std::string_view cmd, const Container& args)
+    {
+        size_t count = std::size(args);
+        char header[kMaxNumberLength];
+        size_t header_len = formatInteger(static_cast<int64_t>(count + 1), header);
+        out.reserve(out.size() + 3 + header_len + bulkStringSize(cmd.size()) + partsSize(args));
+        out.push_back('*');
+        out.append(header, header_len);
+        out.append("\r\n", 2);
+        appendBulkString(out, cmd);
+        appendParts(out, args);
+    }
+
+    template<typename Container>
+    void RespEncoder::appendCommand(std::string& out, const Container& parts)
+    {
+        size_t count = std::size(parts);
+        char header[kMaxNumberLength];
+        size_t header_len = formatInteger(static_cast<int64_t>(count), header);
+        out.reserve(out.size() + 3 + header_len + partsSize(parts));
+        out.push_back('*');
+        out.append(header, header_len);
+        out.append("\r\n", 2);
+        appendParts(out, parts);
+    }
+
+    template<typename... Args>
+    void RespEncoder::appendCommandArgs(std::string& out, const Args&... parts)
+    {
+        static_assert(sizeof...(Args) > 0, "command must not be empty");
+        // 数值参数格式化到栈上，整条命令按 string_view 数组一次编码
+        char numbers[sizeof...(Args)][kMaxNumberLength];
+        std::string_view views[sizeof...(Args)];
+        size_t i = 0;
+        ((views[i] = toArgument(parts, numbers[i]), ++i), ...);
+        appendCommand(out, std::span<const std::string_view>(views, sizeof...(Args)));
+    }
+
     template<typename... Args>
     std::string RespEncoder::encodeCommand(const std::string& cmd, Args&&... args)
     {
-        std::string result = "*" + std::to_string(1 + sizeof...(args)) + "\r\n";
-        result += encodeBulkString(cmd);
-        if constexpr (sizeof...(args) > 0) {
-            buildCommandArgs(result, std::forward<Args>(args)...);
-        }
+        std::string result;
+        appendCommandArgs(result, cmd, args...);
         return result;
     }
 
     template<typename Container>
     std::string RespEncoder::encodeCommand(const Container& cmd_parts)
     {
-        size_t size = 0;
-        if constexpr (requires { cmd_parts.size(); }) {
-            size = cmd_parts.size();
-        } else {
-            size = std::distance(std::begin(cmd_parts), std::end(cmd_parts));
-        }
-
-        if (size == 0) {
-            return "*0\r\n";
-        }
-
-        std::string result = "*" + std::to_string(size) + "\r\n";
-        for (const auto& part : cmd_parts) {
-            result += encodeBulkString(toString(part));
-        }
+        std::string result;
+        appendCommand(result, cmd_parts);
         return result;
     }
 
@@ -0,0 +1,339 @@
+#include "RedisReplyView.h"
+#include "RespScanner.h"
+#include <charconv>
+#include <algorithm>
+#include <limits>
+
+namespace galay::redis::protocol
+{
+    namespace
+    {
+        std::expected<int64_t, ParseError> parseInteger(const char* data, size_t length)
+        {
+            if (length == 0) {
+                return std::unexpected(ParseError::InvalidFormat);
+            }
+            const char* begin = data[0] == '+' ? data + 1 : data;
+            int64_t value = 0;
+            auto [ptr, ec] = std::from_chars(begin, data + length, value);
+            if (ec != std::errc() || ptr != data + length) {
+                return std::unexpected(ParseError::InvalidFormat);
+            }
+            return value;
+        }
+    }
+
+    // RedisReplyView实现
+    std::string_view RedisReplyView::asString() const
+    {
+        const RespViewNode& n = node();
+        switch (n.type) {
+            case RespType::SimpleString:
+            case RespType::Error:
+            case RespType::BulkString:
+                return std::string_view(m_base + n.offset, n.length);
+            default:
+                return {};
+        }
+    }
+
+    int64_t RedisReplyView::asInteger() const
+    {
+        return node().type == RespType::Integer ? node().integer : 0;
+    }
+
+    double RedisReplyView::asDouble() const
+    {
+        return node().type == RespType::Double ? node().number : 0.0;
+    }
+
+    bool RedisReplyView::asBoolean() const
+    {
+        return node().type == RespType::Boolean && node().integer != 0;
+    }
+
+    size_t RedisReplyView::size() const
+    {
+        const RespViewNode& n = node();
+        switch (n.type) {
+            case RespType::Array:
+            case RespType::Set:
+                return n.child_count;
+            case RespType::Map:
+                return n.child_count / 2;
+            default:
+                return 0;
+        }
+    }
+
+    RedisReplyView RedisReplyView::at(size_t index) const
+    {
+        return RedisReplyView(m_base, m_nodes, node().child_begin + static_cast<uint32_t>(index));
+    }
+
+    RedisReplyView RedisReplyView::key(size_t index) const
+    {
+        return RedisReplyView(m_base, m_nodes, node().child_begin + static_cast<uint32_t>(index * 2));
+    }
+
+    RedisReplyView RedisReplyView::value(size_t index) const
+    {
+        return RedisReplyView(m_base, m_nodes, node().child_begin + static_cast<uint32_t>(index * 2 + 1));
+    }
+
+    RedisReply RedisReplyView::toReply() const
+    {
+        const RespViewNode& n = node();
+        switch (n.type) {
+            case RespType::SimpleString:
+            case RespType::Error:
+            case RespType::BulkString:
+                return RedisReply(n.type, std::string(asString()));
+            case RespType::Integer:
+                return RedisReply(n.type, n.integer);
+            case RespType::Double:
+                return RedisReply(n.type, n.number);
+            case RespType::Boolean:
+                return RedisReply(n.type, n.integer != 0);
+            case RespType::Array:
+            case RespType::Set:
+            {
+                std::vector<RedisReply> elements;
+                elements.reserve(n.child_count);
+                for (size_t i = 0; i < n.child_count; ++i) {
+                    elements.push_back(at(i).toReply());
+                }
+                return RedisReply(n.type, std::move(elements));
+            }
+            case RespType::Map:
+            {
+                std::vector<std::pair<RedisReply, RedisReply>> entries;
+                entries.reserve(size());
+                for (size_t i = 0; i < size(); ++i) {
+                    entries.emplace_back(key(i).toReply(), value(i).toReply());
+                }
+                return RedisReply(n.type, std::move(entries));
+            }
+            default:
+                return RedisReply(RespType::Null, std::monostate{});
+        }
+    }
+
+    // RespViewParser实现
+    void RespViewParser::reset() noexcept
+    {
+        m_frames.clear();
+        m_offset = 0;
+        m_scan_offset = 0;
+        m_bulk_length = -1;
+        m_bulk_slot = 0;
+    }
+
+    uint32_t RespViewParser::nextSlot(std::vector<RespViewNode>& nodes)
+    {
+        if (m_frames.empty()) {
+            // 根节点
+            nodes.clear();
+            nodes.emplace_back();
+            return 0;
+        }
+        return m_frames.back().next;
+    }
+
+    bool RespViewParser::complete()
+    {
+        if (m_frames.empty()) {
+            return true;
+        }
+        // 父聚合的槽位在头部到达时已填写，这里只需推进各层的填充位置
+        while (!m_frames.empty()) {
+            Frame& top = m_frames.back();
+            if (++top.next < top.end) {
+                return false;
+            }
+            m_frames.pop_back();
+        }
+        return true;
+    }
+
+    std::expected<size_t, ParseError>
+    RespViewParser::parse(const char* data, size_t length, std::vector<RespViewNode>& nodes)
+    {
+        if (length < m_offset) {
+            reset();
+        }
+
+        while (true) {
+            if (m_bulk_length >= 0) {
+                size_t content_end = m_offset + static_cast<size_t>(m_bulk_length);
+                if (content_end + 2 > length) {
+                    return std::unexpected(ParseError::Incomplete);
+                }
+                if (data[content_end] != '\r' || data[content_end + 1] != '\n') {
+                    reset();
+                    return std::unexpected(ParseError::InvalidFormat);
+                }
+
+                RespViewNode& bulk = nodes[m_bulk_slot];
+                bulk.type = RespType::BulkString;
+                bulk.offset = m_offset;
+                bulk.length = static_cast<size_t>(m_bulk_length);
+                m_offset = content_end + 2;
+                m_bulk_length = -1;
+                if (complete()) {
+                    break;
+                }
+                continue;
+            }
+
+            if (m_offset >= length) {
+                return std::unexpected(ParseError::Incomplete);
+            }
+
+            size_t line_start = m_offset + 1;
+            size_t crlf_pos = RespScanner::findCRLF(data, length, std::max(line_start, m_scan_offset));
+            if (crlf_pos == RespScanner::npos) {
+                m_scan_offset = std::max(line_start, length - 1);
+                return std::unexpected(ParseError::Incomplete);
+            }
+            m_scan_offset = 0;
+
+            const char* line = data + line_start;
+            size_t line_len = crlf_pos - line_start;
+            size_t next = crlf_pos + 2;
+            char type_marker = data[m_offset];
+
+            uint32_t slot = nextSlot(nodes);
+            RespViewNode& node = nodes[slot];
+            node.child_begin = 0;
+            node.child_count = 0;
+
+            bool done = false;
+            switch (type_marker) {
+                case '+':  // Simple String
+                case '-':  // Error
+                    node.type = type_marker == '+' ? RespType::SimpleString : RespType::Error;
+                    node.offset = line_start;
+                    node.length = line_len;
+                    m_offset = next;
+                    done = complete();
+                    break;
+                case ':':  // Integer
+                {
+                    auto int_result = parseInteger(line, line_len);
+                    if (!int_result) {
+                        reset();
+                        return std::unexpected(int_result.error());
+                    }
+                    node.type = RespType::Integer;
+                    node.integer = *int_result;
+                    m_offset = next;
+                    done = complete();
+                    break;
+                }
+                case '$':  // Bulk String
+                {
+                    auto len_result = parseInteger(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    m_offset = next;
+                    if (*len_result == -1) {
+                        node.type = RespType::Null;
+                        done = complete();
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        m_bulk_length = *len_result;
+                        m_bulk_slot = slot;
+                    }
+                    break;
+                }
+                case '*':  // Array
+                case '~':  // Set (RESP3)
+                case '%':  // Map (RESP3)
+                {
+                    auto len_result = parseInteger(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    RespType type = type_marker == '*' ? RespType::Array
+                                  : type_marker == '~' ? RespType::Set : RespType::Map;
+                    if (*len_result == -1 && type == RespType::Array) {
+                        m_offset = next;
+                        node.type = RespType::Null;
+                        done = complete();
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        uint64_t elements = static_cast<uint64_t>(*len_result) * (type == RespType::Map ? 2 : 1);
+                        // 节点下标是 uint32_t，超出范围的个数无法表示
+                        if (elements > std::numeric_limits<uint32_t>::max() - nodes.size()) {
+                            reset();
+                            return std::unexpected(ParseError::InvalidLength);
+                        }
+                        // 每个元素至少 3 字节（如 "+\r\n"）。已到达的数据放不下这么多元素时先不预留槽位，
+                        // 停在头部等待更多数据，预留的内存不会超过实际收到的字节数
+                        if (elements > (length - next) / 3) {
+                            return std::unexpected(ParseError::Incomplete);
+                        }
+                        m_offset = next;
+                        // 一次性预留全部子节点槽位，保证子节点连续
+                        uint32_t count = static_cast<uint32_t>(elements);
+                        uint32_t begin = static_cast<uint32_t>(nodes.size());
+                        node.type = type;
+                        node.child_begin = begin;
+                        node.child_count = count;
+                        if (count == 0) {
+                            done = complete();
+                        } else {
+                            nodes.resize(nodes.size() + count);
+                            m_frames.push_back(Frame{begin, begin + count});
+                        }
+                    }
+                    break;
+                }
+                case ',':  // Double (RESP3)
+                {
+                    double value = 0;
+                    auto [ptr, ec] = std::from_chars(line, line + line_len, value);
+                    if (ec != std::errc() || ptr != line + line_len) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    node.type = RespType::Double;
+                    node.number = value;
+                    m_offset = next;
+                    done = complete();
+                    break;
+                }
+                case '#':  // Boolean (RESP3)
+                {
+                    if (line_len != 1 || (line[0] != 't' && line[0] != 'f')) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    node.type = RespType::Boolean;
+                    node.integer = line[0] == 't' ? 1 : 0;
+                    m_offset = next;
+                    done = complete();
+                    break;
+                }
+                default:
+                    reset();
+                    return std::unexpected(ParseError::InvalidType);
+            }
+            if (done) {
+                break;
+            }
+        }
+
+        size_t consumed = m_offset;
+        reset();
+        return consumed;
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef GALAY_REDIS_REPLY_VIEW_H
+#define GALAY_REDIS_REPLY_VIEW_H
+
+#include "RedisProtocol.h"
+#include <string_view>
+#include <cstdint>
+
+namespace galay::redis::protocol
+{
+    // 借用式回复的节点（POD）
+    // 字符串不拷贝，只记录相对帧起点的偏移和长度；聚合类型的子节点在节点数组中连续存放
+    struct RespViewNode
+    {
+        RespType type = RespType::Null;
+        uint32_t child_begin = 0;   // 子节点起始下标（Array/Set/Map）
+        uint32_t child_count = 0;   // 子节点数（Map为键值总数）
+        size_t offset = 0;          // 字符串内容相对帧起点的偏移
+        size_t length = 0;          // 字符串内容长度
+        int64_t integer = 0;        // Integer / Boolean
+        double number = 0;          // Double
+    };
+
+    // 借用式回复：节点数组 + 帧数据，均不归本对象所有
+    // 有效期取决于底层数据（接收缓冲区）何时被释放
+    class RedisReplyView
+    {
+    public:
+        RedisReplyView() = default;
+        RedisReplyView(const char* base, const RespViewNode* nodes, uint32_t index = 0)
+            : m_base(base), m_nodes(nodes), m_index(index) {}
+
+        bool valid() const { return m_nodes != nullptr; }
+
+        // 在节点数组中的下标
+        uint32_t index() const { return m_index; }
+
+        // 类型判断
+        RespType getType() const { return node().type; }
+        bool isSimpleString() const { return getType() == RespType::SimpleString; }
+        bool isError() const { return getType() == RespType::Error; }
+        bool isInteger() const { return getType() == RespType::Integer; }
+        bool isBulkString() const { return getType() == RespType::BulkString; }
+        bool isArray() const { return getType() == RespType::Array; }
+        bool isNull() const { return getType() == RespType::Null; }
+        bool isDouble() const { return getType() == RespType::Double; }
+        bool isBoolean() const { return getType() == RespType::Boolean; }
+        bool isMap() const { return getType() == RespType::Map; }
+        bool isSet() const { return getType() == RespType::Set; }
+        bool isPush() const { return getType() == RespType::Push; }
+
+        // 获取值（字符串直接指向接收缓冲区）
+        std::string_view asString() const;
+        int64_t asInteger() const;
+        double asDouble() const;
+        bool asBoolean() const;
+
+        // 聚合类型：数组/集合的元素数，Map的键值对数
+        size_t size() const;
+        RedisReplyView at(size_t index) const;
+        RedisReplyView operator[](size_t index) const { return at(index); }
+        RedisReplyView key(size_t index) const;
+        RedisReplyView value(size_t index) const;
+
+        // 物化为独立的 RedisReply（会拷贝字符串）
+        RedisReply toReply() const;
+
+    private:
+        const RespViewNode& node() const { return m_nodes[m_index]; }
+
+        const char* m_base = nullptr;
+        const RespViewNode* m_nodes = nullptr;
+        uint32_t m_index = 0;
+    };
+
+    // 借用式回复解析器
+    // 与 RespParser 相同的可恢复状态机，但不构造 RedisReply：每个值写入调用方提供的节点数组，
+    // 聚合头部到达时一次性为全部子节点预留连续槽位，字符串只记录偏移。
+    // 由于只记录偏移，Incomplete 后帧数据可以整体搬移（例如环形缓冲区回绕时拷贝到连续内存）再继续解析。
+    class RespViewParser
+    {
+    public:
+        // 解析一帧，nodes 在首次调用时被清空并复用容量，根节点为 nodes[0]
+        // data 必须从当前帧的起点开始；返回整帧字节数
+        std::expected<size_t, ParseError> parse(const char* data, size_t length,
+                                                std::vector<RespViewNode>& nodes);
+
+        // 重置解析器状态
+        void reset() noexcept;
+
+        // 是否有未完成的帧
+        bool inProgress() const noexcept { return m_offset != 0 || !m_frames.empty(); }
+
+    private:
+        // 未填满的聚合类型：[next, end) 为尚未填充的子节点槽位
+        struct Frame
+        {
+            uint32_t next;
+            uint32_t end;
+        };
+
+        // 取下一个待填充的槽位
+        uint32_t nextSlot(std::vector<RespViewNode>& nodes);
+
+        // 一个值填充完成，逐层弹出已填满的聚合；整帧完成返回 true
+        bool complete();
+
+        std::vector<Frame> m_frames;
+        size_t m_offset = 0;            // 当前帧中已解析完成的字节数
+        size_t m_scan_offset = 0;       // 行结束符扫描断点
+        int64_t m_bulk_length = -1;     // 已读取头部、等待内容的bulk长度，-1表示无
+        uint32_t m_bulk_slot = 0;       // 等待内容的bulk所在槽位
+    };
+}
+
+#endif // GALAY_REDIS_REPLY_VIEW_H
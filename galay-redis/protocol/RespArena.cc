@@ -0,0 +1,76 @@
+#include "RespArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace galay::redis::protocol
+{
+    // RespArena实现
+    RespArena::RespArena(size_t initial_block_size)
+        : m_next_block_size(initial_block_size)
+    {
+    }
+
+    RespArena::~RespArena()
+    {
+        release();
+    }
+
+    void RespArena::release() noexcept
+    {
+        while (m_head) {
+            Block* next = m_head->next;
+            ::operator delete(m_head);
+            m_head = next;
+        }
+        m_cursor = nullptr;
+        m_end = nullptr;
+        m_block_count = 0;
+        m_bytes_used = 0;
+    }
+
+    void* RespArena::do_allocate(size_t bytes, size_t alignment)
+    {
+        auto align_up = [alignment](char* p) {
+            auto value = reinterpret_cast<uintptr_t>(p);
+            return reinterpret_cast<char*>((value + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        };
+
+        char* aligned = m_cursor ? align_up(m_cursor) : nullptr;
+        if (!aligned || aligned + bytes > m_end) {
+            // 当前块放不下，申请新块：至少能容纳本次请求，之后按倍数增长
+            size_t need = sizeof(Block) + bytes + alignment;
+            size_t size = std::max(m_next_block_size, need);
+            auto* block = static_cast<Block*>(::operator new(size));
+            block->next = m_head;
+            block->size = size;
+            m_head = block;
+            m_cursor = reinterpret_cast<char*>(block + 1);
+            m_end = reinterpret_cast<char*>(block) + size;
+            m_next_block_size = size * 2;
+            ++m_block_count;
+            aligned = align_up(m_cursor);
+        }
+
+        m_cursor = aligned + bytes;
+        m_bytes_used += bytes;
+        return aligned;
+    }
+
+    // RespArenaReply实现
+    RespArenaReply::RespArenaReply(const char* frame, size_t length, const std::vector<RespViewNode>& nodes)
+        // 一次申请恰好容纳节点和帧的块
+        : m_arena(sizeof(RespViewNode) * nodes.size() + length + 64)
+        , m_node_count(nodes.size())
+    {
+        auto* node_storage = static_cast<RespViewNode*>(
+            m_arena.allocate(sizeof(RespViewNode) * nodes.size(), alignof(RespViewNode)));
+        std::memcpy(static_cast<void*>(node_storage), nodes.data(), sizeof(RespViewNode) * nodes.size());
+        m_nodes = node_storage;
+
+        auto* data = static_cast<char*>(m_arena.allocate(length, 1));
+        std::memcpy(data, frame, length);
+        m_data = data;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef GALAY_REDIS_RESP_ARENA_H
+#define GALAY_REDIS_RESP_ARENA_H
+
+#include "RedisReplyView.h"
+#include <memory_resource>
+#include <memory>
+
+namespace galay::redis::protocol
+{
+    // 单调递增的bump分配器
+    // 从大块内存中顺序切分，单个释放是空操作，析构或 release() 时整块归还，耗时与元素数量无关
+    class RespArena : public std::pmr::memory_resource
+    {
+    public:
+        explicit RespArena(size_t initial_block_size = 4096);
+        ~RespArena() override;
+
+        RespArena(const RespArena&) = delete;
+        RespArena& operator=(const RespArena&) = delete;
+
+        // 归还所有块
+        void release() noexcept;
+
+        // 向系统申请过的块数
+        size_t blockCount() const { return m_block_count; }
+
+        // 已切分出去的字节数
+        size_t bytesUsed() const { return m_bytes_used; }
+
+    private:
+        struct Block
+        {
+            Block* next;
+            size_t size;
+        };
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void*, size_t, size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        Block* m_head = nullptr;
+        char* m_cursor = nullptr;
+        char* m_end = nullptr;
+        size_t m_next_block_size;
+        size_t m_block_count = 0;
+        size_t m_bytes_used = 0;
+    };
+
+    // 位于arena中的完整回复：帧字节与节点数组放在同一块内存里
+    // 由 RespViewParser 的解析结果构造，字符串随帧一次拷入，之后与接收缓冲区无关
+    class RespArenaReply
+    {
+    public:
+        RespArenaReply(const char* frame, size_t length, const std::vector<RespViewNode>& nodes);
+
+        RespArenaReply(const RespArenaReply&) = delete;
+        RespArenaReply& operator=(const RespArenaReply&) = delete;
+
+        RedisReplyView view(uint32_t index = 0) const
+        {
+            return RedisReplyView(m_data, m_nodes, index);
+        }
+
+        size_t nodeCount() const { return m_node_count; }
+        const RespArena& arena() const { return m_arena; }
+
+    private:
+        RespArena m_arena;
+        const char* m_data = nullptr;
+        const RespViewNode* m_nodes = nullptr;
+        size_t m_node_count = 0;
+    };
+}
+
+#endif // GALAY_REDIS_RESP_ARENA_H
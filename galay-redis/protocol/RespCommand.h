@@ -0,0 +1,139 @@
+#ifndef GALAY_REDIS_RESP_COMMAND_H
+#define GALAY_REDIS_RESP_COMMAND_H
+
+#include "RedisProtocol.h"
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace galay::redis::protocol
+{
+    // 可作为模板参数的字符串字面量
+    template<size_t N>
+    struct FixedString
+    {
+        char data[N] = {};
+
+        constexpr FixedString(const char (&str)[N])
+        {
+            for (size_t i = 0; i < N; ++i) {
+                data[i] = str[i];
+            }
+        }
+
+        constexpr size_t size() const { return N - 1; }
+        constexpr std::string_view view() const { return std::string_view(data, N - 1); }
+    };
+
+    namespace detail
+    {
+        constexpr size_t decimalDigits(size_t value)
+        {
+            size_t digits = 1;
+            while (value >= 10) {
+                value /= 10;
+                ++digits;
+            }
+            return digits;
+        }
+
+        constexpr char* writeDecimal(char* out, size_t value)
+        {
+            size_t digits = decimalDigits(value);
+            for (size_t i = digits; i > 0; --i) {
+                out[i - 1] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+            return out + digits;
+        }
+    }
+
+    /**
+     * @brief 固定参数个数的命令
+     * @details 数组头 "*<Arity+1>\r\n" 和命令名 bulk "$<len>\r\n<Name>\r\n" 在编译期生成到静态存储，
+     *          运行时只编码参数。参数可以是字符串或数值（整数、最短往返表示的浮点数）。
+     *
+     * @code
+     * std::string out;
+     * Command<"SET", 2>::append(out, key, value);
+     * auto encoded = Command<"EXPIRE", 2>::encode(key, 60);
+     * @endcode
+     */
+    template<FixedString Name, size_t Arity>
+    class Command
+    {
+    public:
+        static constexpr size_t kArity = Arity;
+
+        // 预编码的数组头和命令名
+        static constexpr std::string_view prefix()
+        {
+            return std::string_view(kPrefix.data(), kPrefix.size());
+        }
+
+        static constexpr std::string_view name()
+        {
+            return Name.view();
+        }
+
+        // 追加到缓冲区末尾，先计算精确长度再一次 reserve
+        template<typename... Args>
+            requires (sizeof...(Args) == Arity)
+        static void append(std::string& out, const Args&... args)
+        {
+            if constexpr (Arity == 0) {
+                out.append(prefix());
+            } else {
+                char numbers[Arity][RespEncoder::kMaxNumberLength];
+                std::string_view views[Arity];
+                size_t i = 0;
+                ((views[i] = RespEncoder::toArgument(args, numbers[i]), ++i), ...);
+
+                size_t size = kPrefix.size();
+                for (const auto& view : views) {
+                    size += RespEncoder::bulkStringSize(view.size());
+                }
+                out.reserve(out.size() + size);
+                out.append(prefix());
+                for (const auto& view : views) {
+                    RespEncoder::appendBulkString(out, view);
+                }
+            }
+        }
+
+        template<typename... Args>
+            requires (sizeof...(Args) == Arity)
+        static std::string encode(const Args&... args)
+        {
+            std::string out;
+            append(out, args...);
+            return out;
+        }
+
+    private:
+        static constexpr size_t kPrefixSize =
+            1 + detail::decimalDigits(Arity + 1) + 2 +
+            1 + detail::decimalDigits(Name.size()) + 2 + Name.size() + 2;
+
+        static constexpr std::array<char, kPrefixSize> kPrefix = [] {
+            std::array<char, kPrefixSize> buf{};
+            char* p = buf.data();
+            *p++ = '*';
+            p = detail::writeDecimal(p, Arity + 1);
+            *p++ = '\r';
+            *p++ = '\n';
+            *p++ = '$';
+            p = detail::writeDecimal(p, Name.size());
+            *p++ = '\r';
+            *p++ = '\n';
+            for (size_t i = 0; i < Name.size(); ++i) {
+                *p++ = Name.data[i];
+            }
+            *p++ = '\r';
+            *p++ = '\n';
+            return buf;
+        }();
+    };
+}
+
+#endif // GALAY_REDIS_RESP_COMMAND_H
@@ -0,0 +1,347 @@
+#ifndef GALAY_REDIS_RESP_DECODE_H
+#define GALAY_REDIS_RESP_DECODE_H
+
+#include "RedisReplyView.h"
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <tuple>
+#include <utility>
+#include <expected>
+#include <charconv>
+#include <concepts>
+#include <type_traits>
+
+namespace galay::redis::protocol
+{
+    // 类型化解码错误
+    enum class DecodeError
+    {
+        TypeMismatch,       // RESP类型与目标类型不匹配
+        SizeMismatch,       // 元素数与 pair/tuple/结构体字段数不一致
+        InvalidNumber,      // 字符串无法转换为数值或超出范围
+        UnexpectedNull      // 目标类型不是 std::optional 却收到 Null
+    };
+
+    inline const char* decodeErrorString(DecodeError error)
+    {
+        switch (error) {
+            case DecodeError::TypeMismatch: return "reply type mismatch";
+            case DecodeError::SizeMismatch: return "reply size mismatch";
+            case DecodeError::InvalidNumber: return "invalid number in reply";
+            case DecodeError::UnexpectedNull: return "unexpected null reply";
+        }
+        return "decode error";
+    }
+
+    using DecodeResult = std::expected<void, DecodeError>;
+
+    // 解码器：把一个回复节点直接写入 C++ 对象，编译期按目标类型分发
+    // 自定义类型可以特化 RespDecoder<T>，提供 static DecodeResult decode(const RedisReplyView&, T&)；
+    // 或在结构体中声明 resp_fields（成员指针元组），按数组位置依次解码：
+    // @code
+    // struct Entry {
+    //     std::string id;
+    //     int64_t score;
+    //     static constexpr auto resp_fields = std::make_tuple(&Entry::id, &Entry::score);
+    // };
+    // @endcode
+    template<typename T, typename Enable = void>
+    struct RespDecoder;
+
+    template<typename T>
+    concept RespDecodable = requires(const RedisReplyView& view, T& out) {
+        { RespDecoder<T>::decode(view, out) } -> std::same_as<DecodeResult>;
+    };
+
+    template<typename T>
+    DecodeResult decodeInto(const RedisReplyView& view, T& out)
+    {
+        return RespDecoder<T>::decode(view, out);
+    }
+
+    // 解码为新对象
+    template<typename T>
+    std::expected<T, DecodeError> decode(const RedisReplyView& view)
+    {
+        T out{};
+        auto result = RespDecoder<T>::decode(view, out);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+        return out;
+    }
+
+    namespace detail
+    {
+        template<typename T>
+        struct IsPair : std::false_type {};
+        template<typename A, typename B>
+        struct IsPair<std::pair<A, B>> : std::true_type {};
+
+        template<typename T>
+        DecodeResult parseNumber(std::string_view text, T& out)
+        {
+            const char* begin = text.data();
+            const char* end = text.data() + text.size();
+            if (begin != end && *begin == '+') {
+                ++begin;
+            }
+            auto [ptr, ec] = std::from_chars(begin, end, out);
+            if (ec != std::errc() || ptr != end || begin == end) {
+                return std::unexpected(DecodeError::InvalidNumber);
+            }
+            return {};
+        }
+
+        inline bool isStringType(const RedisReplyView& view)
+        {
+            return view.isBulkString() || view.isSimpleString();
+        }
+
+        inline bool isSequence(const RedisReplyView& view)
+        {
+            return view.isArray() || view.isSet();
+        }
+
+        // 逐个解码键值对：RESP3 Map，或 RESP2 中 key/value 交替的扁平数组（HGETALL、WITHSCORES）
+        template<typename K, typename V, typename Emit>
+        DecodeResult decodePairs(const RedisReplyView& view, Emit&& emit)
+        {
+            size_t pairs = 0;
+            if (view.isMap()) {
+                pairs = view.size();
+            } else if (isSequence(view) && view.size() % 2 == 0) {
+                pairs = view.size() / 2;
+            } else {
+                return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+            }
+            // Map的键值与扁平数组的元素在节点数组中都是 key0, value0, key1, value1 ... 连续存放
+            for (size_t i = 0; i < pairs; ++i) {
+                K key{};
+                V value{};
+                if (auto r = RespDecoder<K>::decode(view.at(i * 2), key); !r) return r;
+                if (auto r = RespDecoder<V>::decode(view.at(i * 2 + 1), value); !r) return r;
+                emit(std::move(key), std::move(value));
+            }
+            return {};
+        }
+
+        template<typename Tuple, size_t... I>
+        DecodeResult decodeTuple(const RedisReplyView& view, Tuple& out, std::index_sequence<I...>)
+        {
+            if (!isSequence(view)) {
+                return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+            }
+            if (view.size() != sizeof...(I)) {
+                return std::unexpected(DecodeError::SizeMismatch);
+            }
+            DecodeResult result;
+            // 按顺序解码，遇到第一个错误即停止
+            ((result = RespDecoder<std::tuple_element_t<I, Tuple>>::decode(view.at(I), std::get<I>(out)))
+                && ...);
+            return result;
+        }
+
+        template<typename T, typename Fields, size_t... I>
+        DecodeResult decodeFields(const RedisReplyView& view, T& out, const Fields& fields, std::index_sequence<I...>)
+        {
+            if (!isSequence(view)) {
+                return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+            }
+            if (view.size() != sizeof...(I)) {
+                return std::unexpected(DecodeError::SizeMismatch);
+            }
+            DecodeResult result;
+            ((result = decodeInto(view.at(I), out.*(std::get<I>(fields)))) && ...);
+            return result;
+        }
+    }
+
+    // 整数：Integer，或内容为整数的字符串（如 GET 计数器）
+    template<typename T>
+    struct RespDecoder<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, T& out)
+        {
+            if (view.isInteger()) {
+                int64_t value = view.asInteger();
+                if (!std::in_range<T>(value)) {
+                    return std::unexpected(DecodeError::InvalidNumber);
+                }
+                out = static_cast<T>(value);
+                return {};
+            }
+            if (detail::isStringType(view)) {
+                return detail::parseNumber(view.asString(), out);
+            }
+            return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+        }
+    };
+
+    // 浮点：Double、Integer，或内容为数值的字符串（如 ZSCORE）
+    template<typename T>
+    struct RespDecoder<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, T& out)
+        {
+            if (view.isDouble()) {
+                out = static_cast<T>(view.asDouble());
+                return {};
+            }
+            if (view.isInteger()) {
+                out = static_cast<T>(view.asInteger());
+                return {};
+            }
+            if (detail::isStringType(view)) {
+                return detail::parseNumber(view.asString(), out);
+            }
+            return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+        }
+    };
+
+    // 布尔：Boolean，或 0/1 整数（如 EXISTS、SISMEMBER）
+    template<>
+    struct RespDecoder<bool>
+    {
+        static DecodeResult decode(const RedisReplyView& view, bool& out)
+        {
+            if (view.isBoolean()) {
+                out = view.asBoolean();
+                return {};
+            }
+            if (view.isInteger()) {
+                out = view.asInteger() != 0;
+                return {};
+            }
+            return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+        }
+    };
+
+    template<>
+    struct RespDecoder<std::string>
+    {
+        static DecodeResult decode(const RedisReplyView& view, std::string& out)
+        {
+            if (!detail::isStringType(view)) {
+                return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+            }
+            out.assign(view.asString());
+            return {};
+        }
+    };
+
+    // Null 解码为 std::nullopt
+    template<typename T>
+    struct RespDecoder<std::optional<T>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, std::optional<T>& out)
+        {
+            if (view.isNull()) {
+                out.reset();
+                return {};
+            }
+            return RespDecoder<T>::decode(view, out.emplace());
+        }
+    };
+
+    // 数组/集合逐元素解码；元素为 pair 时也接受 Map 和 key/value 交替的扁平数组
+    template<typename T, typename Alloc>
+    struct RespDecoder<std::vector<T, Alloc>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, std::vector<T, Alloc>& out)
+        {
+            out.clear();
+            if constexpr (detail::IsPair<T>::value) {
+                bool nested = detail::isSequence(view) && view.size() > 0 && detail::isSequence(view.at(0));
+                if (!nested) {
+                    out.reserve(view.isMap() ? view.size() : view.size() / 2);
+                    return detail::decodePairs<typename T::first_type, typename T::second_type>(
+                        view, [&out](auto&& key, auto&& value) {
+                            out.emplace_back(std::move(key), std::move(value));
+                        });
+                }
+            }
+            if (!detail::isSequence(view)) {
+                return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+            }
+            out.resize(view.size());
+            for (size_t i = 0; i < out.size(); ++i) {
+                if (auto r = RespDecoder<T>::decode(view.at(i), out[i]); !r) {
+                    return r;
+                }
+            }
+            return {};
+        }
+    };
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    struct RespDecoder<std::unordered_map<K, V, Hash, Eq, Alloc>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, std::unordered_map<K, V, Hash, Eq, Alloc>& out)
+        {
+            out.clear();
+            out.reserve(view.isMap() ? view.size() : view.size() / 2);
+            return detail::decodePairs<K, V>(view, [&out](auto&& key, auto&& value) {
+                out.insert_or_assign(std::move(key), std::move(value));
+            });
+        }
+    };
+
+    template<typename K, typename V, typename Cmp, typename Alloc>
+    struct RespDecoder<std::map<K, V, Cmp, Alloc>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, std::map<K, V, Cmp, Alloc>& out)
+        {
+            out.clear();
+            return detail::decodePairs<K, V>(view, [&out](auto&& key, auto&& value) {
+                out.insert_or_assign(std::move(key), std::move(value));
+            });
+        }
+    };
+
+    // 两个元素的数组
+    template<typename A, typename B>
+    struct RespDecoder<std::pair<A, B>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, std::pair<A, B>& out)
+        {
+            if (!detail::isSequence(view)) {
+                return std::unexpected(view.isNull() ? DecodeError::UnexpectedNull : DecodeError::TypeMismatch);
+            }
+            if (view.size() != 2) {
+                return std::unexpected(DecodeError::SizeMismatch);
+            }
+            if (auto r = RespDecoder<A>::decode(view.at(0), out.first); !r) {
+                return r;
+            }
+            return RespDecoder<B>::decode(view.at(1), out.second);
+        }
+    };
+
+    // 元素数与元组长度一致的数组
+    template<typename... Ts>
+    struct RespDecoder<std::tuple<Ts...>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, std::tuple<Ts...>& out)
+        {
+            return detail::decodeTuple(view, out, std::index_sequence_for<Ts...>{});
+        }
+    };
+
+    // 声明了 resp_fields 的结构体：按数组位置依次解码各字段
+    template<typename T>
+    struct RespDecoder<T, std::void_t<decltype(T::resp_fields)>>
+    {
+        static DecodeResult decode(const RedisReplyView& view, T& out)
+        {
+            constexpr size_t N = std::tuple_size_v<std::remove_cvref_t<decltype(T::resp_fields)>>;
+            return detail::decodeFields(view, out, T::resp_fields, std::make_index_sequence<N>{});
+        }
+    };
+}
+
+#endif // GALAY_REDIS_RESP_DECODE_H
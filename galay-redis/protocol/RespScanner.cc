@@ -0,0 +1,169 @@
+#include "RespScanner.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define GALAY_REDIS_SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace galay::redis::protocol
+{
+    namespace
+    {
+        size_t findCRLFScalar(const char* data, size_t length, size_t offset)
+        {
+            for (size_t i = offset; i + 1 < length; ++i) {
+                if (data[i] == '\r' && data[i + 1] == '\n') {
+                    return i;
+                }
+            }
+            return RespScanner::npos;
+        }
+
+#ifdef GALAY_REDIS_SCANNER_X86
+        // 每组同时比较 data[i..i+15] == '\r' 与 data[i+1..i+16] == '\n'，
+        // 两个掩码相与后最低位即第一个\r\n，跨组边界的\r\n也能被发现
+        __attribute__((target("sse2")))
+        inline unsigned crlfMask16(const char* p)
+        {
+            __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+            return static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(cur, _mm_set1_epi8('\r')),
+                              _mm_cmpeq_epi8(next, _mm_set1_epi8('\n')))));
+        }
+
+        __attribute__((target("sse2")))
+        size_t findCRLFSSE2(const char* data, size_t length, size_t offset)
+        {
+            size_t i = offset;
+            for (; i + 17 <= length; i += 16) {
+                unsigned mask = crlfMask16(data + i);
+                if (mask != 0) {
+                    return i + static_cast<size_t>(__builtin_ctz(mask));
+                }
+            }
+            return findCRLFScalar(data, length, i);
+        }
+
+        __attribute__((target("avx2")))
+        size_t findCRLFAVX2(const char* data, size_t length, size_t offset)
+        {
+            const __m256i cr = _mm256_set1_epi8('\r');
+            const __m256i lf = _mm256_set1_epi8('\n');
+
+            size_t i = offset;
+            // 大多数RESP行（整数、长度头、短状态）不足16字节，先用一次16字节探测避免32字节加载的开销
+            if (i + 17 <= length) {
+                unsigned mask = crlfMask16(data + i);
+                if (mask != 0) {
+                    return i + static_cast<size_t>(__builtin_ctz(mask));
+                }
+                i += 16;
+            }
+            for (; i + 33 <= length; i += 32) {
+                __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 1));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(cur, cr), _mm256_cmpeq_epi8(next, lf))));
+                if (mask != 0) {
+                    return i + static_cast<size_t>(__builtin_ctz(mask));
+                }
+            }
+            // 剩余不足一组时用SSE2收尾
+            return findCRLFSSE2(data, length, i);
+        }
+#endif
+
+        using ScanFunction = size_t (*)(const char*, size_t, size_t);
+
+        ScanFunction resolve(RespScanner::Kernel kernel)
+        {
+#ifdef GALAY_REDIS_SCANNER_X86
+            if (RespScanner::isSupported(kernel)) {
+                switch (kernel) {
+                    case RespScanner::Kernel::AVX2: return findCRLFAVX2;
+                    case RespScanner::Kernel::SSE2: return findCRLFSSE2;
+                    default: break;
+                }
+            }
+#endif
+            (void)kernel;
+            return findCRLFScalar;
+        }
+
+        // 按Kernel枚举值索引，CPU检测只做一次
+        ScanFunction functionOf(RespScanner::Kernel kernel)
+        {
+            static const ScanFunction table[] = {
+                resolve(RespScanner::Kernel::Scalar),
+                resolve(RespScanner::Kernel::SSE2),
+                resolve(RespScanner::Kernel::AVX2)
+            };
+            return table[static_cast<size_t>(kernel)];
+        }
+
+        RespScanner::Kernel detectKernel()
+        {
+            if (RespScanner::isSupported(RespScanner::Kernel::AVX2)) {
+                return RespScanner::Kernel::AVX2;
+            }
+            if (RespScanner::isSupported(RespScanner::Kernel::SSE2)) {
+                return RespScanner::Kernel::SSE2;
+            }
+            return RespScanner::Kernel::Scalar;
+        }
+
+        // 首次调用时选定，之后所有调用都走同一个函数指针；
+        // 用函数内静态变量，其他翻译单元的静态初始化中调用 findCRLF 时也已选定
+        ScanFunction activeFunction()
+        {
+            static const ScanFunction function = functionOf(RespScanner::activeKernel());
+            return function;
+        }
+    }
+
+    size_t RespScanner::findCRLF(const char* data, size_t length, size_t offset)
+    {
+        return activeFunction()(data, length, offset);
+    }
+
+    size_t RespScanner::findCRLF(Kernel kernel, const char* data, size_t length, size_t offset)
+    {
+        return functionOf(kernel)(data, length, offset);
+    }
+
+    RespScanner::Kernel RespScanner::activeKernel()
+    {
+        static const Kernel kernel = detectKernel();
+        return kernel;
+    }
+
+    bool RespScanner::isSupported(Kernel kernel)
+    {
+        switch (kernel) {
+            case Kernel::Scalar:
+                return true;
+#ifdef GALAY_REDIS_SCANNER_X86
+            case Kernel::SSE2:
+                // 可能在静态初始化期间被调用，此时 libgcc 的CPU检测尚未执行
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("sse2");
+            case Kernel::AVX2:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    const char* RespScanner::kernelName(Kernel kernel)
+    {
+        switch (kernel) {
+            case Kernel::Scalar: return "scalar";
+            case Kernel::SSE2:   return "sse2";
+            case Kernel::AVX2:   return "avx2";
+        }
+        return "unknown";
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef GALAY_REDIS_RESP_SCANNER_H
+#define GALAY_REDIS_RESP_SCANNER_H
+
+#include <cstddef>
+
+namespace galay::redis::protocol
+{
+    // RESP行扫描内核
+    // RESP的每一行（简单字符串、整数、错误、长度头）都以\r\n结尾，类型标识就是行首字节，
+    // 因此解析器的全部扫描工作归结为查找\r\n。这里提供标量/SSE2/AVX2三种实现，运行时按CPU能力选择。
+    class RespScanner
+    {
+    public:
+        enum class Kernel
+        {
+            Scalar,     // 逐字节比较
+            SSE2,       // 16字节一组
+            AVX2        // 32字节一组
+        };
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        // 查找 [offset, length) 内第一个\r\n，返回\r的位置，找不到返回npos
+        // 使用运行时选定的最快内核
+        static size_t findCRLF(const char* data, size_t length, size_t offset = 0);
+
+        // 使用指定内核查找，内核不被当前CPU支持时退回标量实现
+        static size_t findCRLF(Kernel kernel, const char* data, size_t length, size_t offset = 0);
+
+        // 当前运行时选定的内核
+        static Kernel activeKernel();
+
+        // 当前CPU是否支持指定内核
+        static bool isSupported(Kernel kernel);
+
+        static const char* kernelName(Kernel kernel);
+    };
+}
+
+#endif // GALAY_REDIS_RESP_SCANNER_H
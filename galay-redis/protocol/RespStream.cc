@@ -0,0 +1,126 @@
+#include "RespStream.h"
+#include "RespScanner.h"
+#include <charconv>
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+namespace galay::redis::protocol
+{
+    RespBulkSink makeFdSink(int fd)
+    {
+        return [fd](std::string_view chunk) {
+            while (!chunk.empty()) {
+                ssize_t n = ::write(fd, chunk.data(), chunk.size());
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                chunk.remove_prefix(static_cast<size_t>(n));
+            }
+            return true;
+        };
+    }
+
+    void RespBulkStreamParser::reset() noexcept
+    {
+        m_state = State::Header;
+        m_scan_offset = 0;
+        m_length = -1;
+        m_delivered = 0;
+        m_null = false;
+        m_is_error = false;
+        m_sink_stopped = false;
+        m_error.clear();
+    }
+
+    std::expected<RespStreamProgress, ParseError>
+    RespBulkStreamParser::parse(const char* data, size_t length, const RespBulkSink& sink)
+    {
+        RespStreamProgress progress;
+
+        if (m_state == State::Header) {
+            size_t crlf = RespScanner::findCRLF(data, length, m_scan_offset);
+            if (crlf == RespScanner::npos) {
+                // 下次从可能被截断的 \r 处继续扫描
+                m_scan_offset = length > 0 ? length - 1 : 0;
+                return progress;
+            }
+            if (crlf == 0) {
+                reset();
+                return std::unexpected(ParseError::InvalidFormat);
+            }
+
+            // 新的一帧，清掉上一帧的结果
+            reset();
+            char type = data[0];
+            std::string_view line(data + 1, crlf - 1);
+            progress.consumed = crlf + 2;
+
+            switch (type) {
+                case '-':
+                    m_is_error = true;
+                    m_error.assign(line);
+                    progress.done = true;
+                    return progress;
+                case '_':
+                    m_null = true;
+                    progress.done = true;
+                    return progress;
+                case '$':
+                case '!': {
+                    int64_t len = 0;
+                    auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), len);
+                    if (ec != std::errc() || ptr != line.data() + line.size() || len < -1) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    }
+                    if (len == -1) {
+                        m_null = true;
+                        progress.done = true;
+                        return progress;
+                    }
+                    m_is_error = type == '!';
+                    m_length = len;
+                    m_state = State::Payload;
+                    break;
+                }
+                default:
+                    reset();
+                    return std::unexpected(ParseError::InvalidType);
+            }
+        }
+
+        if (m_state == State::Payload) {
+            size_t remaining = static_cast<size_t>(m_length) - m_delivered;
+            size_t n = std::min(remaining, length - progress.consumed);
+            if (n > 0) {
+                std::string_view chunk(data + progress.consumed, n);
+                if (m_is_error) {
+                    m_error.append(chunk);
+                } else if (!m_sink_stopped && sink) {
+                    m_sink_stopped = !sink(chunk);
+                }
+                m_delivered += n;
+                progress.consumed += n;
+            }
+            if (m_delivered < static_cast<size_t>(m_length)) {
+                return progress;
+            }
+            m_state = State::Trailer;
+        }
+
+        // State::Trailer
+        if (length - progress.consumed < 2) {
+            return progress;
+        }
+        if (data[progress.consumed] != '\r' || data[progress.consumed + 1] != '\n') {
+            reset();
+            return std::unexpected(ParseError::InvalidFormat);
+        }
+        progress.consumed += 2;
+        progress.done = true;
+        m_state = State::Header;
+        return progress;
+    }
+}
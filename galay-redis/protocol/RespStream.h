@@ -0,0 +1,77 @@
+#ifndef GALAY_REDIS_RESP_STREAM_H
+#define GALAY_REDIS_RESP_STREAM_H
+
+#include "RedisProtocol.h"
+#include <string>
+#include <string_view>
+#include <functional>
+#include <expected>
+#include <cstdint>
+
+namespace galay::redis::protocol
+{
+    // 流式 bulk 的数据接收者：按到达顺序收到内容分片，分片只在回调期间有效
+    // 返回 false 表示不再接收，剩余内容仍会被读取并丢弃，连接保持可用
+    using RespBulkSink = std::function<bool(std::string_view chunk)>;
+
+    // 写入文件描述符的 sink（文件、管道、socket），写失败时停止接收
+    RespBulkSink makeFdSink(int fd);
+
+    // 一次 RespBulkStreamParser::parse 的进度
+    struct RespStreamProgress
+    {
+        size_t consumed = 0;    // 已处理、可以从缓冲区丢弃的字节数
+        bool done = false;      // 整帧是否已结束
+    };
+
+    // 流式读取的结果
+    struct RespBulkStreamResult
+    {
+        bool null = false;      // 键不存在（Null 回复）
+        size_t length = 0;      // bulk 内容总长度
+    };
+
+    // 流式 bulk 解析器
+    // 只处理 GET 类命令的回复（bulk string、Null、错误）。bulk 内容到达多少就交给 sink 多少，
+    // 不在内存中拼接整个值，占用的内存只取决于接收缓冲区，与值的大小无关。
+    class RespBulkStreamParser
+    {
+    public:
+        // data 必须从上次返回的 consumed 之后开始（首次调用为帧起点）
+        // 回复不是 bulk/Null/错误时返回 InvalidType
+        std::expected<RespStreamProgress, ParseError> parse(const char* data, size_t length,
+                                                            const RespBulkSink& sink);
+
+        // 重置解析器状态
+        void reset() noexcept;
+
+        // 以下在 done 之后有效
+        bool isNull() const { return m_null; }
+        bool isError() const { return m_is_error; }
+        const std::string& errorMessage() const { return m_error; }
+        size_t length() const { return m_length < 0 ? 0 : static_cast<size_t>(m_length); }
+        // sink 是否中途返回了 false
+        bool sinkStopped() const { return m_sink_stopped; }
+
+        RespBulkStreamResult result() const { return {m_null, length()}; }
+
+    private:
+        enum class State
+        {
+            Header,     // 等待首行
+            Payload,    // 正在传递 bulk 内容
+            Trailer     // 等待内容后的 \r\n
+        };
+
+        State m_state = State::Header;
+        size_t m_scan_offset = 0;       // 首行结束符扫描断点
+        int64_t m_length = -1;
+        size_t m_delivered = 0;
+        bool m_null = false;
+        bool m_is_error = false;
+        bool m_sink_stopped = false;
+        std::string m_error;
+    };
+}
+
+#endif // GALAY_REDIS_RESP_STREAM_H
@@ -0,0 +1,347 @@
+#include "RespTape.h"
+#include "RespScanner.h"
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+namespace galay::redis::protocol
+{
+    namespace
+    {
+        std::expected<int64_t, ParseError> parseInteger(const char* data, size_t length)
+        {
+            if (length == 0) {
+                return std::unexpected(ParseError::InvalidFormat);
+            }
+            const char* begin = data[0] == '+' ? data + 1 : data;
+            int64_t value = 0;
+            auto [ptr, ec] = std::from_chars(begin, data + length, value);
+            if (ec != std::errc() || ptr != data + length) {
+                return std::unexpected(ParseError::InvalidFormat);
+            }
+            return value;
+        }
+    }
+
+    // RespTapeView实现
+    std::string_view RespTapeView::asString() const
+    {
+        const RespTapeEntry& e = entry();
+        switch (e.type) {
+            case RespType::SimpleString:
+            case RespType::Error:
+            case RespType::BulkString:
+                return std::string_view(m_base + e.offset, e.length);
+            default:
+                return {};
+        }
+    }
+
+    int64_t RespTapeView::asInteger() const
+    {
+        if (!isInteger()) {
+            return 0;
+        }
+        // 解析阶段已校验格式
+        return parseInteger(m_base + entry().offset, entry().length).value_or(0);
+    }
+
+    double RespTapeView::asDouble() const
+    {
+        if (!isDouble()) {
+            return 0.0;
+        }
+        double value = 0.0;
+        const char* begin = m_base + entry().offset;
+        std::from_chars(begin, begin + entry().length, value);
+        return value;
+    }
+
+    bool RespTapeView::asBoolean() const
+    {
+        return isBoolean() && m_base[entry().offset] == 't';
+    }
+
+    size_t RespTapeView::size() const
+    {
+        const RespTapeEntry& e = entry();
+        switch (e.type) {
+            case RespType::Array:
+            case RespType::Set:
+            case RespType::Push:
+                return e.count;
+            case RespType::Map:
+                return e.count / 2;
+            default:
+                return 0;
+        }
+    }
+
+    RespTapeView RespTapeView::at(size_t index) const
+    {
+        RespTapeView child = firstChild();
+        for (size_t i = 0; i < index; ++i) {
+            child = child.nextSibling();
+        }
+        return child;
+    }
+
+    RedisReply RespTapeView::toReply() const
+    {
+        const RespTapeEntry& e = entry();
+        switch (e.type) {
+            case RespType::SimpleString:
+            case RespType::Error:
+            case RespType::BulkString:
+                return RedisReply(e.type, std::string(asString()));
+            case RespType::Integer:
+                return RedisReply(e.type, asInteger());
+            case RespType::Double:
+                return RedisReply(e.type, asDouble());
+            case RespType::Boolean:
+                return RedisReply(e.type, asBoolean());
+            case RespType::Array:
+            case RespType::Set:
+            {
+                std::vector<RedisReply> elements;
+                elements.reserve(e.count);
+                RespTapeView child = firstChild();
+                for (uint32_t i = 0; i < e.count; ++i, child = child.nextSibling()) {
+                    elements.push_back(child.toReply());
+                }
+                return RedisReply(e.type, std::move(elements));
+            }
+            case RespType::Map:
+            {
+                std::vector<std::pair<RedisReply, RedisReply>> entries;
+                entries.reserve(e.count / 2);
+                RespTapeView child = firstChild();
+                for (uint32_t i = 0; i + 1 < e.count; i += 2) {
+                    RespTapeView value = child.nextSibling();
+                    entries.emplace_back(child.toReply(), value.toReply());
+                    child = value.nextSibling();
+                }
+                return RedisReply(e.type, std::move(entries));
+            }
+            default:
+                return RedisReply(RespType::Null, std::monostate{});
+        }
+    }
+
+    // RespTapeParser实现
+    void RespTapeParser::reset() noexcept
+    {
+        m_frames.clear();
+        m_offset = 0;
+        m_scan_offset = 0;
+        m_bulk_length = -1;
+        m_bulk_record = 0;
+    }
+
+    bool RespTapeParser::complete(std::vector<RespTapeEntry>& tape)
+    {
+        while (!m_frames.empty()) {
+            Frame& top = m_frames.back();
+            if (--top.remaining > 0) {
+                return false;
+            }
+            // 聚合已满，回填子树记录数
+            tape[top.record].skip = static_cast<uint32_t>(tape.size() - top.record);
+            m_frames.pop_back();
+        }
+        return true;
+    }
+
+    std::expected<size_t, ParseError>
+    RespTapeParser::parse(const char* data, size_t length, std::vector<RespTapeEntry>& tape)
+    {
+        if (length < m_offset) {
+            reset();
+        }
+        if (m_offset == 0 && m_frames.empty() && m_bulk_length < 0) {
+            tape.clear();
+        }
+
+        while (true) {
+            if (m_bulk_length >= 0) {
+                size_t content_end = m_offset + static_cast<size_t>(m_bulk_length);
+                if (content_end + 2 > length) {
+                    return std::unexpected(ParseError::Incomplete);
+                }
+                if (data[content_end] != '\r' || data[content_end + 1] != '\n') {
+                    reset();
+                    return std::unexpected(ParseError::InvalidFormat);
+                }
+
+                RespTapeEntry& bulk = tape[m_bulk_record];
+                bulk.offset = m_offset;
+                bulk.length = static_cast<uint32_t>(m_bulk_length);
+                m_offset = content_end + 2;
+                m_bulk_length = -1;
+                if (complete(tape)) {
+                    break;
+                }
+                continue;
+            }
+
+            if (m_offset >= length) {
+                return std::unexpected(ParseError::Incomplete);
+            }
+
+            size_t line_start = m_offset + 1;
+            size_t crlf_pos = RespScanner::findCRLF(data, length, std::max(line_start, m_scan_offset));
+            if (crlf_pos == RespScanner::npos) {
+                m_scan_offset = std::max(line_start, length - 1);
+                return std::unexpected(ParseError::Incomplete);
+            }
+            m_scan_offset = 0;
+
+            const char* line = data + line_start;
+            size_t line_len = crlf_pos - line_start;
+            size_t next = crlf_pos + 2;
+            char type_marker = data[m_offset];
+
+            RespTapeEntry entry;
+            entry.offset = line_start;
+            entry.length = static_cast<uint32_t>(line_len);
+
+            bool done = false;
+            switch (type_marker) {
+                case '+':  // Simple String
+                case '-':  // Error
+                    entry.type = type_marker == '+' ? RespType::SimpleString : RespType::Error;
+                    tape.push_back(entry);
+                    m_offset = next;
+                    done = complete(tape);
+                    break;
+                case ':':  // Integer
+                {
+                    auto int_result = parseInteger(line, line_len);
+                    if (!int_result) {
+                        reset();
+                        return std::unexpected(int_result.error());
+                    }
+                    entry.type = RespType::Integer;
+                    tape.push_back(entry);
+                    m_offset = next;
+                    done = complete(tape);
+                    break;
+                }
+                case '$':  // Bulk String
+                {
+                    auto len_result = parseInteger(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    m_offset = next;
+                    if (*len_result == -1) {
+                        entry.type = RespType::Null;
+                        tape.push_back(entry);
+                        done = complete(tape);
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        entry.type = RespType::BulkString;
+                        m_bulk_length = *len_result;
+                        m_bulk_record = static_cast<uint32_t>(tape.size());
+                        tape.push_back(entry);
+                    }
+                    break;
+                }
+                case '*':  // Array
+                case '~':  // Set (RESP3)
+                case '%':  // Map (RESP3)
+                {
+                    auto len_result = parseInteger(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    m_offset = next;
+                    RespType type = type_marker == '*' ? RespType::Array
+                                  : type_marker == '~' ? RespType::Set : RespType::Map;
+                    if (*len_result == -1 && type == RespType::Array) {
+                        entry.type = RespType::Null;
+                        tape.push_back(entry);
+                        done = complete(tape);
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        uint64_t elements = static_cast<uint64_t>(*len_result) * (type == RespType::Map ? 2 : 1);
+                        // 每个子元素至少占一条记录，记录下标和 skip 都是 uint32_t，超出范围的个数无法表示
+                        if (elements > std::numeric_limits<uint32_t>::max() - tape.size()) {
+                            reset();
+                            return std::unexpected(ParseError::InvalidLength);
+                        }
+                        uint32_t count = static_cast<uint32_t>(elements);
+                        entry.type = type;
+                        entry.count = count;
+                        entry.length = 0;
+                        tape.push_back(entry);
+                        if (count == 0) {
+                            done = complete(tape);
+                        } else {
+                            m_frames.push_back(Frame{static_cast<uint32_t>(tape.size() - 1), count});
+                        }
+                    }
+                    break;
+                }
+                case ',':  // Double (RESP3)
+                {
+                    double value = 0;
+                    auto [ptr, ec] = std::from_chars(line, line + line_len, value);
+                    if (ec != std::errc() || ptr != line + line_len) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    entry.type = RespType::Double;
+                    tape.push_back(entry);
+                    m_offset = next;
+                    done = complete(tape);
+                    break;
+                }
+                case '#':  // Boolean (RESP3)
+                {
+                    if (line_len != 1 || (line[0] != 't' && line[0] != 'f')) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    entry.type = RespType::Boolean;
+                    tape.push_back(entry);
+                    m_offset = next;
+                    done = complete(tape);
+                    break;
+                }
+                default:
+                    reset();
+                    return std::unexpected(ParseError::InvalidType);
+            }
+            if (done) {
+                break;
+            }
+        }
+
+        size_t consumed = m_offset;
+        reset();
+        return consumed;
+    }
+
+    // RespTapeReply实现
+    RespTapeReply::RespTapeReply(const char* frame, size_t length, const std::vector<RespTapeEntry>& tape)
+        : m_arena(sizeof(RespTapeEntry) * tape.size() + length + 64)
+        , m_entry_count(tape.size())
+    {
+        auto* entries = static_cast<RespTapeEntry*>(
+            m_arena.allocate(sizeof(RespTapeEntry) * tape.size(), alignof(RespTapeEntry)));
+        std::memcpy(static_cast<void*>(entries), tape.data(), sizeof(RespTapeEntry) * tape.size());
+        m_tape = entries;
+
+        auto* data = static_cast<char*>(m_arena.allocate(length, 1));
+        std::memcpy(data, frame, length);
+        m_data = data;
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef GALAY_REDIS_RESP_TAPE_H
+#define GALAY_REDIS_RESP_TAPE_H
+
+#include "RedisProtocol.h"
+#include "RespArena.h"
+#include <string_view>
+#include <cstdint>
+
+namespace galay::redis::protocol
+{
+    // 扁平回复（tape）的一条记录，按先序排列
+    // 聚合类型的子树紧跟在自身之后，skip 为子树占用的记录数，i + skip 即下一个兄弟，跳过整个子聚合为O(1)
+    struct RespTapeEntry
+    {
+        RespType type = RespType::Null;
+        uint32_t count = 0;     // 直接子元素数（Map为键值总数）
+        uint32_t skip = 1;      // 以本条为根的子树记录数（标量为1）
+        uint32_t length = 0;    // 内容长度
+        uint64_t offset = 0;    // 内容相对帧起点的偏移；整数/浮点/布尔为行内容，访问时再解析
+    };
+
+    // tape上的只读游标，不持有数据
+    class RespTapeView
+    {
+    public:
+        RespTapeView() = default;
+        RespTapeView(const char* base, const RespTapeEntry* tape, uint32_t index = 0)
+            : m_base(base), m_tape(tape), m_index(index) {}
+
+        bool valid() const { return m_tape != nullptr; }
+        uint32_t index() const { return m_index; }
+
+        // 类型判断
+        RespType getType() const { return entry().type; }
+        bool isSimpleString() const { return getType() == RespType::SimpleString; }
+        bool isError() const { return getType() == RespType::Error; }
+        bool isInteger() const { return getType() == RespType::Integer; }
+        bool isBulkString() const { return getType() == RespType::BulkString; }
+        bool isArray() const { return getType() == RespType::Array; }
+        bool isNull() const { return getType() == RespType::Null; }
+        bool isDouble() const { return getType() == RespType::Double; }
+        bool isBoolean() const { return getType() == RespType::Boolean; }
+        bool isMap() const { return getType() == RespType::Map; }
+        bool isSet() const { return getType() == RespType::Set; }
+        bool isPush() const { return getType() == RespType::Push; }
+
+        // 获取值：字符串指向帧数据，数值在访问时解析
+        std::string_view asString() const;
+        int64_t asInteger() const;
+        double asDouble() const;
+        bool asBoolean() const;
+
+        // 聚合类型：数组/集合的元素数，Map的键值对数
+        size_t size() const;
+
+        // 第一个子元素 / 下一个兄弟（O(1)），顺序遍历时优先使用
+        RespTapeView firstChild() const { return RespTapeView(m_base, m_tape, m_index + 1); }
+        RespTapeView nextSibling() const { return RespTapeView(m_base, m_tape, m_index + entry().skip); }
+
+        // 随机访问：按兄弟跳转，O(index)
+        RespTapeView at(size_t index) const;
+        RespTapeView operator[](size_t index) const { return at(index); }
+        RespTapeView key(size_t index) const { return at(index * 2); }
+        RespTapeView value(size_t index) const { return at(index * 2 + 1); }
+
+        // 物化为独立的 RedisReply（会拷贝字符串）
+        RedisReply toReply() const;
+
+    private:
+        const RespTapeEntry& entry() const { return m_tape[m_index]; }
+
+        const char* m_base = nullptr;
+        const RespTapeEntry* m_tape = nullptr;
+        uint32_t m_index = 0;
+    };
+
+    // tape解析器
+    // 与 RespParser 相同的可恢复状态机，每个值追加一条记录，聚合在收尾时回填 skip。
+    // 只记录偏移，Incomplete 后帧数据可以整体搬移再继续解析。
+    class RespTapeParser
+    {
+    public:
+        // 解析一帧，tape 在首次调用时被清空并复用容量，根记录为 tape[0]
+        // data 必须从当前帧的起点开始；返回整帧字节数
+        std::expected<size_t, ParseError> parse(const char* data, size_t length,
+                                                std::vector<RespTapeEntry>& tape);
+
+        // 重置解析器状态
+        void reset() noexcept;
+
+        // 是否有未完成的帧
+        bool inProgress() const noexcept { return m_offset != 0 || !m_frames.empty(); }
+
+    private:
+        // 未完成的聚合：记录下标和剩余子元素数
+        struct Frame
+        {
+            uint32_t record;
+            uint32_t remaining;
+        };
+
+        // 一个值追加完成，逐层回填已完成聚合的 skip；整帧完成返回 true
+        bool complete(std::vector<RespTapeEntry>& tape);
+
+        std::vector<Frame> m_frames;
+        size_t m_offset = 0;            // 当前帧中已解析完成的字节数
+        size_t m_scan_offset = 0;       // 行结束符扫描断点
+        int64_t m_bulk_length = -1;     // 已读取头部、等待内容的bulk长度，-1表示无
+        uint32_t m_bulk_record = 0;     // 等待内容的bulk所在记录
+    };
+
+    // 位于arena中的tape回复：帧字节与记录数组放在同一块内存里
+    class RespTapeReply
+    {
+    public:
+        RespTapeReply(const char* frame, size_t length, const std::vector<RespTapeEntry>& tape);
+
+        RespTapeReply(const RespTapeReply&) = delete;
+        RespTapeReply& operator=(const RespTapeReply&) = delete;
+
+        RespTapeView view(uint32_t index = 0) const
+        {
+            return RespTapeView(m_data, m_tape, index);
+        }
+
+        size_t entryCount() const { return m_entry_count; }
+        const RespArena& arena() const { return m_arena; }
+
+    private:
+        RespArena m_arena;
+        const char* m_data = nullptr;
+        const RespTapeEntry* m_tape = nullptr;
+        size_t m_entry_count = 0;
+    };
+}
+
+#endif // GALAY_REDIS_RESP_TAPE_H
@@ -0,0 +1,75 @@
+#include "RespVectored.h"
+
+namespace galay::redis::protocol
+{
+    RespVectoredCommand::RespVectoredCommand(size_t threshold)
+        : m_threshold(threshold)
+    {
+    }
+
+    void RespVectoredCommand::append(std::string_view cmd, const std::vector<std::string_view>& args)
+    {
+        RespEncoder::appendArrayHeader(m_inline, args.size() + 1);
+        RespEncoder::appendBulkString(m_inline, cmd);
+        for (const auto& arg : args) {
+            appendBulk(arg);
+        }
+        flushInline();
+    }
+
+    void RespVectoredCommand::appendBulk(std::string_view arg)
+    {
+        if (arg.size() < m_threshold) {
+            RespEncoder::appendBulkString(m_inline, arg);
+            return;
+        }
+        // 只写 bulk 头，参数本体原地引用，结尾的 CRLF 写回内联缓冲区
+        RespEncoder::appendBulkHeader(m_inline, arg.size());
+        flushInline();
+        m_segments.push_back({arg.data(), 0, arg.size()});
+        m_size += arg.size();
+        ++m_borrowed_count;
+        m_inline.append("\r\n", 2);
+    }
+
+    void RespVectoredCommand::flushInline()
+    {
+        // 内联片段只记录偏移，m_inline 扩容后依然有效
+        size_t length = m_inline.size() - m_inline_flushed;
+        if (length == 0) {
+            return;
+        }
+        if (!m_segments.empty() && m_segments.back().external == nullptr) {
+            m_segments.back().length += length;
+        } else {
+            m_segments.push_back({nullptr, m_inline_flushed, length});
+        }
+        m_inline_flushed = m_inline.size();
+        m_size += length;
+    }
+
+    std::vector<iovec> RespVectoredCommand::iovecs(size_t offset) const
+    {
+        std::vector<iovec> result;
+        result.reserve(m_segments.size());
+        for (const auto& segment : m_segments) {
+            if (offset >= segment.length) {
+                offset -= segment.length;
+                continue;
+            }
+            const char* base = segment.external ? segment.external : m_inline.data() + segment.offset;
+            result.push_back({const_cast<char*>(base + offset), segment.length - offset});
+            offset = 0;
+        }
+        return result;
+    }
+
+    void RespVectoredCommand::clear()
+    {
+        m_inline.clear();
+        m_inline_flushed = 0;
+        m_segments.clear();
+        m_size = 0;
+        m_borrowed_count = 0;
+    }
+}
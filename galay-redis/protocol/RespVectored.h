@@ -0,0 +1,72 @@
+#ifndef GALAY_REDIS_RESP_VECTORED_H
+#define GALAY_REDIS_RESP_VECTORED_H
+
+#include "RedisProtocol.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/uio.h>
+
+namespace galay::redis::protocol
+{
+    /**
+     * @brief 分散写（writev）命令
+     * @details 数组头、bulk 头、CRLF 以及短参数拷贝到内部的小缓冲区；长度不小于 threshold 的参数
+     *          只记录调用方的地址，发送时作为独立的 iovec 原地引用，数据只在进入内核时拷贝一次。
+     * @warning 被引用的参数必须在命令发送完成之前保持有效且不被修改
+     *
+     * @code
+     * RespVectoredCommand command(16 * 1024);
+     * command.append("SET", {key, large_value});
+     * auto iovecs = command.iovecs(0);   // 已发送 n 字节后用 iovecs(n) 继续
+     * @endcode
+     */
+    class RespVectoredCommand
+    {
+    public:
+        // 默认的原地引用阈值：更短的参数拷贝比多一个 iovec 更划算
+        static constexpr size_t kDefaultThreshold = 16 * 1024;
+
+        explicit RespVectoredCommand(size_t threshold = kDefaultThreshold);
+
+        /**
+         * @brief 追加一条命令（可多次调用，组成批量发送）
+         */
+        void append(std::string_view cmd, const std::vector<std::string_view>& args);
+
+        /**
+         * @brief 从 offset 字节开始尚未发送部分的 iovec
+         */
+        std::vector<iovec> iovecs(size_t offset) const;
+
+        // 命令总字节数
+        size_t size() const { return m_size; }
+        // 原地引用的参数个数
+        size_t borrowedCount() const { return m_borrowed_count; }
+        bool empty() const { return m_size == 0; }
+
+        void clear();
+
+    private:
+        // 片段：external 为空时引用 m_inline[offset, offset + length)
+        struct Segment
+        {
+            const char* external;
+            size_t offset;
+            size_t length;
+        };
+
+        // 把 m_inline 尾部尚未归入片段的字节记为一个内联片段
+        void flushInline();
+        void appendBulk(std::string_view arg);
+
+        size_t m_threshold;
+        std::string m_inline;
+        size_t m_inline_flushed = 0;
+        std::vector<Segment> m_segments;
+        size_t m_size = 0;
+        size_t m_borrowed_count = 0;
+    };
+}
+
+#endif // GALAY_REDIS_RESP_VECTORED_H
@@ -0,0 +1,219 @@
+#include "RespVisitor.h"
+#include "RespScanner.h"
+#include <charconv>
+#include <algorithm>
+
+namespace galay::redis::protocol
+{
+    namespace
+    {
+        std::expected<int64_t, ParseError> parseInteger(const char* data, size_t length)
+        {
+            if (length == 0) {
+                return std::unexpected(ParseError::InvalidFormat);
+            }
+            const char* begin = data[0] == '+' ? data + 1 : data;
+            int64_t value = 0;
+            auto [ptr, ec] = std::from_chars(begin, data + length, value);
+            if (ec != std::errc() || ptr != data + length) {
+                return std::unexpected(ParseError::InvalidFormat);
+            }
+            return value;
+        }
+    }
+
+    void RespVisitParser::reset() noexcept
+    {
+        m_frames.clear();
+        m_scan_offset = 0;
+        m_bulk_length = -1;
+    }
+
+    bool RespVisitParser::complete(RespVisitor& visitor)
+    {
+        while (!m_frames.empty()) {
+            Frame& top = m_frames.back();
+            if (--top.remaining > 0) {
+                return false;
+            }
+
+            RespType type = top.type;
+            m_frames.pop_back();
+            if (type == RespType::Map) {
+                visitor.onMapEnd();
+            } else if (type == RespType::Set) {
+                visitor.onSetEnd();
+            } else {
+                visitor.onArrayEnd();
+            }
+        }
+        return true;
+    }
+
+    bool RespVisitParser::beginAggregate(RespType type, int64_t count, RespVisitor& visitor)
+    {
+        if (type == RespType::Map) {
+            visitor.onMapBegin(static_cast<size_t>(count));
+        } else if (type == RespType::Set) {
+            visitor.onSetBegin(static_cast<size_t>(count));
+        } else {
+            visitor.onArrayBegin(static_cast<size_t>(count));
+        }
+
+        if (count == 0) {
+            // 空聚合：Begin 后立即 End，再作为一个完成的值向上收尾
+            m_frames.push_back(Frame{type, 1});
+            return complete(visitor);
+        }
+
+        m_frames.push_back(Frame{type, type == RespType::Map ? count * 2 : count});
+        return false;
+    }
+
+    std::expected<RespVisitProgress, ParseError>
+    RespVisitParser::parse(const char* data, size_t length, RespVisitor& visitor)
+    {
+        size_t offset = 0;
+        while (true) {
+            // 等待bulk内容：头部已在上次调用中回调前消费
+            if (m_bulk_length >= 0) {
+                size_t content_end = offset + static_cast<size_t>(m_bulk_length);
+                if (content_end + 2 > length) {
+                    return RespVisitProgress{offset, false};
+                }
+                if (data[content_end] != '\r' || data[content_end + 1] != '\n') {
+                    reset();
+                    return std::unexpected(ParseError::InvalidFormat);
+                }
+
+                visitor.onBulk(std::string_view(data + offset, static_cast<size_t>(m_bulk_length)));
+                offset = content_end + 2;
+                m_bulk_length = -1;
+                if (complete(visitor)) {
+                    break;
+                }
+                continue;
+            }
+
+            if (offset >= length) {
+                return RespVisitProgress{offset, false};
+            }
+
+            // 从上次扫描断点继续查找行结束符
+            size_t line_start = offset + 1;
+            size_t crlf_pos = RespScanner::findCRLF(data, length, std::max(line_start, offset + m_scan_offset));
+            if (crlf_pos == RespScanner::npos) {
+                m_scan_offset = std::max(line_start, length - 1) - offset;
+                return RespVisitProgress{offset, false};
+            }
+            m_scan_offset = 0;
+
+            const char* line = data + line_start;
+            size_t line_len = crlf_pos - line_start;
+            size_t next = crlf_pos + 2;
+            char type_marker = data[offset];
+
+            bool done = false;
+            switch (type_marker) {
+                case '+':  // Simple String
+                    visitor.onSimpleString(std::string_view(line, line_len));
+                    offset = next;
+                    done = complete(visitor);
+                    break;
+                case '-':  // Error
+                    visitor.onError(std::string_view(line, line_len));
+                    offset = next;
+                    done = complete(visitor);
+                    break;
+                case ':':  // Integer
+                {
+                    auto int_result = parseInteger(line, line_len);
+                    if (!int_result) {
+                        reset();
+                        return std::unexpected(int_result.error());
+                    }
+                    visitor.onInteger(*int_result);
+                    offset = next;
+                    done = complete(visitor);
+                    break;
+                }
+                case '$':  // Bulk String
+                {
+                    auto len_result = parseInteger(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    offset = next;
+                    if (*len_result == -1) {
+                        visitor.onNull();
+                        done = complete(visitor);
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        m_bulk_length = *len_result;
+                    }
+                    break;
+                }
+                case '*':  // Array
+                case '~':  // Set (RESP3)
+                case '%':  // Map (RESP3)
+                {
+                    auto len_result = parseInteger(line, line_len);
+                    if (!len_result) {
+                        reset();
+                        return std::unexpected(len_result.error());
+                    }
+                    offset = next;
+                    RespType type = type_marker == '*' ? RespType::Array
+                                  : type_marker == '~' ? RespType::Set : RespType::Map;
+                    if (*len_result == -1 && type == RespType::Array) {
+                        visitor.onNull();
+                        done = complete(visitor);
+                    } else if (*len_result < 0) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidLength);
+                    } else {
+                        done = beginAggregate(type, *len_result, visitor);
+                    }
+                    break;
+                }
+                case ',':  // Double (RESP3)
+                {
+                    double value = 0;
+                    auto [ptr, ec] = std::from_chars(line, line + line_len, value);
+                    if (ec != std::errc() || ptr != line + line_len) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    visitor.onDouble(value);
+                    offset = next;
+                    done = complete(visitor);
+                    break;
+                }
+                case '#':  // Boolean (RESP3)
+                {
+                    if (line_len != 1 || (line[0] != 't' && line[0] != 'f')) {
+                        reset();
+                        return std::unexpected(ParseError::InvalidFormat);
+                    }
+                    visitor.onBoolean(line[0] == 't');
+                    offset = next;
+                    done = complete(visitor);
+                    break;
+                }
+                default:
+                    reset();
+                    return std::unexpected(ParseError::InvalidType);
+            }
+
+            if (done) {
+                break;
+            }
+        }
+
+        reset();
+        return RespVisitProgress{offset, true};
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef GALAY_REDIS_RESP_VISITOR_H
+#define GALAY_REDIS_RESP_VISITOR_H
+
+#include "RedisProtocol.h"
+#include <string_view>
+#include <cstdint>
+
+namespace galay::redis::protocol
+{
+    // SAX风格的回复访问者
+    // 解析器直接在接收缓冲区上按先序回调，不构造任何中间对象；
+    // string_view 只在回调期间有效，需要保留时自行拷贝。默认实现为空，按需覆盖。
+    class RespVisitor
+    {
+    public:
+        virtual ~RespVisitor() = default;
+
+        // 标量
+        virtual void onSimpleString(std::string_view /*value*/) {}
+        virtual void onError(std::string_view /*message*/) {}
+        virtual void onInteger(int64_t /*value*/) {}
+        virtual void onBulk(std::string_view /*value*/) {}
+        virtual void onNull() {}
+        virtual void onDouble(double /*value*/) {}
+        virtual void onBoolean(bool /*value*/) {}
+
+        // 聚合：Begin 之后依次回调 count 个子元素，再回调对应的 End
+        virtual void onArrayBegin(size_t /*count*/) {}
+        virtual void onArrayEnd() {}
+        virtual void onSetBegin(size_t /*count*/) {}
+        virtual void onSetEnd() {}
+        // count 为键值对数，子元素按 key, value 交替回调
+        virtual void onMapBegin(size_t /*count*/) {}
+        virtual void onMapEnd() {}
+    };
+
+    // 一次 RespVisitParser::parse 的进度
+    struct RespVisitProgress
+    {
+        size_t consumed = 0;    // 已回调完毕、可以从缓冲区丢弃的字节数
+        bool done = false;      // 整帧是否已结束
+    };
+
+    // 访问者解析器
+    // 与 RespParser 相同的可恢复状态机，但每个元素解析完立即回调，回调过的字节即可丢弃：
+    // 整帧不必全部驻留在接收缓冲区中，只要求单个元素（一行或一个bulk）能放下。
+    class RespVisitParser
+    {
+    public:
+        // data 必须从上次返回的 consumed 之后开始（首次调用为帧起点）
+        // 数据不足时返回 done = false，已回调的元素不会重复回调
+        // 格式错误时状态被重置，访问者可能已收到部分回调
+        std::expected<RespVisitProgress, ParseError> parse(const char* data, size_t length,
+                                                           RespVisitor& visitor);
+
+        // 重置解析器状态
+        void reset() noexcept;
+
+        // 是否有未完成的帧
+        bool inProgress() const noexcept { return !m_frames.empty() || m_bulk_length >= 0; }
+
+    private:
+        // 未完成的聚合：类型和剩余子元素数（Map按key和value分别计数）
+        struct Frame
+        {
+            RespType type;
+            int64_t remaining;
+        };
+
+        // 聚合头部：count为0时直接回调 End
+        bool beginAggregate(RespType type, int64_t count, RespVisitor& visitor);
+
+        // 一个值回调完成，逐层回调已结束聚合的 End；整帧完成返回 true
+        bool complete(RespVisitor& visitor);
+
+        std::vector<Frame> m_frames;
+        size_t m_scan_offset = 0;       // 行结束符扫描断点（相对未消费数据的起点）
+        int64_t m_bulk_length = -1;     // 已消费头部、等待内容的bulk长度，-1表示无
+    };
+}
+
+#endif // GALAY_REDIS_RESP_VISITOR_H
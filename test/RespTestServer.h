@@ -0,0 +1,220 @@
+#ifndef GALAY_REDIS_RESP_TEST_SERVER_H
+#define GALAY_REDIS_RESP_TEST_SERVER_H
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "protocol/RedisProtocol.h"
+
+namespace galay::redis::test
+{
+    /**
+     * @brief 进程内 RESP 服务端，供测试和基准使用
+     * @details 每个连接一个线程：读到多少数据就解析出多少条命令，回复一次性阻塞写回。
+     *          PING 回复 +PONG，GET 回复固定的 bulk string，其余命令回复 +OK。
+     *          与真实 Redis 一样，服务端在写回复被阻塞时不再读取新命令，
+     *          因此能复现客户端先写完整个大批次再读时的互相阻塞。
+     */
+    class RespTestServer
+    {
+    public:
+        // socket_buffer > 0 时设置每个连接的收发缓冲区大小，便于复现缓冲区写满
+        explicit RespTestServer(int socket_buffer = 0)
+            : m_socket_buffer(socket_buffer)
+        {
+        }
+
+        ~RespTestServer() { stop(); }
+
+        RespTestServer(const RespTestServer&) = delete;
+        RespTestServer& operator=(const RespTestServer&) = delete;
+
+        // 监听 127.0.0.1 的随机端口
+        bool start()
+        {
+            m_listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            socklen_t len = sizeof(addr);
+            if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+                ::listen(m_listen_fd, 16) != 0 ||
+                ::getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+                ::close(m_listen_fd);
+                m_listen_fd = -1;
+                return false;
+            }
+            m_port = ntohs(addr.sin_port);
+            m_accept_thread = std::thread([this] { acceptLoop(); });
+            return true;
+        }
+
+        void stop()
+        {
+            if (m_listen_fd < 0) {
+                return;
+            }
+            m_stopped = true;
+            ::shutdown(m_listen_fd, SHUT_RDWR);
+            ::close(m_listen_fd);
+            m_listen_fd = -1;
+            if (m_accept_thread.joinable()) {
+                m_accept_thread.join();
+            }
+            // 唤醒阻塞在 recv 上的连接线程，fd 由各线程自己关闭
+            dropConnections();
+            for (auto& worker : m_workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+        }
+
+        int port() const { return m_port; }
+
+        // 每批回复写回前的延迟，模拟网络往返或慢速握手；需在 start() 前设置
+        void setReplyDelay(std::chrono::milliseconds delay) { m_reply_delay = delay; }
+
+        // 只接受连接和读取命令，从不回复（模拟挂死的服务端）
+        void setSilent(bool silent) { m_silent = silent; }
+
+        // 已接受的连接总数
+        size_t connectionsAccepted() const { return m_accepted.load(); }
+
+        // 已处理的命令总数
+        size_t commandsServed() const { return m_commands.load(); }
+
+        // 仍打开的连接数：客户端关闭 socket 后，服务端读到 EOF 时减少
+        size_t openConnections()
+        {
+            std::lock_guard<std::mutex> lock(m_fds_mutex);
+            return m_client_fds.size();
+        }
+
+        // 断开当前所有连接（模拟服务端重启 / 网络中断），之后仍接受新连接
+        void dropConnections()
+        {
+            std::lock_guard<std::mutex> lock(m_fds_mutex);
+            for (int fd : m_client_fds) {
+                ::shutdown(fd, SHUT_RDWR);
+            }
+        }
+
+    private:
+        void acceptLoop()
+        {
+            while (!m_stopped) {
+                int fd = ::accept(m_listen_fd, nullptr, nullptr);
+                if (fd < 0) {
+                    return;
+                }
+                if (m_socket_buffer > 0) {
+                    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &m_socket_buffer, sizeof(m_socket_buffer));
+                    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &m_socket_buffer, sizeof(m_socket_buffer));
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_fds_mutex);
+                    m_client_fds.push_back(fd);
+                }
+                ++m_accepted;
+                m_workers.emplace_back([this, fd] { serve(fd); });
+            }
+        }
+
+        static std::string replyFor(const protocol::RedisReply& command)
+        {
+            if (!command.isArray() || command.asArray().empty()) {
+                return "-ERR invalid command\r\n";
+            }
+            std::string name = command.asArray().front().asString();
+            for (auto& c : name) {
+                c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+            if (name == "PING") {
+                return "+PONG\r\n";
+            }
+            if (name == "GET") {
+                return "$5\r\nvalue\r\n";
+            }
+            return "+OK\r\n";
+        }
+
+        void serve(int fd)
+        {
+            protocol::RespParser parser;
+            std::string pending;
+            std::string replies;
+            char chunk[64 * 1024];
+            while (!m_stopped) {
+                ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    break;
+                }
+                pending.append(chunk, static_cast<size_t>(n));
+
+                size_t offset = 0;
+                replies.clear();
+                while (offset < pending.size()) {
+                    auto parsed = parser.parse(pending.data() + offset, pending.size() - offset);
+                    if (!parsed) {
+                        break;
+                    }
+                    offset += parsed->first;
+                    replies += replyFor(parsed->second);
+                    ++m_commands;
+                }
+                pending.erase(0, offset);
+
+                if (m_silent) {
+                    continue;
+                }
+                if (m_reply_delay.count() > 0 && !replies.empty()) {
+                    std::this_thread::sleep_for(m_reply_delay);
+                }
+
+                // 阻塞写回，写不出去时不再读取新命令
+                for (size_t sent = 0; sent < replies.size();) {
+                    ssize_t written = ::send(fd, replies.data() + sent, replies.size() - sent, MSG_NOSIGNAL);
+                    if (written <= 0) {
+                        closeClient(fd);
+                        return;
+                    }
+                    sent += static_cast<size_t>(written);
+                }
+            }
+            closeClient(fd);
+        }
+
+        // 先从列表移除再关闭，fd 编号被复用后不会被误断开
+        void closeClient(int fd)
+        {
+            std::lock_guard<std::mutex> lock(m_fds_mutex);
+            std::erase(m_client_fds, fd);
+            ::close(fd);
+        }
+
+        int m_socket_buffer;
+        int m_listen_fd = -1;
+        int m_port = 0;
+        std::atomic<bool> m_stopped{false};
+        std::atomic<bool> m_silent{false};
+        std::atomic<size_t> m_commands{0};
+        std::atomic<size_t> m_accepted{0};
+        std::chrono::milliseconds m_reply_delay{0};
+        std::thread m_accept_thread;
+        std::vector<std::thread> m_workers;
+        std::mutex m_fds_mutex;
+        std::vector<int> m_client_fds;                  // 仍打开的连接，受 m_fds_mutex 保护
+    };
+}
+
+#endif // GALAY_REDIS_RESP_TEST_SERVER_H
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <algorithm>
+#include "base/RedisAdaptiveWindow.h"
+
+using namespace galay::redis;
+using namespace std::chrono_literals;
+
+/**
+ * @brief 模拟一条连接：往返时间固定，服务端每条命令耗时 service，
+ *        窗口内的命令排队处理，第 i 条命令的延迟为 rtt + (i + 1) * service
+ */
+void runRounds(RedisAdaptiveWindow& window, int rounds, std::chrono::nanoseconds rtt, std::chrono::nanoseconds service)
+{
+    for (int round = 0; round < rounds; ++round) {
+        size_t in_flight = window.window();
+        for (size_t i = 0; i < in_flight; ++i) {
+            window.onReply(rtt + service * static_cast<int64_t>(i + 1));
+        }
+    }
+}
+
+// 延迟平稳时窗口持续增大，直到上限
+void testGrowWhileFlat()
+{
+    std::cout << "=== Testing growth under flat latency ===" << std::endl;
+
+    RedisAdaptiveWindow window(RedisAdaptiveWindowConfig{.initial_window = 4, .max_window = 256});
+    for (int i = 0; i < 2000; ++i) {
+        window.onReply(100us);
+    }
+
+    const auto& stats = window.stats();
+    bool ok = window.window() == 256 && stats.decreases == 0 && stats.increases > 0
+              && stats.base_latency == 100us;
+    std::cout << (ok ? "✓ window grew to " : "✗ window growth failed: ")
+              << window.window() << " after " << stats.increases << " rounds" << std::endl;
+    std::cout << std::endl;
+}
+
+// 延迟上升时窗口收缩，并稳定在服务端开始排队的位置附近
+void testBackOffWhenQueueing()
+{
+    std::cout << "=== Testing back-off when latency rises ===" << std::endl;
+
+    // 往返 100us、每条命令 1us：窗口超过约 100 后服务端成为瓶颈，延迟随窗口线性增长
+    RedisAdaptiveWindow window(RedisAdaptiveWindowConfig{.initial_window = 4, .max_window = 4096});
+    runRounds(window, 200, 100us, 1us);
+
+    const auto& stats = window.stats();
+    bool ok = stats.decreases > 0 && window.window() >= 16 && window.window() <= 512
+              && stats.peak_window < 4096;
+    std::cout << (ok ? "✓ window settled at " : "✗ back-off failed: window ")
+              << window.window() << " (peak " << stats.peak_window
+              << ", base " << stats.base_latency.count() / 1000 << " us"
+              << ", last " << stats.last_latency.count() / 1000 << " us"
+              << ", " << stats.decreases << " decreases)" << std::endl;
+
+    // 服务端变慢：延迟整体上升，窗口收缩到 probe_window 以下，持续若干轮后基准上调，窗口在新的排队点附近恢复
+    size_t before = window.window();
+    runRounds(window, 60, 100us, 20us);
+    ok = window.window() < before && window.window() > 2 && window.stats().base_latency >= 120us;
+    std::cout << (ok ? "✓ slower server shrank window from " : "✗ slower server did not shrink window from ")
+              << before << " to " << window.window() << std::endl;
+
+    window.reset();
+    ok = window.window() == 4 && window.stats().samples == 0;
+    std::cout << (ok ? "✓ reset restored initial window" : "✗ reset failed") << std::endl;
+    std::cout << std::endl;
+}
+
+// 排队延迟与窗口成正比：每条回复的延迟为 base + window * k，大窗口下一轮中没有不排队的回复
+void testQueueingDoesNotRaiseBase()
+{
+    std::cout << "=== Testing queueing proportional to window ===" << std::endl;
+
+    // 窗口超过 tolerance * base / k = 50 时平均延迟超出容忍范围
+    RedisAdaptiveWindow window(RedisAdaptiveWindowConfig{.initial_window = 4, .max_window = 4096});
+    size_t largest = 0;
+    for (int round = 0; round < 500; ++round) {
+        size_t in_flight = window.window();
+        for (size_t i = 0; i < in_flight; ++i) {
+            window.onReply(100us + 1us * static_cast<int64_t>(in_flight));
+        }
+        if (round >= 100) {
+            largest = std::max(largest, window.window());
+        }
+    }
+
+    const auto& stats = window.stats();
+    bool ok = largest <= 64 && stats.peak_window <= 128 && stats.base_latency <= 110us;
+    std::cout << (ok ? "✓ window stayed bounded: " : "✗ window followed the queue: ")
+              << "largest " << largest << " after warm-up (peak " << stats.peak_window
+              << ", base " << stats.base_latency.count() / 1000 << " us)" << std::endl;
+    std::cout << std::endl;
+}
+
+// 窗口不低于下限
+void testMinWindow()
+{
+    std::cout << "=== Testing minimum window ===" << std::endl;
+
+    // 服务端完全串行、没有网络延迟：任何大于1的窗口都只增加排队
+    RedisAdaptiveWindow window(RedisAdaptiveWindowConfig{.initial_window = 64, .min_window = 4});
+    runRounds(window, 50, 0us, 100us);
+
+    bool ok = window.window() == 4 && window.stats().decreases > 0;
+    std::cout << (ok ? "✓ window clamped at " : "✗ window below minimum: ") << window.window() << std::endl;
+    std::cout << std::endl;
+}
+
+int main()
+{
+    std::cout << "RedisAdaptiveWindow Test" << std::endl;
+    std::cout << "======================================" << std::endl << std::endl;
+
+    testGrowWhileFlat();
+    testBackOffWhenQueueing();
+    testQueueingDoesNotRaiseBase();
+    testMinWindow();
+
+    std::cout << "All tests completed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "galay-redis/async/RedisMultiplexer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+std::atomic<int> finished_workers{0};
+std::atomic<int> error_count{0};
+
+/**
+ * @brief 单个 worker：在共享的 mux 上顺序执行 SET/GET
+ */
+Coroutine benchmarkWorker(std::shared_ptr<RedisMultiplexer> mux, int worker_id, int operations)
+{
+    for (int i = 0; i < operations; ++i) {
+        std::string key = "auto_pipe_" + std::to_string(worker_id) + "_" + std::to_string(i % 100);
+        auto set_result = co_await mux->set(key, "value");
+        if (!set_result || set_result->isError()) {
+            ++error_count;
+        }
+        auto get_result = co_await mux->get(key);
+        if (!get_result || get_result->isError()) {
+            ++error_count;
+        }
+    }
+    ++finished_workers;
+}
+
+/**
+ * @brief 所有 worker 共享一条连接，统计每条命令的 send 与读唤醒次数
+ */
+Coroutine runBenchmark(IOScheduler* scheduler, int workers, int operations, AsyncRedisConfig config)
+{
+    auto mux = RedisMultiplexer::create(scheduler, config);
+    auto connect_result = co_await mux->connect("127.0.0.1", 6379);
+    if (!connect_result) {
+        std::cerr << "Connect failed: " << connect_result.error().message() << std::endl;
+        finished_workers = workers;
+        co_return;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    for (int i = 0; i < workers; ++i) {
+        scheduler->spawn(benchmarkWorker(mux, i, operations));
+    }
+    while (finished_workers.load() < workers && !mux->isClosed()) {
+        co_await mux->ping();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    const auto& stats = mux->stats();
+    double commands = static_cast<double>(stats.completed);
+    std::cout << "Commands: " << stats.completed << " in " << elapsed << " s ("
+              << static_cast<uint64_t>(commands / elapsed) << " ops/sec)" << std::endl;
+    std::cout << "send() calls per command: " << stats.send_calls / commands << std::endl;
+    std::cout << "Commands per batch: " << commands / static_cast<double>(stats.send_batches) << std::endl;
+    std::cout << "Read wakeups per command: " << stats.read_wakeups / commands << std::endl;
+    std::cout << "Max in flight: " << stats.max_in_flight
+              << ", max replies per wakeup: " << stats.max_replies_per_wakeup
+              << ", limit flushes: " << stats.limit_flushes << std::endl;
+    std::cout << "Errors: " << error_count.load() << std::endl;
+
+    co_await mux->close();
+}
+
+int main(int argc, char* argv[])
+{
+    // 默认参数
+    int workers = 200;
+    int operations = 500;
+    AsyncRedisConfig config;
+
+    // 解析命令行参数：workers operations max_commands max_bytes
+    if (argc > 1) workers = std::atoi(argv[1]);
+    if (argc > 2) operations = std::atoi(argv[2]);
+    if (argc > 3) config.pipeline_max_commands = std::strtoul(argv[3], nullptr, 10);
+    if (argc > 4) config.pipeline_max_bytes = std::strtoul(argv[4], nullptr, 10);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Auto Pipeline Benchmark (one connection)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Workers: " << workers << std::endl;
+    std::cout << "Operations per worker: " << operations << " (SET + GET)" << std::endl;
+    std::cout << "Max commands per flush: " << config.pipeline_max_commands << std::endl;
+    std::cout << "Max bytes per flush: " << config.pipeline_max_bytes << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        scheduler->spawn(runBenchmark(scheduler, workers, operations, config));
+
+        while (finished_workers.load() < workers) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        // 等待统计输出和关闭连接
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "protocol/Connection.h"
+
+using namespace galay::redis;
+using namespace galay::redis::protocol;
+
+// 值的第 i 个字节，服务端和校验端各自生成，不需要在内存中保存整个值
+char patternAt(size_t i)
+{
+    return static_cast<char>('a' + (i * 7 + i / 4096) % 26);
+}
+
+/**
+ * @brief 本地模拟服务端：读完一条命令后回复一个 size 字节的 bulk string（边生成边发送）
+ */
+void serveOnce(int listen_fd, size_t size)
+{
+    int fd = ::accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) return;
+    char request[1024];
+    if (::recv(fd, request, sizeof(request), 0) <= 0) {
+        ::close(fd);
+        return;
+    }
+
+    std::string header = "$" + std::to_string(size) + "\r\n";
+    ::send(fd, header.data(), header.size(), 0);
+    char chunk[64 * 1024];
+    for (size_t sent = 0; sent < size;) {
+        size_t n = std::min(sizeof(chunk), size - sent);
+        for (size_t i = 0; i < n; ++i) chunk[i] = patternAt(sent + i);
+        ssize_t written = ::send(fd, chunk, n, 0);
+        if (written <= 0) break;
+        // 未写完的部分下次重新生成
+        sent += static_cast<size_t>(written);
+    }
+    ::send(fd, "\r\n", 2, 0);
+    ::close(fd);
+}
+
+int listenLoopback(int& port)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 1) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    port = ntohs(addr.sin_port);
+    return fd;
+}
+
+long peakRssKB()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// 200MB 的 GET 回复流式交给 sink：逐字节校验，进程内存峰值不随值大小增长
+void testStreamLargeValue()
+{
+    std::cout << "=== Testing streaming GET of a 200MB value ===" << std::endl;
+
+    const size_t size = 200 * 1024 * 1024;
+    int port = 0;
+    int listen_fd = listenLoopback(port);
+    if (listen_fd < 0) {
+        std::cout << "✗ Failed to listen on loopback" << std::endl;
+        return;
+    }
+    std::thread server(serveOnce, listen_fd, size);
+
+    long rss_before = peakRssKB();
+    Connection conn;
+    bool ok = conn.connect("127.0.0.1", port).has_value();
+    size_t offset = 0;
+    size_t chunks = 0;
+    bool match = true;
+    auto result = conn.executeStream(RespEncoder().encodeCommand("GET", {"blob"}),
+        [&](std::string_view chunk) {
+            for (size_t i = 0; i < chunk.size(); ++i) {
+                match = match && chunk[i] == patternAt(offset + i);
+            }
+            offset += chunk.size();
+            ++chunks;
+            return true;
+        });
+    long rss_growth = peakRssKB() - rss_before;
+
+    server.join();
+    ::close(listen_fd);
+
+    ok = ok && result && !result->null && result->length == size && offset == size && match &&
+         rss_growth < 16 * 1024;
+    std::cout << (ok ? "✓ Streamed " : "✗ Stream test failed: ") << offset / (1024 * 1024) << " MB in "
+              << chunks << " chunks, peak RSS growth " << rss_growth << " KB" << std::endl;
+    std::cout << std::endl;
+}
+
+int main()
+{
+    std::cout << "Bulk Stream Test" << std::endl;
+    std::cout << "======================================" << std::endl << std::endl;
+
+    testStreamLargeValue();
+
+    std::cout << "All tests completed!" << std::endl;
+    return 0;
+}
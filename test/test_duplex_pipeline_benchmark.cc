@@ -0,0 +1,147 @@
+#include "galay-redis/async/RedisMultiplexer.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+std::atomic<bool> g_done{false};
+
+std::vector<std::vector<std::string>> makeCommands(int count)
+{
+    std::vector<std::vector<std::string>> commands;
+    commands.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        commands.push_back({"SET", "duplex_key_" + std::to_string(i), "value_" + std::to_string(i)});
+    }
+    return commands;
+}
+
+/**
+ * @brief 全双工：RedisMultiplexer 读写协程并行，在途字节受 pipeline_max_inflight_bytes 限制
+ */
+Coroutine runAll(IOScheduler* scheduler, int port, int count)
+{
+    auto commands = makeCommands(count);
+
+    // 最后一轮不限字节数，改由自适应窗口按延迟限制在途命令数
+    struct Run { size_t inflight_bytes; bool adaptive; };
+    for (auto [inflight_bytes, adaptive] : {Run{64 * 1024, false}, Run{1024 * 1024, false},
+                                           Run{0, false}, Run{0, true}}) {
+        AsyncRedisConfig config;
+        config.pipeline_max_inflight_bytes = inflight_bytes;
+        config.adaptive_window = adaptive;
+        auto mux = RedisMultiplexer::create(scheduler, config);
+        auto connect_result = co_await mux->connect("127.0.0.1", port);
+        if (!connect_result) {
+            std::cerr << "Connect failed: " << connect_result.error().message() << std::endl;
+            break;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto result = co_await mux->pipeline(commands);
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const auto& stats = mux->stats();
+        if (!result || result->size() != commands.size()) {
+            std::cout << "✗ Duplex pipeline failed" << (result ? "" : ": " + result.error().message()) << std::endl;
+        } else {
+            std::cout << "✓ Duplex (" << (adaptive ? "adaptive window" : "budget " + std::to_string(inflight_bytes / 1024) + " KB")
+                      << "): " << commands.size()
+                      << " commands in " << elapsed * 1000 << " ms ("
+                      << static_cast<uint64_t>(commands.size() / elapsed) << " ops/sec)"
+                      << ", send calls " << stats.send_calls
+                      << ", budget waits " << stats.budget_waits
+                      << ", max unacked " << stats.max_unacked_bytes / 1024 << " KB" << std::endl;
+            if (adaptive) {
+                const auto& window = mux->windowStats();
+                std::cout << "  window " << window.window << " (peak " << window.peak_window
+                          << ", base latency " << window.base_latency.count() / 1000 << " us"
+                          << ", " << window.increases << " increases, " << window.decreases << " decreases"
+                          << ", " << stats.window_waits << " waits)" << std::endl;
+            }
+        }
+        co_await mux->close();
+    }
+
+    // 半双工对照：RedisClient::pipeline 先写完整个批次再读，服务端写满后双方互相阻塞
+    RedisClient client(scheduler);
+    auto connect_result = co_await client.connect("127.0.0.1", port);
+    if (connect_result) {
+        auto start = std::chrono::steady_clock::now();
+        size_t replies = 0;
+        std::string error;
+        while (true) {
+            auto result = co_await client.pipeline(commands).timeout(std::chrono::seconds(5));
+            if (!result) {
+                error = result.error().message();
+                break;
+            }
+            if (result->has_value()) {
+                replies = result->value().size();
+                break;
+            }
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (replies == commands.size()) {
+            std::cout << "  Half duplex: " << commands.size() << " commands in " << elapsed * 1000 << " ms ("
+                      << static_cast<uint64_t>(commands.size() / elapsed) << " ops/sec)" << std::endl;
+        } else {
+            std::cout << "  Half duplex: stalled after " << elapsed << " s (" << error << ")" << std::endl;
+        }
+        co_await client.close();
+    }
+    g_done = true;
+}
+
+int main(int argc, char* argv[])
+{
+    int count = 100000;
+    int socket_buffer = 64 * 1024;
+    if (argc > 1) count = std::atoi(argv[1]);
+    if (argc > 2) socket_buffer = std::atoi(argv[2]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Full-Duplex Pipeline Benchmark (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Commands per pipeline: " << count << std::endl;
+    std::cout << "Server socket buffer: " << socket_buffer / 1024 << " KB" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    galay::redis::test::RespTestServer server(socket_buffer);
+    if (!server.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        scheduler->spawn(runAll(scheduler, server.port(), count));
+
+        while (!g_done.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    server.stop();
+    std::cout << "Server handled " << server.commandsServed() << " commands" << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <atomic>
+#include <galay-kernel/kernel/Runtime.h>
+#include "async/RedisMultiplexer.h"
+
+using namespace galay::kernel;
+using namespace galay::redis;
+
+constexpr int kWorkers = 1000;
+constexpr int kCommandsPerWorker = 10;
+
+std::atomic<int> g_finished_workers{0};
+std::atomic<int> g_failed_commands{0};
+
+// close() 之后读写协程必须退出并释放 mux，主线程检查它已析构
+std::weak_ptr<RedisMultiplexer> g_closed_mux;
+std::atomic<bool> g_closed{false};
+
+// 每个 worker 在同一个 mux 上顺序执行若干 INCR，所有 worker 并发进行
+Coroutine worker(std::shared_ptr<RedisMultiplexer> mux)
+{
+    for (int i = 0; i < kCommandsPerWorker; ++i) {
+        auto result = co_await mux->incr("mux_test_counter");
+        if (!result || result->isError()) {
+            ++g_failed_commands;
+        }
+    }
+    ++g_finished_workers;
+}
+
+Coroutine testMultiplexer(IOScheduler* scheduler)
+{
+    std::cout << "Testing multiplexed RedisClient..." << std::endl;
+
+    auto mux = RedisMultiplexer::create(scheduler);
+    auto connect_result = co_await mux->connect("redis://127.0.0.1:6379");
+    if (!connect_result) {
+        std::cerr << "Connect failed: " << connect_result.error().message() << std::endl;
+        co_return;
+    }
+
+    auto del_result = co_await mux->del("mux_test_counter");
+    if (!del_result) {
+        std::cerr << "DEL failed: " << del_result.error().message() << std::endl;
+        co_return;
+    }
+
+    for (int i = 0; i < kWorkers; ++i) {
+        scheduler->spawn(worker(mux));
+    }
+
+    // 所有 worker 都在这一条连接上排队，这里的 PING 与它们交错执行
+    while (g_finished_workers.load() < kWorkers && !mux->isClosed()) {
+        co_await mux->ping();
+    }
+
+    auto get_result = co_await mux->get("mux_test_counter");
+
+    if (!get_result || get_result->isNull()) {
+        std::cerr << "✗ GET failed" << std::endl;
+    } else {
+        bool ok = get_result->toString() == std::to_string(kWorkers * kCommandsPerWorker) &&
+                  g_failed_commands.load() == 0;
+        const auto& stats = mux->stats();
+        std::cout << (ok ? "✓ " : "✗ ") << "counter = " << get_result->toString()
+                  << ", submitted " << stats.submitted
+                  << ", send batches " << stats.send_batches
+                  << ", max in flight " << stats.max_in_flight
+                  << ", max replies per wakeup " << stats.max_replies_per_wakeup << std::endl;
+    }
+
+    co_await mux->close();
+    std::cout << "Connection closed" << std::endl;
+    g_closed_mux = mux;
+    mux.reset();
+    g_closed = true;
+}
+
+int main()
+{
+    std::cout << "Multiplexer Test" << std::endl;
+    std::cout << "======================================" << std::endl << std::endl;
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        scheduler->spawn(testMultiplexer(scheduler));
+
+        // 等待测试完成（最多 10 秒）
+        auto limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!g_closed.load() && std::chrono::steady_clock::now() < limit) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        // 读协程挂在没有数据的 recv 上，close() 后它仍须在一个接收时限内退出
+        if (g_closed.load()) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while (!g_closed_mux.expired() && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            bool destroyed = g_closed_mux.expired();
+            std::cout << (destroyed ? "✓ " : "✗ ") << "multiplexer destroyed after close()" << std::endl;
+            if (!destroyed) {
+                runtime.stop();
+                return 1;
+            }
+        }
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All tests completed!" << std::endl;
+    return 0;
+}
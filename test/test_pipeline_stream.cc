@@ -0,0 +1,122 @@
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <sys/resource.h>
+#include <galay-kernel/kernel/Runtime.h>
+#include "async/RedisClient.h"
+
+using namespace galay::kernel;
+using namespace galay::redis;
+
+constexpr size_t kTotalCommands = 1000000;
+
+std::atomic<bool> g_done{false};
+
+long peakRssKB()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// 100万条 SET 经一条连接流式发送：回复逐条校验，进程内存峰值不随命令数增长
+Coroutine testPipelineStream(IOScheduler* scheduler)
+{
+    std::cout << "=== Testing streaming pipeline of " << kTotalCommands << " commands ===" << std::endl;
+
+    RedisClient client(scheduler);
+    auto connect_result = co_await client.connect("127.0.0.1", 6379);
+    if (!connect_result) {
+        std::cerr << "Connect failed: " << connect_result.error().message() << std::endl;
+        g_done = true;
+        co_return;
+    }
+
+    size_t next = 0;
+    size_t ok_replies = 0;
+    bool in_order = true;
+    auto source = [&](std::vector<std::string>& command) {
+        if (next == kTotalCommands) {
+            return false;
+        }
+        command = {"SET", "stream_key_" + std::to_string(next % 1000), std::to_string(next)};
+        ++next;
+        return true;
+    };
+    auto handler = [&](size_t index, RedisValue value) {
+        in_order = in_order && index == ok_replies;
+        if (value.isStatus() && value.toStatus() == "OK") {
+            ++ok_replies;
+        }
+        return true;
+    };
+
+    long rss_before = peakRssKB();
+    auto start = std::chrono::steady_clock::now();
+    std::expected<std::optional<RedisPipelineStreamSummary>, RedisError> result = std::nullopt;
+    do {
+        result = co_await client.pipelineStream(source, handler);
+    } while (result && !result->has_value());
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    long rss_growth = peakRssKB() - rss_before;
+
+    if (!result) {
+        std::cerr << "✗ Pipeline stream failed: " << result.error().message() << std::endl;
+    } else {
+        const auto& summary = result->value();
+        bool ok = summary.commands == kTotalCommands && ok_replies == kTotalCommands && in_order &&
+                  summary.max_in_flight <= AsyncRedisConfig().pipeline_window && rss_growth < 16 * 1024;
+        std::cout << (ok ? "✓ " : "✗ ") << summary.commands << " replies in " << elapsed << " s, "
+                  << "max in flight " << summary.max_in_flight << ", peak RSS growth " << rss_growth << " KB"
+                  << std::endl;
+    }
+
+    // handler 中途停止：剩余回复被读完丢弃，连接仍然可用
+    size_t stop_after = 10;
+    next = 0;
+    auto stopping = [&](size_t index, RedisValue) { return index + 1 < stop_after; };
+    do {
+        result = co_await client.pipelineStream(source, stopping);
+    } while (result && !result->has_value());
+    auto ping = co_await client.ping();
+    while (ping && !ping.value().has_value()) {
+        ping = co_await client.ping();
+    }
+    bool stopped_ok = !result && result.error().type() == REDIS_ERROR_TYPE_INVALID_ERROR &&
+                      ping && ping.value().has_value();
+    std::cout << (stopped_ok ? "✓ " : "✗ ") << "Handler stop leaves connection usable" << std::endl;
+
+    co_await client.close();
+    g_done = true;
+}
+
+int main()
+{
+    std::cout << "Pipeline Stream Test" << std::endl;
+    std::cout << "======================================" << std::endl << std::endl;
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        scheduler->spawn(testPipelineStream(scheduler));
+
+        while (!g_done.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All tests completed!" << std::endl;
+    return 0;
+}
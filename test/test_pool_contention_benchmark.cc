@@ -0,0 +1,145 @@
+#include "galay-redis/async/RedisConnectionPool.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+std::atomic<int> g_finished{0};
+std::atomic<uint64_t> g_acquired{0};
+std::atomic<uint64_t> g_failures{0};
+
+/**
+ * @brief 多个调度线程同时获取 / 归还连接，衡量连接池本身的争用
+ * @details with_io 为 false 时只做 acquire + release，不访问网络，争用全部落在连接池上
+ */
+Coroutine worker(RedisConnectionPool& pool, IOScheduler* scheduler, int rounds, bool with_io)
+{
+    for (int i = 0; i < rounds; ++i) {
+        auto result = co_await pool.acquire(scheduler);
+        if (!result) {
+            ++g_failures;
+            continue;
+        }
+        if (with_io) {
+            auto ping = co_await result.value()->get()->ping();
+            if (!ping || !ping->has_value()) {
+                ++g_failures;
+            }
+        }
+        ++g_acquired;
+        pool.release(result.value());
+    }
+    ++g_finished;
+}
+
+Coroutine initPool(RedisConnectionPool& pool, std::atomic<int>& state)
+{
+    auto result = co_await pool.initialize();
+    if (!result) {
+        std::cerr << "Initialize failed: " << result.error().message() << std::endl;
+    }
+    state = result ? 1 : -1;
+}
+
+static bool runOnce(Runtime& runtime, int port, size_t shard_count, int schedulers, int workers,
+                    int rounds, size_t connections, bool with_io)
+{
+    auto config = ConnectionPoolConfig::create("127.0.0.1", port, connections, connections);
+    config.shard_count = shard_count;
+    config.acquire_timeout = std::chrono::seconds(10);
+
+    std::vector<IOScheduler*> scheduler_list;
+    for (int i = 0; i < schedulers; ++i) {
+        scheduler_list.push_back(runtime.getNextIOScheduler());
+    }
+
+    RedisConnectionPool pool(scheduler_list.front(), config);
+    std::atomic<int> state{0};
+    scheduler_list.front()->spawn(initPool(pool, state));
+    while (state.load() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (state.load() < 0) {
+        return false;
+    }
+
+    g_finished = 0;
+    g_acquired = 0;
+    g_failures = 0;
+    int total_workers = schedulers * workers;
+    auto start = std::chrono::steady_clock::now();
+    for (auto* scheduler : scheduler_list) {
+        for (int i = 0; i < workers; ++i) {
+            scheduler->spawn(worker(pool, scheduler, rounds, with_io));
+        }
+    }
+    while (g_finished.load() < total_workers) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto stats = pool.getStats();
+    std::cout << (g_failures == 0 ? "✓ " : "✗ ")
+              << (shard_count > 0 ? "sharded (" + std::to_string(shard_count) + " shards)" : std::string("mutex"))
+              << ": " << g_acquired.load() << " acquire/release in " << elapsed * 1000 << " ms ("
+              << static_cast<uint64_t>(g_acquired.load() / elapsed) << " ops/sec), avg acquire "
+              << stats.avg_acquire_time_ms << " ms, max " << stats.max_acquire_time_ms << " ms"
+              << (g_failures ? ", " + std::to_string(g_failures.load()) + " failures" : "") << std::endl;
+
+    pool.shutdown();
+    return g_failures == 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int schedulers = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    int workers = 8;
+    int rounds = 100000;
+    bool with_io = false;
+    if (argc > 1) schedulers = std::atoi(argv[1]);
+    if (argc > 2) workers = std::atoi(argv[2]);
+    if (argc > 3) rounds = std::atoi(argv[3]);
+    if (argc > 4) with_io = std::string(argv[4]) == "io";
+
+    size_t connections = static_cast<size_t>(schedulers) * 2;
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Connection Pool Contention Benchmark (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Schedulers: " << schedulers << ", workers per scheduler: " << workers
+              << ", rounds: " << rounds << ", connections: " << connections
+              << ", mode: " << (with_io ? "acquire + PING + release" : "acquire + release") << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    if (!server.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    bool passed = true;
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        // 全局互斥锁模式对比按调度器分片模式
+        passed &= runOnce(runtime, server.port(), 0, schedulers, workers, rounds, connections, with_io);
+        passed &= runOnce(runtime, server.port(), static_cast<size_t>(schedulers), schedulers, workers, rounds,
+                          connections, with_io);
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    server.stop();
+    return passed ? 0 : 1;
+}
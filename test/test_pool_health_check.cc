@@ -0,0 +1,213 @@
+#include "galay-redis/async/RedisConnectionPool.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+/**
+ * @brief 后台健康检查：周期性并发 PING 空闲连接，服务端断开后失效连接被剔除并在后台重连
+ * @details 主线程只观察统计信息，不调用 triggerHealthCheck，探测全部由连接池的定时器发起
+ */
+int g_failures = 0;
+
+static void check(bool ok, const std::string& what)
+{
+    std::cout << (ok ? "✓ " : "✗ ") << what << std::endl;
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+template <typename Pred>
+static bool waitFor(Pred pred, std::chrono::milliseconds limit = std::chrono::seconds(5))
+{
+    auto deadline = std::chrono::steady_clock::now() + limit;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+Coroutine initPool(RedisConnectionPool& pool, std::atomic<int>& state)
+{
+    auto result = co_await pool.initialize();
+    if (!result) {
+        std::cerr << "Initialize failed: " << result.error().message() << std::endl;
+    }
+    state = result ? 1 : -1;
+}
+
+Coroutine acquireAndPing(RedisConnectionPool& pool, std::atomic<int>& state, std::atomic<long>& acquire_us)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto result = co_await pool.acquire();
+    acquire_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+                     .count();
+    if (!result) {
+        state = -1;
+        co_return;
+    }
+    auto ping = co_await result.value()->get()->ping();
+    state = ping && ping->has_value() && ping->value()[0].isStatus() ? 1 : -1;
+    pool.release(result.value());
+}
+
+Coroutine watchConnections(RedisConnectionPool& pool, size_t count,
+                           std::vector<std::weak_ptr<PooledConnection>>& watched, std::atomic<int>& state)
+{
+    std::vector<std::shared_ptr<PooledConnection>> held;
+    for (size_t i = 0; i < count; ++i) {
+        auto result = co_await pool.acquire();
+        if (!result) {
+            state = -1;
+            co_return;
+        }
+        watched.push_back(result.value());
+        held.push_back(result.value());
+    }
+    for (auto& conn : held) {
+        pool.release(conn);
+    }
+    state = 1;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t connections = 4;
+    std::chrono::milliseconds interval{100};
+    if (argc > 1) connections = static_cast<size_t>(std::atoi(argv[1]));
+    if (argc > 2) interval = std::chrono::milliseconds(std::atoi(argv[2]));
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Connection Pool Background Health Check Test (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Connections: " << connections << ", health_check_interval: " << interval.count() << " ms"
+              << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    if (!server.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        auto config = ConnectionPoolConfig::create("127.0.0.1", server.port(), connections, connections);
+        config.health_check_interval = interval;
+        config.health_check_timeout = std::chrono::milliseconds(200);
+        RedisConnectionPool pool(scheduler, config);
+
+        std::atomic<int> state{0};
+        scheduler->spawn(initPool(pool, state));
+        waitFor([&] { return state.load() != 0; });
+        check(state == 1, "pool initialized with " + std::to_string(connections) + " connections");
+
+        // 1. 健康的空闲连接每个周期都被 PING，且全部通过
+        size_t commands_before = server.commandsServed();
+        std::this_thread::sleep_for(interval * 4);
+        auto stats = pool.getStats();
+        size_t probes = server.commandsServed() - commands_before;
+        check(probes >= connections, "background probes sent " + std::to_string(probes) + " PINGs");
+        check(stats.health_check_failures == 0 && stats.total_connections == connections,
+              "healthy connections pass and stay in the pool");
+
+        // 2. 服务端断开所有连接：探测失败的连接被剔除并在后台重连
+        size_t accepted_before = server.connectionsAccepted();
+        server.dropConnections();
+        bool recovered = waitFor([&] {
+            auto s = pool.getStats();
+            return s.health_check_failures >= connections &&
+                   server.connectionsAccepted() >= accepted_before + connections &&
+                   s.total_connections == connections && s.pending_connections == 0;
+        });
+        stats = pool.getStats();
+        check(recovered, "dead connections detected (" + std::to_string(stats.health_check_failures) +
+                             " failed probes) and replaced (" +
+                             std::to_string(server.connectionsAccepted() - accepted_before) + " reconnects)");
+
+        // 3. 调用方拿到的是重连后的连接，不会碰到已断开的 socket
+        std::atomic<long> acquire_us{0};
+        state = 0;
+        scheduler->spawn(acquireAndPing(pool, state, acquire_us));
+        waitFor([&] { return state.load() != 0; });
+        check(state == 1, "acquired connection answers PING after the outage (acquire took " +
+                              std::to_string(acquire_us.load()) + " us)");
+
+        pool.shutdown();
+
+        // 4. PING 慢于 health_check_timeout：超时即判定失败，被放弃的 PING 挂在内核中时连接仍安全移除
+        galay::redis::test::RespTestServer slow_server;
+        slow_server.setReplyDelay(interval * 2);
+        if (slow_server.start()) {
+            auto slow_config = ConnectionPoolConfig::create("127.0.0.1", slow_server.port(), connections, connections);
+            slow_config.health_check_interval = interval;
+            slow_config.health_check_timeout = interval / 4;
+            RedisConnectionPool slow_pool(scheduler, slow_config);
+            state = 0;
+            scheduler->spawn(initPool(slow_pool, state));
+            waitFor([&] { return state.load() != 0; });
+            bool timed_out = waitFor([&] { return slow_pool.getStats().health_check_failures >= connections; });
+            check(state == 1 && timed_out, "slow PINGs time out and are counted as failures (" +
+                                               std::to_string(slow_pool.getStats().health_check_failures) + ")");
+            slow_pool.shutdown();
+        }
+
+        // 5. 服务端接受连接但不再回复：PING 永远等不到回复，超时取消内核 IO 后连接被剔除，
+        //    客户端关闭 socket 并随连接一起释放，没有挂在内核中的 IO 把它保留下来
+        galay::redis::test::RespTestServer hung_server;
+        if (hung_server.start()) {
+            auto hung_config = ConnectionPoolConfig::create("127.0.0.1", hung_server.port(), 0, connections);
+            hung_config.initial_connections = connections;
+            hung_config.enable_auto_reconnect = false;
+            hung_config.health_check_interval = interval;
+            hung_config.health_check_timeout = interval / 4;
+            RedisConnectionPool hung_pool(scheduler, hung_config);
+            state = 0;
+            scheduler->spawn(initPool(hung_pool, state));
+            waitFor([&] { return state.load() != 0; });
+
+            std::vector<std::weak_ptr<PooledConnection>> watched;
+            state = 0;
+            scheduler->spawn(watchConnections(hung_pool, connections, watched, state));
+            waitFor([&] { return state.load() != 0; });
+            check(state == 1, "acquired and released all connections of the pool");
+
+            hung_server.setSilent(true);
+            bool freed = waitFor([&] {
+                return hung_pool.getStats().total_connections == 0 && hung_server.openConnections() == 0 &&
+                       std::all_of(watched.begin(), watched.end(), [](auto& conn) { return conn.expired(); });
+            });
+            check(freed && hung_pool.getStats().health_check_failures >= connections,
+                  "connections whose PING never gets a reply are removed, closed and freed (" +
+                      std::to_string(hung_server.openConnections()) + " sockets still open)");
+            hung_pool.shutdown();
+        }
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    server.stop();
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include "galay-redis/async/RedisConnectionPool.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+std::atomic<bool> g_done{false};
+std::atomic<int> g_failures{0};
+
+static void check(bool ok, const std::string& what)
+{
+    std::cout << (ok ? "✓ " : "✗ ") << what << std::endl;
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 服务端每批回复延迟 delay，每个连接握手需要 AUTH + SELECT 两次往返
+ *        串行建立 N 个连接约 2 * N * delay，并发建立约 2 * delay
+ */
+Coroutine runAll(IOScheduler* scheduler, int port, int silent_port, std::chrono::milliseconds delay, size_t initial)
+{
+    auto config = ConnectionPoolConfig::create("127.0.0.1", port, initial, initial * 2);
+    config.password = "secret";
+    config.db_index = 1;
+    config.connect_timeout = std::chrono::seconds(5);
+
+    RedisConnectionPool pool(scheduler, config);
+    const double serial_ms = 2.0 * static_cast<double>(initial) * static_cast<double>(delay.count());
+
+    // 1. 初始化：initial 个连接并发握手
+    auto start = std::chrono::steady_clock::now();
+    auto init_result = co_await pool.initialize();
+    double init_ms = elapsedMs(start);
+    check(init_result.has_value(), "initialize " + std::to_string(initial) + " connections in " +
+                                       std::to_string(init_ms) + " ms (serial would be ~" +
+                                       std::to_string(serial_ms) + " ms)");
+    if (!init_result) {
+        std::cerr << "  " << init_result.error().message() << std::endl;
+        g_done = true;
+        co_return;
+    }
+    check(init_ms < serial_ms / 2, "initial connections were established concurrently");
+
+    auto stats = pool.getStats();
+    check(stats.total_connections == initial && stats.available_connections == initial,
+          "all initial connections are handshaken and available (total=" +
+              std::to_string(stats.total_connections) + ", available=" +
+              std::to_string(stats.available_connections) + ")");
+
+    // 2. 取出的连接可以直接使用
+    auto conn_result = co_await pool.acquire();
+    check(conn_result.has_value(), "acquire an initialized connection");
+    if (conn_result) {
+        auto ping = co_await conn_result.value()->get()->ping();
+        check(ping && ping->has_value() && ping->value()[0].isStatus(), "PING on pooled connection");
+        pool.release(conn_result.value());
+    }
+
+    // 3. expandPool：超出 max_connections 的部分被忽略
+    start = std::chrono::steady_clock::now();
+    auto expanded = co_await pool.expandPool(initial * 4);
+    double expand_ms = elapsedMs(start);
+    check(expanded && expanded.value() == initial, "expandPool created " +
+                                                      std::to_string(expanded ? expanded.value() : 0) +
+                                                      " connections in " + std::to_string(expand_ms) + " ms");
+    stats = pool.getStats();
+    check(stats.total_connections == initial * 2 && stats.pending_connections == 0,
+          "pool is at max_connections after expandPool");
+
+    // 4. 缩回后，acquire 在没有空闲连接时新建连接并直接交给调用方
+    pool.shrinkPool(initial);
+    std::vector<std::shared_ptr<PooledConnection>> held;
+    for (size_t i = 0; i < initial; ++i) {
+        auto result = co_await pool.acquire();
+        if (result) {
+            held.push_back(result.value());
+        }
+    }
+    auto grown = co_await pool.acquire();
+    check(grown.has_value(), "acquire grows the pool when no connection is idle");
+    if (grown) {
+        auto ping = co_await grown.value()->get()->ping();
+        check(ping && ping->has_value(), "PING on connection created by acquire");
+        held.push_back(grown.value());
+    }
+    stats = pool.getStats();
+    check(stats.total_connections == initial + 1 && stats.available_connections == 0,
+          "connection created for acquire is not placed in the available queue");
+    for (auto& conn : held) {
+        pool.release(conn);
+    }
+
+    pool.shutdown();
+
+    // 5. 握手超时：AUTH 的回复迟于 connect_timeout，超时取消内核 IO 后客户端被关闭并释放
+    auto slow = config;
+    slow.connect_timeout = delay / 2;
+    slow.max_reconnect_attempts = 2;
+    RedisConnectionPool timed_out(scheduler, slow);
+    auto slow_result = co_await timed_out.initialize();
+    check(!slow_result && timed_out.getStats().total_connections == 0,
+          "handshakes slower than connect_timeout fail initialize without keeping any connection");
+    timed_out.shutdown();
+
+    // 6. 服务端接受连接但从不回复：AUTH 永远等不到回复，超时后客户端关闭 socket 并释放，
+    //    没有挂在内核中的 IO 把它保留下来（socket 是否全部关闭由主线程检查）
+    auto hung = slow;
+    hung.port = silent_port;
+    RedisConnectionPool silent_pool(scheduler, hung);
+    start = std::chrono::steady_clock::now();
+    auto hung_result = co_await silent_pool.initialize();
+    double hung_ms = elapsedMs(start);
+    check(!hung_result && silent_pool.getStats().total_connections == 0,
+          "handshakes against a server that never replies time out in " + std::to_string(hung_ms) + " ms");
+    silent_pool.shutdown();
+    g_done = true;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t initial = 8;
+    std::chrono::milliseconds delay{100};
+    if (argc > 1) initial = static_cast<size_t>(std::atoi(argv[1]));
+    if (argc > 2) delay = std::chrono::milliseconds(std::atoi(argv[2]));
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Connection Pool Parallel Connect Test (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Connections: " << initial << ", reply delay: " << delay.count() << " ms" << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    server.setReplyDelay(delay);
+    galay::redis::test::RespTestServer silent;
+    silent.setSilent(true);
+    if (!server.start() || !silent.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        scheduler->spawn(runAll(scheduler, server.port(), silent.port(), delay, initial));
+
+        while (!g_done.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        // 每个握手超时的客户端都关闭了自己的 socket：静默服务端读到 EOF，不再有打开的连接
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (silent.openConnections() > 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        check(silent.connectionsAccepted() == initial * 2 && silent.openConnections() == 0,
+              "all " + std::to_string(silent.connectionsAccepted()) +
+                  " timed out handshakes closed their sockets (open: " +
+                  std::to_string(silent.openConnections()) + ")");
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    silent.stop();
+    server.stop();
+    std::cout << "Server accepted " << server.connectionsAccepted() << " connections" << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
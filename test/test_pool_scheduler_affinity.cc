@@ -0,0 +1,204 @@
+#include "galay-redis/async/RedisConnectionPool.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+/**
+ * @brief 调度器亲和：连接只在所属调度器上使用、每调度器最少连接数、达到上限时跨调度器迁移
+ */
+std::atomic<int> g_finished{0};
+std::atomic<int> g_mismatches{0};
+std::atomic<int> g_errors{0};
+int g_failures = 0;
+
+static void check(bool ok, const std::string& what)
+{
+    std::cout << (ok ? "✓ " : "✗ ") << what << std::endl;
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+template <typename Pred>
+static bool waitFor(Pred pred, std::chrono::milliseconds limit = std::chrono::seconds(10))
+{
+    auto deadline = std::chrono::steady_clock::now() + limit;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+Coroutine initPool(RedisConnectionPool& pool, std::atomic<int>& state)
+{
+    auto result = co_await pool.initialize();
+    if (!result) {
+        std::cerr << "Initialize failed: " << result.error().message() << std::endl;
+    }
+    state = result ? 1 : -1;
+}
+
+Coroutine worker(RedisConnectionPool& pool, IOScheduler* scheduler, int rounds)
+{
+    co_await pool.warmup(scheduler);
+    for (int i = 0; i < rounds; ++i) {
+        auto result = co_await pool.acquire(scheduler);
+        if (!result) {
+            ++g_errors;
+            continue;
+        }
+        auto conn = result.value();
+        if (conn->scheduler() != scheduler) {
+            ++g_mismatches;
+        }
+        auto ping = co_await conn->get()->ping();
+        if (!ping || !ping->has_value()) {
+            ++g_errors;
+        }
+        pool.release(conn);
+    }
+    ++g_finished;
+}
+
+Coroutine holdAndRelease(RedisConnectionPool& pool, IOScheduler* scheduler, size_t count, std::atomic<int>& done)
+{
+    std::vector<std::shared_ptr<PooledConnection>> held;
+    for (size_t i = 0; i < count; ++i) {
+        auto result = co_await pool.acquire(scheduler);
+        if (result) {
+            held.push_back(result.value());
+        }
+    }
+    for (auto& conn : held) {
+        pool.release(conn);
+    }
+    done = static_cast<int>(held.size());
+}
+
+Coroutine acquireOn(RedisConnectionPool& pool, IOScheduler* scheduler, std::atomic<int>& done)
+{
+    auto result = co_await pool.acquire(scheduler);
+    if (result && result.value()->scheduler() == scheduler) {
+        auto ping = co_await result.value()->get()->ping();
+        done = ping && ping->has_value() ? 1 : -1;
+        pool.release(result.value());
+    } else {
+        done = -1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int schedulers = 4;
+    int workers = 4;
+    int rounds = 1000;
+    if (argc > 1) schedulers = std::atoi(argv[1]);
+    if (argc > 2) workers = std::atoi(argv[2]);
+    if (argc > 3) rounds = std::atoi(argv[3]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Connection Pool Scheduler Affinity Test (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    if (!server.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        std::vector<IOScheduler*> scheduler_list;
+        for (int i = 0; i < schedulers; ++i) {
+            auto* scheduler = runtime.getNextIOScheduler();
+            if (std::find(scheduler_list.begin(), scheduler_list.end(), scheduler) == scheduler_list.end()) {
+                scheduler_list.push_back(scheduler);
+            }
+        }
+        std::cout << "Distinct schedulers: " << scheduler_list.size() << std::endl;
+
+        // 1. 每个调度器上的协程只拿到本调度器的连接，并预热到每调度器最少连接数
+        {
+            auto config = ConnectionPoolConfig::create("127.0.0.1", server.port(), 1, scheduler_list.size() * 2);
+            config.shard_count = scheduler_list.size();
+            config.scheduler_affinity = true;
+            config.min_connections_per_scheduler = 2;
+            config.acquire_timeout = std::chrono::seconds(5);
+
+            RedisConnectionPool pool(scheduler_list.front(), config);
+            std::atomic<int> state{0};
+            scheduler_list.front()->spawn(initPool(pool, state));
+            waitFor([&] { return state.load() != 0; });
+            check(state == 1, "affinity pool initialized");
+
+            for (auto* scheduler : scheduler_list) {
+                for (int i = 0; i < workers; ++i) {
+                    scheduler->spawn(worker(pool, scheduler, rounds));
+                }
+            }
+            int total_workers = static_cast<int>(scheduler_list.size()) * workers;
+            waitFor([&] { return g_finished.load() == total_workers; }, std::chrono::seconds(60));
+
+            auto stats = pool.getStats();
+            check(g_finished == total_workers && g_errors == 0,
+                  std::to_string(total_workers) + " workers x " + std::to_string(rounds) + " acquires, " +
+                      std::to_string(g_errors.load()) + " errors");
+            check(g_mismatches == 0, "every connection was used on the scheduler that created it");
+            check(stats.total_connections == config.max_connections,
+                  "each scheduler warmed up to min_connections_per_scheduler (total=" +
+                      std::to_string(stats.total_connections) + ")");
+            pool.shutdown();
+        }
+
+        // 2. 已达 max_connections 时，空闲连接从有余量的调度器迁移到缺连接的调度器
+        if (scheduler_list.size() >= 2) {
+            auto config = ConnectionPoolConfig::create("127.0.0.1", server.port(), 0, 2);
+            config.shard_count = scheduler_list.size();
+            config.scheduler_affinity = true;
+            config.acquire_timeout = std::chrono::seconds(5);
+
+            RedisConnectionPool pool(scheduler_list[0], config);
+            std::atomic<int> state{0};
+            scheduler_list[0]->spawn(initPool(pool, state));
+            waitFor([&] { return state.load() != 0; });
+
+            std::atomic<int> held{0};
+            scheduler_list[0]->spawn(holdAndRelease(pool, scheduler_list[0], 2, held));
+            waitFor([&] { return held.load() != 0; });
+            check(held == 2 && pool.getStats().total_connections == 2,
+                  "first scheduler owns all connections at max_connections");
+
+            std::atomic<int> done{0};
+            scheduler_list[1]->spawn(acquireOn(pool, scheduler_list[1], done));
+            waitFor([&] { return done.load() != 0; });
+            auto stats = pool.getStats();
+            check(done == 1, "second scheduler got a connection of its own");
+            check(stats.total_migrated == 1 && stats.total_connections == 2,
+                  "one idle connection migrated, pool stays at max_connections");
+            pool.shutdown();
+        } else {
+            std::cout << "- migration check skipped: runtime has a single IO scheduler" << std::endl;
+        }
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    server.stop();
+    return g_failures == 0 ? 0 : 1;
+}
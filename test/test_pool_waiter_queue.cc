@@ -0,0 +1,197 @@
+#include "galay-redis/async/RedisConnectionPool.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+/**
+ * @brief 排队获取连接：FIFO 移交、acquire_timeout 超时、突发负载
+ * @details 主线程持有 / 归还连接并按时间顺序发起排队，调用方协程在调度器上恢复
+ */
+struct Shared
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<PooledConnection>> held;
+    std::vector<int> order;
+    std::atomic<int> finished{0};
+    std::atomic<int> timeouts{0};
+    std::atomic<bool> ready{false};
+    std::atomic<bool> init_ok{false};
+    std::atomic<int> burst_done{0};
+    std::atomic<int> burst_failures{0};
+};
+
+int g_failures = 0;
+
+static void check(bool ok, const std::string& what)
+{
+    std::cout << (ok ? "✓ " : "✗ ") << what << std::endl;
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+template <typename Pred>
+static bool waitFor(Pred pred, std::chrono::milliseconds limit = std::chrono::seconds(5))
+{
+    auto deadline = std::chrono::steady_clock::now() + limit;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static std::shared_ptr<PooledConnection> takeHeld(Shared& shared)
+{
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    auto conn = shared.held.front();
+    shared.held.erase(shared.held.begin());
+    return conn;
+}
+
+Coroutine initAndHold(RedisConnectionPool& pool, Shared& shared, size_t hold)
+{
+    auto init_result = co_await pool.initialize();
+    if (init_result) {
+        shared.init_ok = true;
+        for (size_t i = 0; i < hold; ++i) {
+            auto result = co_await pool.acquire();
+            if (result) {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                shared.held.push_back(result.value());
+            }
+        }
+    } else {
+        std::cerr << "Initialize failed: " << init_result.error().message() << std::endl;
+    }
+    shared.ready = true;
+}
+
+Coroutine waiter(RedisConnectionPool& pool, Shared& shared, int id)
+{
+    auto result = co_await pool.acquire();
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (result) {
+            shared.order.push_back(id);
+            shared.held.push_back(result.value());
+        } else if (result.error().type() == RedisErrorType::REDIS_ERROR_TYPE_TIMEOUT_ERROR) {
+            ++shared.timeouts;
+        }
+    }
+    ++shared.finished;
+}
+
+Coroutine burstWorker(RedisConnectionPool& pool, Shared& shared, int rounds)
+{
+    for (int i = 0; i < rounds; ++i) {
+        auto result = co_await pool.acquire();
+        if (!result) {
+            ++shared.burst_failures;
+            continue;
+        }
+        auto ping = co_await result.value()->get()->ping();
+        if (!ping || !ping->has_value()) {
+            ++shared.burst_failures;
+        }
+        pool.release(result.value());
+    }
+    ++shared.burst_done;
+}
+
+int main(int argc, char* argv[])
+{
+    int workers = 64;
+    int rounds = 20;
+    if (argc > 1) workers = std::atoi(argv[1]);
+    if (argc > 2) rounds = std::atoi(argv[2]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Connection Pool Waiter Queue Test (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    if (!server.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        auto config = ConnectionPoolConfig::create("127.0.0.1", server.port(), 2, 2);
+        config.acquire_timeout = std::chrono::milliseconds(300);
+        auto pool = std::make_unique<RedisConnectionPool>(scheduler, config);
+        Shared shared;
+
+        // 1. 占满全部连接
+        scheduler->spawn(initAndHold(*pool, shared, 2));
+        waitFor([&] { return shared.ready.load(); });
+        check(shared.init_ok && shared.held.size() == 2, "pool initialized and both connections held");
+
+        // 2. 三个调用方依次排队
+        for (int id = 0; id < 3; ++id) {
+            scheduler->spawn(waiter(*pool, shared, id));
+            waitFor([&] { return pool->getStats().waiting_requests == static_cast<size_t>(id + 1); });
+        }
+        check(pool->getStats().waiting_requests == 3, "three callers are queued instead of failing");
+
+        // 3. 逐个归还，连接按排队顺序移交
+        for (int i = 0; i < 3; ++i) {
+            pool->release(takeHeld(shared));
+            waitFor([&] { return shared.finished.load() == i + 1; });
+        }
+        check(shared.order == std::vector<int>({0, 1, 2}), "released connections were handed over in FIFO order");
+        check(pool->getStats().available_connections == 0, "handed-over connections bypass the available queue");
+
+        // 4. 没有连接归还时排队超时
+        auto start = std::chrono::steady_clock::now();
+        scheduler->spawn(waiter(*pool, shared, 3));
+        waitFor([&] { return shared.finished.load() == 4; });
+        auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        check(shared.timeouts == 1 && waited >= config.acquire_timeout,
+              "acquire timed out after " + std::to_string(waited.count()) + " ms");
+        check(pool->getStats().waiting_requests == 0, "timed-out caller left the queue");
+
+        // 5. 突发负载：大量协程共享两个连接，短暂排队而不是失败
+        while (!shared.held.empty()) {
+            pool->release(takeHeld(shared));
+        }
+        for (int i = 0; i < workers; ++i) {
+            scheduler->spawn(burstWorker(*pool, shared, rounds));
+        }
+        waitFor([&] { return shared.burst_done.load() == workers; }, std::chrono::seconds(30));
+        check(shared.burst_done == workers && shared.burst_failures == 0,
+              std::to_string(workers) + " workers x " + std::to_string(rounds) + " acquires over 2 connections, " +
+                  std::to_string(shared.burst_failures.load()) + " failures");
+
+        auto stats = pool->getStats();
+        std::cout << "  avg acquire " << stats.avg_acquire_time_ms << " ms, max " << stats.max_acquire_time_ms
+                  << " ms" << std::endl;
+
+        pool->shutdown();
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    server.stop();
+    return g_failures == 0 ? 0 : 1;
+}
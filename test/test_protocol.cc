@@ -1,5 +1,18 @@
 #include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <utility>
 #include "protocol/RedisProtocol.h"
+#include "protocol/RespScanner.h"
+#include "protocol/RedisReplyView.h"
+#include "protocol/RespArena.h"
+#include "protocol/RespTape.h"
+#include "protocol/RespVisitor.h"
+#include "protocol/RespStream.h"
+#include "protocol/RespDecode.h"
+#include "protocol/RespCommand.h"
+#include "protocol/RespVectored.h"
+#include "base/RedisValue.h"
 
 using namespace galay::redis::protocol;
 
@@ -117,6 +130,550 @@ void testParser() {
     std::cout << std::endl;
 }
 
+// 测试增量解析（数据分多次到达）
+void testIncrementalParse() {
+    std::cout << "=== Testing Incremental Parse ===" << std::endl;
+
+    // 逐字节喂入嵌套数组，只有最后一个字节到达时才完成
+    {
+        RespParser parser;
+        std::string data = "*3\r\n$5\r\nhello\r\n*2\r\n:1\r\n+OK\r\n%1\r\n+k\r\n$1\r\nv\r\n";
+        bool ok = true;
+        for (size_t len = 1; len < data.size(); ++len) {
+            auto result = parser.parse(data.data(), len);
+            if (result || result.error() != ParseError::Incomplete) {
+                ok = false;
+                break;
+            }
+        }
+        auto result = parser.parse(data.data(), data.size());
+        if (ok && result && result->first == data.size() && result->second.isArray()) {
+            auto& arr = result->second.asArray();
+            ok = arr.size() == 3 && arr[0].asString() == "hello" &&
+                 arr[1].asArray().size() == 2 && arr[1].asArray()[1].asString() == "OK" &&
+                 arr[2].isMap() && arr[2].asMap()[0].second.asString() == "v";
+        } else {
+            ok = false;
+        }
+        std::cout << (ok ? "✓ Byte-by-byte nested reply parsed correctly"
+                         : "✗ Byte-by-byte nested reply test failed") << std::endl;
+    }
+
+    // 帧完成后解析器自动复位，可以继续解析下一帧
+    {
+        RespParser parser;
+        std::string data = "$3\r\nfoo\r\n:42\r\n";
+        auto partial = parser.parse(data.data(), 5);
+        auto first = parser.parse(data.data(), data.size());
+        auto second = first ? parser.parse(data.data() + first->first, data.size() - first->first)
+                            : first;
+        if (!partial && partial.error() == ParseError::Incomplete &&
+            first && first->second.asString() == "foo" &&
+            second && second->second.asInteger() == 42) {
+            std::cout << "✓ Consecutive frames parsed correctly" << std::endl;
+        } else {
+            std::cout << "✗ Consecutive frames test failed" << std::endl;
+        }
+    }
+
+    // reset() 丢弃未完成的帧
+    {
+        RespParser parser;
+        std::string partial = "*2\r\n:1\r\n";
+        parser.parse(partial.data(), partial.size());
+        parser.reset();
+        const char* data = "+PONG\r\n";
+        auto result = parser.parse(data, strlen(data));
+        if (result && result->second.isSimpleString() && result->second.asString() == "PONG") {
+            std::cout << "✓ Reset discards partial frame" << std::endl;
+        } else {
+            std::cout << "✗ Reset test failed" << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+}
+
+// 测试CRLF扫描内核：各SIMD内核与标量实现结果一致
+void testScannerKernels() {
+    std::cout << "=== Testing CRLF Scanner Kernels ===" << std::endl;
+    std::cout << "Active kernel: " << RespScanner::kernelName(RespScanner::activeKernel()) << std::endl;
+
+    // \r\n 落在每个位置（包括跨16/32字节分组边界）、孤立的\r或\n、不同起始偏移
+    bool ok = true;
+    for (size_t size = 0; size <= 80 && ok; ++size) {
+        for (size_t pos = 0; pos <= size && ok; ++pos) {
+            std::string data(size, 'a');
+            for (size_t i = 0; i < size; i += 7) data[i] = '\r';
+            for (size_t i = 3; i < size; i += 11) data[i] = '\n';
+            if (pos + 1 < size) {
+                data[pos] = '\r';
+                data[pos + 1] = '\n';
+            }
+            for (size_t offset = 0; offset <= std::min<size_t>(size, 3) && ok; ++offset) {
+                size_t expected = RespScanner::findCRLF(RespScanner::Kernel::Scalar, data.data(), size, offset);
+                for (auto kernel : {RespScanner::Kernel::SSE2, RespScanner::Kernel::AVX2}) {
+                    if (RespScanner::findCRLF(kernel, data.data(), size, offset) != expected) {
+                        ok = false;
+                    }
+                }
+                if (RespScanner::findCRLF(data.data(), size, offset) != expected) {
+                    ok = false;
+                }
+            }
+        }
+    }
+    std::cout << (ok ? "✓ All kernels agree with scalar scan"
+                     : "✗ Kernel mismatch with scalar scan") << std::endl;
+
+    std::cout << std::endl;
+}
+
+// 测试借用式回复解析：字符串直接指向输入数据
+void testReplyView() {
+    std::cout << "=== Testing Reply View ===" << std::endl;
+
+    // 嵌套回复逐字节喂入，完成后字符串指向原始缓冲区
+    {
+        RespViewParser parser;
+        std::vector<RespViewNode> nodes;
+        std::string data = "*4\r\n$5\r\nhello\r\n*2\r\n:42\r\n$-1\r\n%1\r\n+k\r\n$1\r\nv\r\n#t\r\n";
+        bool ok = true;
+        for (size_t len = 1; len < data.size(); ++len) {
+            auto result = parser.parse(data.data(), len, nodes);
+            if (result || result.error() != ParseError::Incomplete) {
+                ok = false;
+                break;
+            }
+        }
+        auto result = parser.parse(data.data(), data.size(), nodes);
+        if (ok && result && *result == data.size()) {
+            RedisReplyView view(data.data(), nodes.data());
+            ok = view.isArray() && view.size() == 4 &&
+                 view[0].asString() == "hello" && view[0].asString().data() == data.data() + 8 &&
+                 view[1].size() == 2 && view[1][0].asInteger() == 42 && view[1][1].isNull() &&
+                 view[2].isMap() && view[2].size() == 1 &&
+                 view[2].key(0).asString() == "k" && view[2].value(0).asString() == "v" &&
+                 view[3].asBoolean();
+        } else {
+            ok = false;
+        }
+        std::cout << (ok ? "✓ Byte-by-byte nested view parsed without copies"
+                         : "✗ Byte-by-byte nested view test failed") << std::endl;
+    }
+
+    // 解析中途把数据搬到另一块内存后继续（模拟环形缓冲区回绕时的拼接）
+    {
+        RespViewParser parser;
+        std::vector<RespViewNode> nodes;
+        std::string first = "*2\r\n$3\r\nfoo\r\n$3\r\nb";
+        std::string full = first + "ar\r\n";
+        auto partial = parser.parse(first.data(), first.size(), nodes);
+        std::string moved = full;
+        auto result = parser.parse(moved.data(), moved.size(), nodes);
+        bool ok = !partial && partial.error() == ParseError::Incomplete && result && *result == full.size();
+        if (ok) {
+            RedisReplyView view(moved.data(), nodes.data());
+            ok = view[0].asString() == "foo" && view[1].asString() == "bar";
+        }
+        std::cout << (ok ? "✓ View parse resumes after data relocation"
+                         : "✗ View parse relocation test failed") << std::endl;
+    }
+
+    // 物化结果与 RespParser 一致
+    {
+        std::string data = "*3\r\n+OK\r\n,1.5\r\n~2\r\n:1\r\n:2\r\n";
+        RespViewParser view_parser;
+        std::vector<RespViewNode> nodes;
+        RespParser parser;
+        auto view_result = view_parser.parse(data.data(), data.size(), nodes);
+        auto tree_result = parser.parse(data.data(), data.size());
+        bool ok = view_result && tree_result;
+        if (ok) {
+            RedisReply reply = RedisReplyView(data.data(), nodes.data()).toReply();
+            auto& arr = reply.asArray();
+            auto& expected = tree_result->second.asArray();
+            ok = arr.size() == expected.size() && arr[0].asString() == expected[0].asString() &&
+                 arr[1].asDouble() == expected[1].asDouble() && arr[2].isSet() &&
+                 arr[2].asArray()[1].asInteger() == 2;
+        }
+        std::cout << (ok ? "✓ View materializes to the same reply as RespParser"
+                         : "✗ View materialization mismatch") << std::endl;
+    }
+
+    // 元素个数超出 uint32_t 的节点下标范围时拒绝，不截断
+    {
+        RespViewParser parser;
+        std::vector<RespViewNode> nodes;
+        std::string array = "*4294967297\r\n:1\r\n";
+        auto array_result = parser.parse(array.data(), array.size(), nodes);
+        std::string map = "%2147483649\r\n:1\r\n:2\r\n";
+        auto map_result = parser.parse(map.data(), map.size(), nodes);
+        bool ok = !array_result && array_result.error() == ParseError::InvalidLength &&
+                  !map_result && map_result.error() == ParseError::InvalidLength;
+        std::cout << (ok ? "✓ View rejects element counts beyond uint32_t"
+                         : "✗ View count overflow test failed") << std::endl;
+    }
+
+    // 声明的元素个数远超已到达的数据：不按声明个数预留节点，等数据到齐后照常完成
+    {
+        RespViewParser parser;
+        std::vector<RespViewNode> nodes;
+        std::string head = "*100000000\r\n:1\r\n";
+        auto result = parser.parse(head.data(), head.size(), nodes);
+        bool ok = !result && result.error() == ParseError::Incomplete && nodes.capacity() < 1024;
+
+        std::string data = "*3\r\n+\r\n:2\r\n+\r\n";
+        auto partial = parser.parse(data.data(), 6, nodes);
+        auto full = parser.parse(data.data(), data.size(), nodes);
+        ok = ok && !partial && partial.error() == ParseError::Incomplete && full && *full == data.size() &&
+             RedisReplyView(data.data(), nodes.data()).size() == 3;
+        std::cout << (ok ? "✓ View reserves nodes only for data that has arrived"
+                         : "✗ View reservation bound test failed") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+// 测试arena模式的RedisValue：整帧位于arena中，与输入缓冲区无关
+void testArenaValue() {
+    std::cout << "=== Testing Arena-backed RedisValue ===" << std::endl;
+
+    std::string data = "*3\r\n$6\r\nmember\r\n$3\r\n1.5\r\n%1\r\n+k\r\n:7\r\n";
+    RespViewParser parser;
+    std::vector<RespViewNode> nodes;
+    auto result = parser.parse(data.data(), data.size(), nodes);
+    bool ok = result.has_value();
+    if (ok) {
+        auto arena = std::make_shared<const RespArenaReply>(data.data(), *result, nodes);
+        data.assign(data.size(), 'x');   // 原缓冲区被覆盖后仍可访问
+
+        galay::redis::RedisValue value(arena);
+        auto arr = value.toArray();
+        auto map = arr.size() == 3 ? arr[2].toMap() : std::map<std::string, galay::redis::RedisValue>{};
+        ok = value.isArray() && arr.size() == 3 &&
+             arr[0].toString() == "member" && arr[1].toString() == "1.5" &&
+             map.size() == 1 && map.count("k") && map.at("k").toInteger() == 7 &&
+             arena->arena().blockCount() == 1 &&
+             value.getReply().asArray().size() == 3;
+    }
+    std::cout << (ok ? "✓ Arena-backed value survives buffer reuse, single block"
+                     : "✗ Arena-backed value test failed") << std::endl;
+
+    // 通过可修改的 getReply() 改写后，is/to 接口读到的是新值而不是 arena 中的旧值
+    {
+        std::string frame = "*2\r\n:1\r\n:2\r\n";
+        RespViewParser frame_parser;
+        auto parsed = frame_parser.parse(frame.data(), frame.size(), nodes);
+        bool mutated = false;
+        if (parsed) {
+            galay::redis::RedisValue value(std::make_shared<const RespArenaReply>(frame.data(), *parsed, nodes));
+            value.getReply() = RedisReply(RespType::Integer, int64_t{42});
+            mutated = !value.isArenaBacked() && value.isInteger() && value.toInteger() == 42;
+        }
+        std::cout << (mutated ? "✓ Mutation through getReply() is visible on an arena-backed value"
+                              : "✗ getReply() mutation ignored in arena mode") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+// 测试tape表示：先序记录、子树跳过、惰性访问
+void testTape() {
+    std::cout << "=== Testing Tape Representation ===" << std::endl;
+
+    std::string data = "*3\r\n*2\r\n$3\r\n1-0\r\n*2\r\n$1\r\nf\r\n$1\r\nv\r\n"
+                       "%1\r\n+k\r\n:-7\r\n,2.5\r\n";
+
+    // 逐字节喂入，记录与跳转正确
+    {
+        RespTapeParser parser;
+        std::vector<RespTapeEntry> tape;
+        bool ok = true;
+        for (size_t len = 1; len < data.size(); ++len) {
+            auto result = parser.parse(data.data(), len, tape);
+            if (result || result.error() != ParseError::Incomplete) {
+                ok = false;
+                break;
+            }
+        }
+        auto result = parser.parse(data.data(), data.size(), tape);
+        if (ok && result && *result == data.size()) {
+            RespTapeView root(data.data(), tape.data());
+            auto entry = root.firstChild();
+            auto map = entry.nextSibling();
+            auto dbl = map.nextSibling();
+            ok = tape.size() == 10 && root.size() == 3 && tape[0].skip == 10 &&
+                 entry.index() == 1 && map.index() == 6 && dbl.index() == 9 &&
+                 entry[0].asString() == "1-0" && entry[1].size() == 2 &&
+                 entry[1].value(0).asString() == "v" &&
+                 map.isMap() && map.key(0).asString() == "k" && map.value(0).asInteger() == -7 &&
+                 dbl.asDouble() == 2.5 && root[2].index() == 9;
+        } else {
+            ok = false;
+        }
+        std::cout << (ok ? "✓ Tape records and sibling skips are correct"
+                         : "✗ Tape structure test failed") << std::endl;
+    }
+
+    // tape模式的RedisValue：惰性访问，物化结果与 RespParser 一致
+    {
+        RespTapeParser tape_parser;
+        std::vector<RespTapeEntry> tape;
+        RespParser parser;
+        auto tape_result = tape_parser.parse(data.data(), data.size(), tape);
+        auto tree_result = parser.parse(data.data(), data.size());
+        bool ok = tape_result && tree_result;
+        if (ok) {
+            galay::redis::RedisValue value(std::make_shared<const RespTapeReply>(data.data(), *tape_result, tape));
+            auto arr = value.toArray();
+            auto map = arr.size() == 3 ? arr[1].toMap() : std::map<std::string, galay::redis::RedisValue>{};
+            const RedisReply& reply = std::as_const(value).getReply();
+            ok = value.isTapeBacked() && arr.size() == 3 &&
+                 arr[0].toArray()[0].toString() == "1-0" &&
+                 map.count("k") && map.at("k").toInteger() == -7 && arr[2].toDouble() == 2.5 &&
+                 reply.asArray().size() == tree_result->second.asArray().size() &&
+                 reply.asArray()[0].asArray()[1].asArray()[1].asString() == "v";
+        }
+        std::cout << (ok ? "✓ Tape-backed value matches tree decode"
+                         : "✗ Tape-backed value test failed") << std::endl;
+    }
+
+    // 元素个数超出 uint32_t 的记录范围时拒绝，不截断（截断后 2^32 + 1 会被当成 1 个元素的数组）
+    {
+        RespTapeParser parser;
+        std::vector<RespTapeEntry> tape;
+        std::string array = "*4294967297\r\n:1\r\n";
+        auto array_result = parser.parse(array.data(), array.size(), tape);
+        std::string map = "%2147483649\r\n:1\r\n:2\r\n";
+        auto map_result = parser.parse(map.data(), map.size(), tape);
+        bool ok = !array_result && array_result.error() == ParseError::InvalidLength &&
+                  !map_result && map_result.error() == ParseError::InvalidLength;
+        std::cout << (ok ? "✓ Tape rejects element counts beyond uint32_t"
+                         : "✗ Tape count overflow test failed") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+// 记录回调序列的访问者
+struct RecordingVisitor : RespVisitor {
+    std::string events;
+    void onSimpleString(std::string_view v) override { events += "+" + std::string(v) + " "; }
+    void onError(std::string_view v) override { events += "-" + std::string(v) + " "; }
+    void onInteger(int64_t v) override { events += ":" + std::to_string(v) + " "; }
+    void onBulk(std::string_view v) override { events += "$" + std::string(v) + " "; }
+    void onNull() override { events += "nil "; }
+    void onDouble(double v) override { events += "," + std::to_string(v) + " "; }
+    void onBoolean(bool v) override { events += v ? "#t " : "#f "; }
+    void onArrayBegin(size_t n) override { events += "[" + std::to_string(n) + " "; }
+    void onArrayEnd() override { events += "] "; }
+    void onSetBegin(size_t n) override { events += "~" + std::to_string(n) + " "; }
+    void onSetEnd() override { events += "~ "; }
+    void onMapBegin(size_t n) override { events += "{" + std::to_string(n) + " "; }
+    void onMapEnd() override { events += "} "; }
+};
+
+// 测试访问者解析
+void testVisitor() {
+    std::cout << "=== Testing RespVisitor ===" << std::endl;
+
+    std::string data = "*4\r\n$5\r\nhello\r\n%1\r\n+k\r\n*0\r\n$-1\r\n~2\r\n:42\r\n#t\r\n"
+                       "-ERR oops\r\n";
+    std::string expected = "[4 $hello {1 +k [0 ] } nil ~2 :42 #t ~ ] ";
+
+    // 一次性解析
+    {
+        RespVisitParser parser;
+        RecordingVisitor visitor;
+        auto result = parser.parse(data.data(), data.size(), visitor);
+        bool ok = result && result->done && result->consumed == data.size() - 11 &&
+                  visitor.events == expected && !parser.inProgress();
+        std::cout << (ok ? "✓ Visitor events in preorder" : "✗ Visitor events test failed") << std::endl;
+    }
+
+    // 逐字节到达、回调过的字节立即丢弃：回调不重复，缓冲区中只保留未完成的元素
+    {
+        RespVisitParser parser;
+        RecordingVisitor visitor;
+        std::string buffer;
+        size_t total = 0, max_pending = 0;
+        bool ok = false;
+        for (char c : data) {
+            buffer.push_back(c);
+            max_pending = std::max(max_pending, buffer.size());
+            auto result = parser.parse(buffer.data(), buffer.size(), visitor);
+            if (!result) {
+                break;
+            }
+            buffer.erase(0, result->consumed);
+            total += result->consumed;
+            if (result->done) {
+                ok = true;
+                break;
+            }
+        }
+        ok = ok && visitor.events == expected && total == data.size() - 11 && max_pending <= 10;
+        std::cout << (ok ? "✓ Visitor resumes across partial reads without re-emitting"
+                         : "✗ Visitor incremental test failed") << std::endl;
+    }
+
+    // 错误回复与格式错误
+    {
+        RespVisitParser parser;
+        RecordingVisitor visitor;
+        std::string error = "-ERR oops\r\n";
+        auto result = parser.parse(error.data(), error.size(), visitor);
+        std::string bad = "*1\r\n?x\r\n";
+        RecordingVisitor bad_visitor;
+        auto bad_result = parser.parse(bad.data(), bad.size(), bad_visitor);
+        bool ok = result && result->done && visitor.events == "-ERR oops " &&
+                  !bad_result && bad_result.error() == ParseError::InvalidType && !parser.inProgress();
+        std::cout << (ok ? "✓ Visitor error reply and invalid data handled"
+                         : "✗ Visitor error test failed") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+// 测试流式 bulk 解析
+void testBulkStream() {
+    std::cout << "=== Testing RespBulkStreamParser ===" << std::endl;
+
+    // 逐字节到达：内容分片交给 sink，缓冲区中最多只保留未完成的首行
+    {
+        std::string value(1000, 'x');
+        for (size_t i = 0; i < value.size(); ++i) value[i] = static_cast<char>('a' + i % 26);
+        std::string data = "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n+NEXT\r\n";
+        RespBulkStreamParser parser;
+        std::string received;
+        size_t chunks = 0;
+        auto sink = [&](std::string_view chunk) { received.append(chunk); ++chunks; return true; };
+        std::string buffer;
+        size_t total = 0, max_pending = 0;
+        bool done = false;
+        for (size_t i = 0; i < data.size() && !done; ++i) {
+            buffer.push_back(data[i]);
+            max_pending = std::max(max_pending, buffer.size());
+            auto result = parser.parse(buffer.data(), buffer.size(), sink);
+            if (!result) break;
+            buffer.erase(0, result->consumed);
+            total += result->consumed;
+            done = result->done;
+        }
+        bool ok = done && received == value && chunks == value.size() && max_pending <= 7 &&
+                  total == data.size() - 7 && !parser.isNull() && parser.length() == value.size();
+        std::cout << (ok ? "✓ Bulk streamed to sink across partial reads"
+                         : "✗ Bulk stream incremental test failed") << std::endl;
+    }
+
+    // Null、错误回复、sink 中途停止、非 bulk 类型
+    {
+        auto sink = [](std::string_view) { return true; };
+        RespBulkStreamParser parser;
+        std::string null_reply = "$-1\r\n";
+        auto null_result = parser.parse(null_reply.data(), null_reply.size(), sink);
+        bool ok = null_result && null_result->done && parser.isNull();
+
+        std::string error = "-WRONGTYPE Operation against a key\r\n";
+        auto error_result = parser.parse(error.data(), error.size(), sink);
+        ok = ok && error_result && error_result->done && parser.isError() &&
+             parser.errorMessage() == "WRONGTYPE Operation against a key" && !parser.isNull();
+
+        // 首行被截断时不消费任何字节，与后续数据合并后再解析
+        std::string bulk = "$6\r\nabcdef\r\n";
+        auto partial = parser.parse(bulk.data(), 3, sink);
+        ok = ok && partial && partial->consumed == 0 && !partial->done;
+
+        // sink 返回 false 后不再回调，但整帧仍被消费
+        size_t calls = 0;
+        RespBulkStreamParser stop_parser;
+        auto stop_result = stop_parser.parse(bulk.data(), bulk.size(),
+                                             [&](std::string_view) { ++calls; return false; });
+        ok = ok && stop_result && stop_result->done && stop_result->consumed == bulk.size() &&
+             stop_parser.sinkStopped() && stop_parser.length() == 6 && calls == 1;
+
+        parser.reset();
+        std::string simple = "+OK\r\n";
+        auto simple_result = parser.parse(simple.data(), simple.size(), sink);
+        ok = ok && !simple_result && simple_result.error() == ParseError::InvalidType;
+        std::cout << (ok ? "✓ Bulk stream handles null, error, stopped sink and wrong type"
+                         : "✗ Bulk stream edge case test failed") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+struct StreamEntry {
+    std::string id;
+    std::map<std::string, std::string> fields;
+    static constexpr auto resp_fields = std::make_tuple(&StreamEntry::id, &StreamEntry::fields);
+};
+
+// 在节点数组上解码一帧
+template<typename T>
+std::expected<T, DecodeError> decodeFrame(const std::string& data) {
+    RespViewParser parser;
+    std::vector<RespViewNode> nodes;
+    auto result = parser.parse(data.data(), data.size(), nodes);
+    if (!result) {
+        return std::unexpected(DecodeError::TypeMismatch);
+    }
+    return decode<T>(RedisReplyView(data.data(), nodes.data()));
+}
+
+// 测试类型化解码
+void testTypedDecode() {
+    std::cout << "=== Testing Typed Decode ===" << std::endl;
+
+    {
+        auto i = decodeFrame<int64_t>(":42\r\n");
+        auto counter = decodeFrame<int>("$3\r\n-17\r\n");
+        auto score = decodeFrame<double>("$4\r\n1.25\r\n");
+        auto flag = decodeFrame<bool>(":1\r\n");
+        auto missing = decodeFrame<std::optional<std::string>>("$-1\r\n");
+        auto present = decodeFrame<std::optional<std::string>>("$3\r\nabc\r\n");
+        bool ok = i && *i == 42 && counter && *counter == -17 && score && *score == 1.25 &&
+                  flag && *flag && missing && !missing->has_value() && present && **present == "abc";
+        std::cout << (ok ? "✓ Scalars and optional decoded" : "✗ Scalar decode failed") << std::endl;
+    }
+
+    {
+        auto list = decodeFrame<std::vector<std::string>>("*3\r\n$1\r\na\r\n$1\r\nb\r\n+c\r\n");
+        // RESP2 HGETALL（扁平数组）与 RESP3 Map 得到相同结果
+        auto flat = decodeFrame<std::unordered_map<std::string, int64_t>>("*4\r\n$1\r\nx\r\n:1\r\n$1\r\ny\r\n$1\r\n2\r\n");
+        auto map = decodeFrame<std::unordered_map<std::string, int64_t>>("%2\r\n+x\r\n:1\r\n+y\r\n:2\r\n");
+        // ZRANGE WITHSCORES：RESP2扁平数组与RESP3嵌套数组
+        auto scores2 = decodeFrame<std::vector<std::pair<std::string, double>>>("*4\r\n$1\r\na\r\n$3\r\n1.5\r\n$1\r\nb\r\n$1\r\n2\r\n");
+        auto scores3 = decodeFrame<std::vector<std::pair<std::string, double>>>("*2\r\n*2\r\n$1\r\na\r\n,1.5\r\n*2\r\n$1\r\nb\r\n,2\r\n");
+        auto tuple = decodeFrame<std::tuple<std::string, int64_t, std::optional<double>>>("*3\r\n+k\r\n:7\r\n$-1\r\n");
+        bool ok = list && *list == std::vector<std::string>{"a", "b", "c"} &&
+                  flat && map && *flat == *map && map->at("y") == 2 &&
+                  scores2 && scores3 && *scores2 == *scores3 && (*scores2)[0].second == 1.5 &&
+                  tuple && std::get<0>(*tuple) == "k" && std::get<1>(*tuple) == 7 && !std::get<2>(*tuple);
+        std::cout << (ok ? "✓ Containers, pairs and tuples decoded" : "✗ Container decode failed") << std::endl;
+    }
+
+    {
+        auto entries = decodeFrame<std::vector<StreamEntry>>(
+            "*1\r\n*2\r\n$3\r\n1-0\r\n*4\r\n$1\r\na\r\n$1\r\n1\r\n$1\r\nb\r\n$1\r\n2\r\n");
+        auto wrong_type = decodeFrame<int64_t>("*0\r\n");
+        auto wrong_size = decodeFrame<std::pair<std::string, std::string>>("*1\r\n+a\r\n");
+        auto bad_number = decodeFrame<int64_t>("$2\r\nab\r\n");
+        auto null_value = decodeFrame<std::string>("$-1\r\n");
+        bool ok = entries && entries->size() == 1 && (*entries)[0].id == "1-0" &&
+                  (*entries)[0].fields.at("b") == "2" &&
+                  !wrong_type && wrong_type.error() == DecodeError::TypeMismatch &&
+                  !wrong_size && wrong_size.error() == DecodeError::SizeMismatch &&
+                  !bad_number && bad_number.error() == DecodeError::InvalidNumber &&
+                  !null_value && null_value.error() == DecodeError::UnexpectedNull;
+        std::cout << (ok ? "✓ Struct fields decoded, mismatches reported"
+                         : "✗ Struct/mismatch decode failed") << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
 // 测试协议编码器
 void testEncoder() {
     std::cout << "=== Testing RESP Encoder ===" << std::endl;
@@ -166,6 +723,71 @@ void testEncoder() {
         std::cout << "Command: " << result;
     }
 
+    // 追加式编码：与旧接口结果一致，复用缓冲区容量，精确预留
+    {
+        std::string buffer;
+        std::vector<std::string> args = {"mykey", "myvalue"};
+        RespEncoder::appendCommand(buffer, "SET", args);
+        bool ok = buffer == encoder.encodeCommand("SET", {"mykey", "myvalue"});
+        const char* data = buffer.data();
+        size_t capacity = buffer.capacity();
+        buffer.clear();
+        RespEncoder::appendCommand(buffer, "GET", std::vector<std::string_view>{"mykey"});
+        ok = ok && buffer == "*2\r\n$3\r\nGET\r\n$5\r\nmykey\r\n" &&
+             buffer.data() == data && buffer.capacity() == capacity;
+
+        // 混合数值参数；double 使用最短往返表示
+        buffer.clear();
+        RespEncoder::appendCommandArgs(buffer, "ZADD", "z", 0.1, std::string("m"), -12);
+        ok = ok && buffer == "*5\r\n$4\r\nZADD\r\n$1\r\nz\r\n$3\r\n0.1\r\n$1\r\nm\r\n$3\r\n-12\r\n";
+        double precise = 1234567.891011;
+        // 只有长度头的 bulk（内容由 writev/sendfile 另行发送）
+        std::string header;
+        RespEncoder::appendBulkHeader(header, 7);
+        ok = ok && header + "myvalue\r\n" == encoder.encodeBulkString("myvalue");
+        ok = ok && std::stod(RespEncoder::formatDouble(precise)) == precise &&
+             RespEncoder::bulkStringSize(10) == 17 && RespEncoder::bulkStringSize(9) == 15;
+        std::cout << (ok ? "✓ Append encoder matches, reuses buffer, keeps double precision"
+                         : "✗ Append encoder test failed") << std::endl;
+    }
+
+    // 编译期预编码的命令前缀
+    {
+        static_assert(Command<"SET", 2>::prefix() == "*3\r\n$3\r\nSET\r\n");
+        static_assert(Command<"HGETALL", 1>::prefix() == "*2\r\n$7\r\nHGETALL\r\n");
+        std::string buffer;
+        Command<"SET", 2>::append(buffer, std::string("mykey"), "myvalue");
+        bool ok = buffer == encoder.encodeCommand("SET", {"mykey", "myvalue"}) &&
+                  Command<"LRANGE", 3>::encode("l", 0, -1) == encoder.encodeCommand("LRANGE", {"l", "0", "-1"}) &&
+                  Command<"PING", 0>::encode() == "*1\r\n$4\r\nPING\r\n";
+        std::cout << (ok ? "✓ Pre-encoded command headers match runtime encoding"
+                         : "✗ Pre-encoded command test failed") << std::endl;
+    }
+
+    // 分散写：大参数原地引用，拼接结果与连续编码一致，任意已发送偏移都能续写
+    {
+        std::string large(64, 'v');
+        RespVectoredCommand command(32);
+        command.append("SET", {"mykey", large});
+        command.append("GET", {"mykey"});
+        std::string expected = encoder.encodeCommand("SET", {"mykey", large}) +
+                               encoder.encodeCommand("GET", {"mykey"});
+        bool ok = command.size() == expected.size() && command.borrowedCount() == 1;
+        bool referenced = false;
+        for (const auto& iov : command.iovecs(0)) {
+            referenced = referenced || iov.iov_base == large.data();
+        }
+        for (size_t offset = 0; ok && offset <= expected.size(); ++offset) {
+            std::string joined;
+            for (const auto& iov : command.iovecs(offset)) {
+                joined.append(static_cast<const char*>(iov.iov_base), iov.iov_len);
+            }
+            ok = joined == expected.substr(offset);
+        }
+        std::cout << (ok && referenced ? "✓ Vectored command references large arguments in place"
+                                       : "✗ Vectored command test failed") << std::endl;
+    }
+
     std::cout << std::endl;
 }
 
@@ -226,6 +848,30 @@ int main(int argc, char* argv[]) {
         // 测试协议解析器
         testParser();
 
+        // 测试增量解析
+        testIncrementalParse();
+
+        // 测试CRLF扫描内核
+        testScannerKernels();
+
+        // 测试借用式回复
+        testReplyView();
+
+        // 测试arena模式的RedisValue
+        testArenaValue();
+
+        // 测试tape表示
+        testTape();
+
+        // 测试访问者解析
+        testVisitor();
+
+        // 测试流式 bulk 解析
+        testBulkStream();
+
+        // 测试类型化解码
+        testTypedDecode();
+
         // 测试协议编码器
         testEncoder();
 
@@ -0,0 +1,224 @@
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include "base/RedisBuffer.h"
+#include "protocol/RedisProtocol.h"
+#include "protocol/RedisReplyView.h"
+
+using namespace galay::redis;
+using namespace galay::redis::protocol;
+
+/**
+ * @brief 模拟一次 readv：把 source[offset...] 最多 chunk 字节写入缓冲区
+ */
+size_t receive(RedisBuffer& buffer, const std::string& source, size_t& offset, size_t chunk)
+{
+    auto iovecs = buffer.getWriteIovecs();
+    size_t n = std::min({chunk, iovecs[0].iov_len, source.size() - offset});
+    std::memcpy(iovecs[0].iov_base, source.data() + offset, n);
+    buffer.produce(n);
+    offset += n;
+    return n;
+}
+
+std::string bulk(const std::string& value)
+{
+    return "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n";
+}
+
+/**
+ * @brief 收发 rounds 个小回复，每个回复处理完后缓冲区清空一次
+ */
+void drainSmall(RedisBuffer& buffer, size_t rounds)
+{
+    const std::string reply = "+OK\r\n";
+    for (size_t i = 0; i < rounds; ++i) {
+        size_t offset = 0;
+        receive(buffer, reply, offset, reply.size());
+        buffer.consume(buffer.readable());
+    }
+}
+
+/**
+ * @brief 完整收下一个回复并消费
+ */
+bool receiveReply(RedisBuffer& buffer, const std::string& reply)
+{
+    RespParser parser;
+    size_t offset = 0;
+    while (offset < reply.size() || !buffer.empty()) {
+        if (receive(buffer, reply, offset, 64 * 1024) == 0 && offset < reply.size()) {
+            return false;
+        }
+        auto parsed = parser.parse(buffer.data(), buffer.readable());
+        if (parsed) {
+            buffer.consume(parsed->first);
+            return buffer.empty();
+        }
+        if (parsed.error() != ParseError::Incomplete) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// 小回复：缓冲区不扩容，跨越尾部的帧通过搬移保持连续
+void testSmallReplies()
+{
+    std::cout << "=== Testing small replies ===" << std::endl;
+
+    RedisBuffer buffer(256);
+    RespParser parser;
+    std::string stream;
+    for (int i = 0; i < 1000; ++i) {
+        stream += bulk("value:" + std::to_string(i));
+    }
+
+    size_t offset = 0;
+    int parsed = 0;
+    bool ok = true;
+    while (parsed < 1000) {
+        receive(buffer, stream, offset, 97);
+        while (!buffer.empty()) {
+            auto result = parser.parse(buffer.data(), buffer.readable());
+            if (!result) {
+                ok = ok && result.error() == ParseError::Incomplete;
+                break;
+            }
+            ok = ok && result->second.asString() == "value:" + std::to_string(parsed);
+            buffer.consume(result->first);
+            ++parsed;
+        }
+    }
+
+    const auto& stats = buffer.stats();
+    ok = ok && stats.grow_count == 0 && stats.peak_capacity == 256 && stats.compact_count > 0;
+    std::cout << (ok ? "✓ 1000 replies parsed without growing, compacted "
+                     : "✗ Small reply test failed, compacted ")
+              << stats.compact_count << " times (" << stats.compact_bytes << " bytes)" << std::endl;
+    std::cout << std::endl;
+}
+
+// 10MB 回复：缓冲区按2倍扩容直到整帧可见，之后连续多轮小回复才缩回初始容量
+void testLargeReply()
+{
+    std::cout << "=== Testing 10MB replies ===" << std::endl;
+
+    const size_t size = 10 * 1024 * 1024;
+    std::string value(size, 'x');
+    for (size_t i = 0; i < size; i += 4096) {
+        value[i] = static_cast<char>('a' + (i / 4096) % 26);
+    }
+
+    // 单个 10MB bulk string（GET 大值）
+    {
+        RedisBuffer buffer(8192);
+        RespParser parser;
+        std::string reply = "+OK\r\n" + bulk(value);
+        size_t offset = 0;
+        std::string result;
+        size_t replies = 0;
+        while (replies < 2) {
+            if (receive(buffer, reply, offset, 64 * 1024) == 0 && buffer.empty()) {
+                break;
+            }
+            while (!buffer.empty()) {
+                auto parsed = parser.parse(buffer.data(), buffer.readable());
+                if (!parsed) {
+                    break;
+                }
+                if (parsed->second.isBulkString()) {
+                    result = parsed->second.asString();
+                }
+                buffer.consume(parsed->first);
+                ++replies;
+            }
+        }
+        const auto& stats = buffer.stats();
+        bool ok = replies == 2 && result == value && stats.peak_capacity >= size &&
+                  stats.grow_count > 0 && stats.shrink_count == 0 && buffer.capacity() >= size;
+        std::cout << (ok ? "✓ 10MB bulk string: peak " : "✗ 10MB bulk string failed: peak ")
+                  << stats.peak_capacity / 1024 << " KB, " << stats.grow_count << " grows, "
+                  << "capacity kept after the reply" << std::endl;
+
+        // 小回复不足 kShrinkAfterRounds 轮时保留容量，满了才归还内存
+        drainSmall(buffer, RedisBuffer::kShrinkAfterRounds - 1);
+        bool kept = buffer.capacity() >= size && stats.shrink_count == 0;
+        drainSmall(buffer, 1);
+        ok = kept && stats.shrink_count == 1 && buffer.capacity() == 8192;
+        std::cout << (ok ? "✓ Shrunk back to " : "✗ Shrink hysteresis failed, capacity ")
+                  << buffer.capacity() << " bytes after " << RedisBuffer::kShrinkAfterRounds
+                  << " small replies" << std::endl;
+    }
+
+    // 10MB 数组（LRANGE/HGETALL 大结果），借用视图解析
+    {
+        RedisBuffer buffer(8192);
+        RespViewParser parser;
+        std::vector<RespViewNode> nodes;
+        const size_t count = size / 1024;
+        std::string element(1000, 'e');
+        std::string reply = "*" + std::to_string(count) + "\r\n";
+        for (size_t i = 0; i < count; ++i) {
+            reply += bulk(element);
+        }
+
+        size_t offset = 0;
+        bool ok = false;
+        while (true) {
+            if (receive(buffer, reply, offset, 64 * 1024) == 0) {
+                break;
+            }
+            auto consumed = parser.parse(buffer.data(), buffer.readable(), nodes);
+            if (consumed) {
+                RedisReplyView view(buffer.data(), nodes.data());
+                ok = view.isArray() && view.size() == count && view.at(count - 1).asString() == element;
+                buffer.consume(*consumed);
+                break;
+            }
+            if (consumed.error() != ParseError::Incomplete) {
+                break;
+            }
+        }
+        const auto& stats = buffer.stats();
+        ok = ok && offset == reply.size() && buffer.empty() && buffer.capacity() >= size &&
+             stats.shrink_count == 0;
+        std::cout << (ok ? "✓ 10MB array view: peak " : "✗ 10MB array view failed: peak ")
+                  << stats.peak_capacity / 1024 << " KB, " << stats.grow_count << " grows" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+// 大小回复交替：大回复之间夹着少量小回复时不缩容，只有第一个大回复触发扩容
+void testAlternatingReplies()
+{
+    std::cout << "=== Testing alternating large and small replies ===" << std::endl;
+
+    RedisBuffer buffer(8192);
+    std::string large = bulk(std::string(1024 * 1024, 'v'));
+    bool ok = receiveReply(buffer, large);
+    size_t grows = buffer.stats().grow_count;
+    for (int i = 0; ok && i < 20; ++i) {
+        drainSmall(buffer, RedisBuffer::kShrinkAfterRounds / 2);
+        ok = receiveReply(buffer, large);
+    }
+    const auto& stats = buffer.stats();
+    ok = ok && grows > 0 && stats.grow_count == grows && stats.shrink_count == 0;
+    std::cout << (ok ? "✓ 20 large replies reused the buffer: " : "✗ Buffer thrashed: ")
+              << stats.grow_count << " grows, " << stats.shrink_count << " shrinks" << std::endl;
+    std::cout << std::endl;
+}
+
+int main()
+{
+    std::cout << "RedisBuffer Test" << std::endl;
+    std::cout << "======================================" << std::endl << std::endl;
+
+    testSmallReplies();
+    testLargeReply();
+    testAlternatingReplies();
+
+    std::cout << "All tests completed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "galay-redis/async/RedisClient.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+/**
+ * @brief 命令超时之后：超时作用在内核 IO 上，返回时 IO 已被取消；
+ *        同一客户端上的下一条命令照常成功（迟到的回复被跳过），客户端可以立即析构
+ * @details 慢服务端每批回复延迟 reply_delay，命令的超时远小于它；静默服务端从不回复
+ */
+int g_failures = 0;
+
+static void check(bool ok, const std::string& what)
+{
+    std::cout << (ok ? "✓ " : "✗ ") << what << std::endl;
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+template <typename Pred>
+static bool waitFor(Pred pred, std::chrono::milliseconds limit = std::chrono::seconds(5))
+{
+    auto deadline = std::chrono::steady_clock::now() + limit;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+struct TimeoutOutcome
+{
+    std::atomic<int> state{0};
+    RedisErrorType timed_out = REDIS_ERROR_TYPE_SUCCESS;
+    std::string next_value;
+    bool pipeline_ok = false;
+    bool closed = true;
+};
+
+static RedisErrorType errorOf(const auto& result)
+{
+    return result ? REDIS_ERROR_TYPE_SUCCESS : result.error().type();
+}
+
+Coroutine timeoutThenNext(std::shared_ptr<RedisClient> client, int port, std::chrono::milliseconds timeout,
+                          TimeoutOutcome& out)
+{
+    auto connected = co_await client->connect("127.0.0.1", port);
+    if (!connected) {
+        std::cerr << "Failed to connect: " << connected.error().message() << std::endl;
+        out.state = -1;
+        co_return;
+    }
+
+    auto ping = co_await client->ping().timeout(timeout);
+    out.timed_out = errorOf(ping);
+
+    // 迟到的 PONG 先到，必须被跳过，GET 拿到的是自己的回复
+    auto get = co_await client->get("key");
+    if (get && get->has_value() && get->value()[0].isString()) {
+        out.next_value = get->value()[0].toString();
+    }
+
+    std::vector<std::vector<std::string>> commands = {{"PING"}, {"GET", "key"}};
+    auto pipeline = co_await client->pipeline(commands);
+    out.pipeline_ok = pipeline && pipeline->has_value() && pipeline->value().size() == 2 &&
+                      pipeline->value()[0].isStatus() && pipeline->value()[1].isString();
+
+    out.closed = client->isClosed();
+    co_await client->close();
+    out.state = 1;
+}
+
+Coroutine timeoutThenDestroy(IOScheduler* scheduler, int port, std::chrono::milliseconds timeout,
+                             std::atomic<int>& state)
+{
+    RedisClient client(scheduler);
+    auto connected = co_await client.connect("127.0.0.1", port);
+    if (!connected) {
+        state = -1;
+        co_return;
+    }
+    auto ping = co_await client.ping().timeout(timeout);
+    // 超时返回后内核已不再引用接收缓冲区，栈上的客户端随协程结束直接析构
+    state = errorOf(ping) == REDIS_ERROR_TYPE_TIMEOUT_ERROR ? 1 : -1;
+}
+
+Coroutine timeoutOnSilent(std::shared_ptr<RedisClient> client, int port, std::chrono::milliseconds timeout,
+                          std::atomic<int>& state)
+{
+    auto connected = co_await client->connect("127.0.0.1", port);
+    if (!connected) {
+        state = -1;
+        co_return;
+    }
+    auto ping = co_await client->ping().timeout(timeout);
+    state = errorOf(ping) == REDIS_ERROR_TYPE_TIMEOUT_ERROR ? 1 : -1;
+}
+
+Coroutine pingOnce(std::shared_ptr<RedisClient> client, int port, std::atomic<int>& state)
+{
+    auto connected = co_await client->connect("127.0.0.1", port);
+    if (!connected) {
+        state = -1;
+        co_return;
+    }
+    auto ping = co_await client->ping();
+    state = ping && ping->has_value() && ping->value()[0].isStatus() ? 1 : -1;
+    co_await client->close();
+}
+
+int main(int argc, char* argv[])
+{
+    std::chrono::milliseconds reply_delay{300};
+    std::chrono::milliseconds timeout{30};
+    if (argc > 1) reply_delay = std::chrono::milliseconds(std::atoi(argv[1]));
+    if (argc > 2) timeout = std::chrono::milliseconds(std::atoi(argv[2]));
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Redis Client Timeout Recovery Test (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Reply delay: " << reply_delay.count() << " ms, command timeout: " << timeout.count() << " ms"
+              << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    server.setReplyDelay(reply_delay);
+    galay::redis::test::RespTestServer silent;
+    silent.setSilent(true);
+    if (!server.start() || !silent.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        // 1. 超时之后同一客户端继续可用，迟到的回复不会错位
+        TimeoutOutcome out;
+        scheduler->spawn(timeoutThenNext(std::make_shared<RedisClient>(scheduler), server.port(), timeout, out));
+        waitFor([&] { return out.state.load() != 0; });
+        check(out.state == 1, "client connected and ran all commands");
+        check(out.timed_out == REDIS_ERROR_TYPE_TIMEOUT_ERROR, "PING with a short timeout timed out");
+        check(out.next_value == "value", "next GET on the same client got its own reply, not the late PONG");
+        check(out.pipeline_ok, "pipeline on the same client got both replies in order");
+        check(!out.closed, "client stayed open after the timeout");
+
+        // 2. 栈上的客户端在超时后立即析构
+        std::atomic<int> destroyed{0};
+        scheduler->spawn(timeoutThenDestroy(scheduler, server.port(), timeout, destroyed));
+        waitFor([&] { return destroyed.load() != 0; });
+        check(destroyed == 1, "stack-owned client timed out and was destroyed");
+        // 迟到的回复发往已关闭的连接，不能再触碰已析构的客户端
+        std::this_thread::sleep_for(reply_delay * 2);
+
+        // 3. 服务端从不回复：超时返回后客户端随最后一个引用释放，没有 IO 把它挂住
+        std::atomic<int> silent_state{0};
+        std::weak_ptr<RedisClient> watched;
+        {
+            auto client = std::make_shared<RedisClient>(scheduler);
+            watched = client;
+            scheduler->spawn(timeoutOnSilent(std::move(client), silent.port(), timeout, silent_state));
+        }
+        waitFor([&] { return silent_state.load() != 0; });
+        check(silent_state == 1, "PING against a silent server timed out");
+        check(waitFor([&] { return watched.expired(); }, std::chrono::seconds(1)),
+              "client against a silent server was freed after the timeout");
+
+        // 4. 新客户端不受影响
+        std::atomic<int> state{0};
+        scheduler->spawn(pingOnce(std::make_shared<RedisClient>(scheduler), server.port(), state));
+        waitFor([&] { return state.load() != 0; });
+        check(state == 1, "a fresh client answers PING");
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    silent.stop();
+    server.stop();
+    return g_failures == 0 ? 0 : 1;
+}
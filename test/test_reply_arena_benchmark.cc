@@ -0,0 +1,136 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RedisReplyView.h"
+#include "galay-redis/protocol/RespArena.h"
+#include "galay-redis/base/RedisValue.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace galay::redis;
+using namespace galay::redis::protocol;
+
+// 统计堆分配次数
+static std::atomic<size_t> g_alloc_count{0};
+
+void* operator new(size_t size)
+{
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+/**
+ * @brief ZRANGE key 0 -1 WITHSCORES 的 RESP2 回复：member 与 score 交替的扁平数组
+ */
+std::string buildZrangeWithScores(size_t members)
+{
+    std::string reply = "*" + std::to_string(members * 2) + "\r\n";
+    for (size_t i = 0; i < members; ++i) {
+        // 成员名超过SSO长度，贴近真实的 key / id
+        std::string id = std::to_string(i);
+        std::string member = "user:session:" + std::string(12 - id.size(), '0') + id;
+        std::string score = std::to_string(i) + ".5";
+        reply += "$" + std::to_string(member.size()) + "\r\n" + member + "\r\n";
+        reply += "$" + std::to_string(score.size()) + "\r\n" + score + "\r\n";
+    }
+    return reply;
+}
+
+struct Sample
+{
+    double parse_ms = 0;
+    double destroy_ms = 0;
+    size_t allocs = 0;
+};
+
+/**
+ * @brief 树形解码：RespParser -> RedisReply -> RedisValue
+ */
+Sample runTree(const std::string& reply)
+{
+    Sample sample;
+    RespParser parser;
+    size_t before = g_alloc_count.load();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto value = std::make_unique<RedisValue>(std::move(parser.parse(reply.data(), reply.size())->second));
+    auto t1 = std::chrono::high_resolution_clock::now();
+    sample.allocs = g_alloc_count.load() - before;
+    value.reset();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    sample.parse_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sample.destroy_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    return sample;
+}
+
+/**
+ * @brief arena解码：RespViewParser 写节点 -> 节点与帧拷入一个arena -> RedisValue
+ * @param nodes 客户端中复用的节点数组（已预热）
+ */
+Sample runArena(const std::string& reply, std::vector<RespViewNode>& nodes)
+{
+    Sample sample;
+    RespViewParser parser;
+    size_t before = g_alloc_count.load();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto consumed = parser.parse(reply.data(), reply.size(), nodes);
+    auto value = std::make_unique<RedisValue>(
+        std::make_shared<const RespArenaReply>(reply.data(), *consumed, nodes));
+    auto t1 = std::chrono::high_resolution_clock::now();
+    sample.allocs = g_alloc_count.load() - before;
+    value.reset();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    sample.parse_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sample.destroy_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    return sample;
+}
+
+void print(const char* name, const Sample& s)
+{
+    std::cout << std::left << std::setw(10) << name << std::setw(12) << s.allocs
+              << std::fixed << std::setprecision(3)
+              << std::setw(14) << s.parse_ms << std::setw(14) << s.destroy_ms
+              << s.parse_ms + s.destroy_ms << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t members = 100000;
+    size_t rounds = 5;
+    if (argc > 1) members = std::stoul(argv[1]);
+    if (argc > 2) rounds = std::stoul(argv[2]);
+
+    std::string reply = buildZrangeWithScores(members);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "ZRANGE WITHSCORES Decode: Tree vs Arena" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Members: " << members << ", reply size: " << reply.size() / 1024 << " KB"
+              << ", best of " << rounds << std::endl;
+    std::cout << std::left << std::setw(10) << "Mode" << std::setw(12) << "Allocs"
+              << std::setw(14) << "Parse(ms)" << std::setw(14) << "Destroy(ms)" << "Total(ms)" << std::endl;
+
+    Sample best_tree, best_arena;
+    best_tree.parse_ms = best_arena.parse_ms = 1e18;
+    std::vector<RespViewNode> nodes;
+    for (size_t i = 0; i < rounds; ++i) {
+        Sample tree = runTree(reply);
+        if (tree.parse_ms + tree.destroy_ms < best_tree.parse_ms + best_tree.destroy_ms) best_tree = tree;
+        Sample arena = runArena(reply, nodes);
+        if (arena.parse_ms + arena.destroy_ms < best_arena.parse_ms + best_arena.destroy_ms) best_arena = arena;
+    }
+
+    print("tree", best_tree);
+    print("arena", best_arena);
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
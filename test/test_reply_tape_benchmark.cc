@@ -0,0 +1,208 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RespTape.h"
+#include "galay-redis/base/RedisValue.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace galay::redis;
+using namespace galay::redis::protocol;
+
+// 统计堆分配次数和字节数
+static std::atomic<size_t> g_alloc_count{0};
+static std::atomic<size_t> g_alloc_bytes{0};
+
+void* operator new(size_t size)
+{
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+std::string bulk(const std::string& s)
+{
+    return "$" + std::to_string(s.size()) + "\r\n" + s + "\r\n";
+}
+
+/**
+ * @brief XRANGE 回复：每条为 [id, [field1, value1, ..., fieldN, valueN]]
+ */
+std::string buildXrange(size_t entries, size_t fields)
+{
+    std::string reply = "*" + std::to_string(entries) + "\r\n";
+    for (size_t i = 0; i < entries; ++i) {
+        reply += "*2\r\n" + bulk("1700000000000-" + std::to_string(i));
+        reply += "*" + std::to_string(fields * 2) + "\r\n";
+        for (size_t f = 0; f < fields; ++f) {
+            reply += bulk("field_name_" + std::to_string(f));
+            reply += bulk("value_payload_" + std::to_string(i * fields + f));
+        }
+    }
+    return reply;
+}
+
+/**
+ * @brief RESP3 HGETALL 回复：一个大Map
+ */
+std::string buildHgetall(size_t fields)
+{
+    std::string reply = "%" + std::to_string(fields) + "\r\n";
+    for (size_t f = 0; f < fields; ++f) {
+        reply += bulk("hash_field_name_" + std::to_string(f));
+        reply += bulk("hash_value_payload_" + std::to_string(f));
+    }
+    return reply;
+}
+
+struct Sample
+{
+    double decode_ms = 0;
+    double access_ms = 0;
+    double destroy_ms = 0;
+    size_t allocs = 0;
+    size_t bytes = 0;
+    size_t checksum = 0;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+/**
+ * @brief 树形解码；访问：只取每条记录的第一个元素（XRANGE的ID / HGETALL的key）
+ */
+Sample runTree(const std::string& reply)
+{
+    Sample s;
+    RespParser parser;
+    size_t count0 = g_alloc_count.load(), bytes0 = g_alloc_bytes.load();
+    auto t0 = Clock::now();
+    auto tree = std::make_unique<RedisReply>(std::move(parser.parse(reply.data(), reply.size())->second));
+    auto t1 = Clock::now();
+    s.allocs = g_alloc_count.load() - count0;
+    s.bytes = g_alloc_bytes.load() - bytes0;
+    if (tree->isArray()) {
+        for (const auto& entry : tree->asArray()) {
+            s.checksum += std::get<std::string>(entry.asArray()[0].getData()).size();
+        }
+    } else {
+        for (const auto& [key, value] : tree->asMap()) {
+            s.checksum += std::get<std::string>(key.getData()).size();
+        }
+    }
+    auto t2 = Clock::now();
+    tree.reset();
+    auto t3 = Clock::now();
+    s.decode_ms = ms(t0, t1);
+    s.access_ms = ms(t1, t2);
+    s.destroy_ms = ms(t2, t3);
+    return s;
+}
+
+/**
+ * @brief tape解码；访问时按 skip 跳过每条记录的字段子数组
+ */
+Sample runTape(const std::string& reply, std::vector<RespTapeEntry>& entries)
+{
+    Sample s;
+    RespTapeParser parser;
+    size_t count0 = g_alloc_count.load(), bytes0 = g_alloc_bytes.load();
+    auto t0 = Clock::now();
+    auto consumed = parser.parse(reply.data(), reply.size(), entries);
+    auto tape = std::make_shared<const RespTapeReply>(reply.data(), *consumed, entries);
+    auto t1 = Clock::now();
+    s.allocs = g_alloc_count.load() - count0;
+    s.bytes = g_alloc_bytes.load() - bytes0;
+    RespTapeView root = tape->view();
+    RespTapeView child = root.firstChild();
+    if (root.isArray()) {
+        for (size_t i = 0; i < root.size(); ++i, child = child.nextSibling()) {
+            s.checksum += child.firstChild().asString().size();
+        }
+    } else {
+        for (size_t i = 0; i < root.size(); ++i) {
+            s.checksum += child.asString().size();
+            child = child.nextSibling().nextSibling();
+        }
+    }
+    auto t2 = Clock::now();
+    tape.reset();
+    auto t3 = Clock::now();
+    s.decode_ms = ms(t0, t1);
+    s.access_ms = ms(t1, t2);
+    s.destroy_ms = ms(t2, t3);
+    return s;
+}
+
+void print(const char* name, const Sample& s)
+{
+    std::cout << "  " << std::left << std::setw(8) << name << std::setw(10) << s.allocs
+              << std::setw(12) << (std::to_string(s.bytes / 1024) + " KB")
+              << std::fixed << std::setprecision(3)
+              << std::setw(12) << s.decode_ms << std::setw(12) << s.access_ms
+              << std::setw(12) << s.destroy_ms << std::endl;
+}
+
+void runCase(const std::string& name, const std::string& reply, size_t rounds)
+{
+    std::cout << "--------------------------------------------------" << std::endl;
+    std::cout << name << " (" << reply.size() / 1024 << " KB)" << std::endl;
+    std::cout << "  " << std::left << std::setw(8) << "Mode" << std::setw(10) << "Allocs"
+              << std::setw(12) << "Heap" << std::setw(12) << "Decode(ms)"
+              << std::setw(12) << "Access(ms)" << std::setw(12) << "Destroy(ms)" << std::endl;
+
+    Sample best_tree, best_tape;
+    best_tree.decode_ms = best_tape.decode_ms = 1e18;
+    std::vector<RespTapeEntry> entries;
+    for (size_t i = 0; i < rounds; ++i) {
+        Sample tree = runTree(reply);
+        if (tree.decode_ms < best_tree.decode_ms) best_tree = tree;
+        Sample tape = runTape(reply, entries);
+        if (tape.decode_ms < best_tape.decode_ms) best_tape = tape;
+    }
+    print("tree", best_tree);
+    print("tape", best_tape);
+    if (best_tree.checksum != best_tape.checksum) {
+        std::cout << "  checksum mismatch!" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t scale = 20000;
+    size_t rounds = 5;
+    if (argc > 1) scale = std::stoul(argv[1]);
+    if (argc > 2) rounds = std::stoul(argv[2]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Large Reply Decode: Tree vs Tape" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Access: first element of each entry only (IDs / keys), best of " << rounds << std::endl;
+
+    runCase("XRANGE " + std::to_string(scale) + " entries x 10 fields", buildXrange(scale, 10), rounds);
+    runCase("HGETALL " + std::to_string(scale * 10) + " fields (RESP3)", buildHgetall(scale * 10), rounds);
+
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
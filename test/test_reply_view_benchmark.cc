@@ -0,0 +1,82 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RedisReplyView.h"
+#include "galay-redis/base/RedisValue.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace galay::redis;
+using namespace galay::redis::protocol;
+
+/**
+ * @brief GET 回复：一个 value_size 字节的 bulk string
+ */
+std::string buildGetReply(size_t value_size)
+{
+    return "$" + std::to_string(value_size) + "\r\n" + std::string(value_size, 'v') + "\r\n";
+}
+
+/**
+ * @brief 旧路径：RespParser 构造 RedisReply，再移入 RedisValue 交给调用方
+ * @return 每次回复的平均耗时（纳秒）
+ */
+double benchTree(const std::string& reply, size_t iterations, size_t& checksum)
+{
+    RespParser parser;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        auto result = parser.parse(reply.data(), reply.size());
+        RedisValue value(std::move(result->second));
+        checksum += value.toString().size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+/**
+ * @brief 借用路径：RespViewParser 只写节点，字符串指向输入缓冲区
+ * @return 每次回复的平均耗时（纳秒）
+ */
+double benchView(const std::string& reply, size_t iterations, size_t& checksum)
+{
+    RespViewParser parser;
+    std::vector<RespViewNode> nodes;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        auto result = parser.parse(reply.data(), reply.size(), nodes);
+        RedisReplyView view(reply.data(), nodes.data());
+        checksum += view.asString().size() + *result;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = 100000;
+    if (argc > 1) iterations = std::stoul(argv[1]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "GET Reply Decode: RedisValue vs RedisReplyView" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Iterations: " << iterations << std::endl;
+    std::cout << std::left << std::setw(10) << "Value" << std::setw(16) << "tree(ns/op)"
+              << std::setw(16) << "view(ns/op)" << "speedup" << std::endl;
+
+    size_t checksum = 0;
+    for (size_t kb : {4, 16, 64}) {
+        std::string reply = buildGetReply(kb * 1024);
+        double tree_ns = benchTree(reply, iterations, checksum);
+        double view_ns = benchView(reply, iterations, checksum);
+        std::cout << std::left << std::setw(10) << (std::to_string(kb) + "KB")
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(16) << tree_ns << std::setw(16) << view_ns
+                  << std::setprecision(1) << tree_ns / view_ns << "x" << std::endl;
+    }
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RespVisitor.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <new>
+
+using namespace galay::redis::protocol;
+
+// 统计堆分配次数
+static std::atomic<size_t> g_alloc_count{0};
+
+void* operator new(size_t size)
+{
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+/**
+ * @brief ZRANGE key 0 -1 WITHSCORES 的 RESP2 回复：member 与 score 交替的扁平数组
+ */
+std::string buildZrangeWithScores(size_t members)
+{
+    std::string reply = "*" + std::to_string(members * 2) + "\r\n";
+    for (size_t i = 0; i < members; ++i) {
+        std::string id = std::to_string(i);
+        std::string member = "user:session:" + std::string(12 - id.size(), '0') + id;
+        std::string score = std::to_string(i % 1000) + ".5";
+        reply += "$" + std::to_string(member.size()) + "\r\n" + member + "\r\n";
+        reply += "$" + std::to_string(score.size()) + "\r\n" + score + "\r\n";
+    }
+    return reply;
+}
+
+double toDouble(std::string_view text)
+{
+    double value = 0;
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+}
+
+// 对所有 score 求和的访问者
+struct ScoreSum : RespVisitor
+{
+    double sum = 0;
+    size_t index = 0;
+
+    void onBulk(std::string_view value) override
+    {
+        if (index++ % 2 == 1) {
+            sum += toDouble(value);
+        }
+    }
+};
+
+struct Sample
+{
+    double ms = 0;
+    size_t allocs = 0;
+    double sum = 0;
+};
+
+/**
+ * @brief 树形解码后遍历求和（含析构）
+ */
+Sample runTree(const std::string& reply)
+{
+    Sample sample;
+    RespParser parser;
+    size_t before = g_alloc_count.load();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    {
+        auto result = parser.parse(reply.data(), reply.size());
+        const auto& elements = result->second.asArray();
+        for (size_t i = 1; i < elements.size(); i += 2) {
+            sample.sum += toDouble(std::get<std::string>(elements[i].getData()));
+        }
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    sample.allocs = g_alloc_count.load() - before;
+    sample.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    return sample;
+}
+
+/**
+ * @brief 访问者直接在数据上求和；按 chunk 大小模拟分批到达、回调后即丢弃
+ */
+Sample runVisitor(const std::string& reply, size_t chunk)
+{
+    Sample sample;
+    RespVisitParser parser;
+    ScoreSum visitor;
+    size_t before = g_alloc_count.load();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    size_t begin = 0;
+    size_t end = 0;
+    while (true) {
+        end = std::min(reply.size(), end + chunk);
+        auto progress = parser.parse(reply.data() + begin, end - begin, visitor);
+        if (!progress || progress->done) {
+            break;
+        }
+        begin += progress->consumed;
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    sample.allocs = g_alloc_count.load() - before;
+    sample.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sample.sum = visitor.sum;
+    return sample;
+}
+
+void print(const std::string& name, const Sample& s)
+{
+    std::cout << std::left << std::setw(18) << name << std::setw(12) << s.allocs
+              << std::fixed << std::setprecision(3) << std::setw(12) << s.ms
+              << std::setprecision(1) << s.sum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t members = 100000;
+    size_t rounds = 5;
+    if (argc > 1) members = std::stoul(argv[1]);
+    if (argc > 2) rounds = std::stoul(argv[2]);
+
+    std::string reply = buildZrangeWithScores(members);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "ZRANGE WITHSCORES Sum: Tree vs Visitor" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Members: " << members << ", reply size: " << reply.size() / 1024 << " KB"
+              << ", best of " << rounds << std::endl;
+    std::cout << std::left << std::setw(18) << "Mode" << std::setw(12) << "Allocs"
+              << std::setw(12) << "Total(ms)" << "Sum" << std::endl;
+
+    Sample best_tree, best_whole, best_chunked;
+    best_tree.ms = best_whole.ms = best_chunked.ms = 1e18;
+    for (size_t i = 0; i < rounds; ++i) {
+        Sample tree = runTree(reply);
+        if (tree.ms < best_tree.ms) best_tree = tree;
+        Sample whole = runVisitor(reply, reply.size());
+        if (whole.ms < best_whole.ms) best_whole = whole;
+        Sample chunked = runVisitor(reply, 8192);
+        if (chunked.ms < best_chunked.ms) best_chunked = chunked;
+    }
+
+    print("tree", best_tree);
+    print("visitor", best_whole);
+    print("visitor (8KB)", best_chunked);
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RespCommand.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace galay::redis::protocol;
+
+// 统计堆分配次数
+static std::atomic<size_t> g_alloc_count{0};
+
+void* operator new(size_t size)
+{
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+/**
+ * @brief 旧实现：拼接 cmd_parts 后逐个 "$" + to_string + "\r\n" + str + "\r\n"
+ */
+std::string legacyBulkString(const std::string& str)
+{
+    return "$" + std::to_string(str.length()) + "\r\n" + str + "\r\n";
+}
+
+std::string legacyEncode(const std::string& cmd, const std::vector<std::string>& args)
+{
+    std::vector<std::string> cmd_parts;
+    cmd_parts.reserve(1 + args.size());
+    cmd_parts.push_back(cmd);
+    cmd_parts.insert(cmd_parts.end(), args.begin(), args.end());
+    std::string result = "*" + std::to_string(cmd_parts.size()) + "\r\n";
+    for (const auto& part : cmd_parts) {
+        result += legacyBulkString(part);
+    }
+    return result;
+}
+
+struct Sample
+{
+    double ops_per_sec = 0;
+    double allocs_per_cmd = 0;
+    size_t bytes = 0;
+};
+
+template<typename F>
+Sample measure(size_t iterations, F&& encode)
+{
+    Sample sample;
+    size_t before = g_alloc_count.load();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        sample.bytes += encode(i);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    sample.ops_per_sec = iterations / seconds;
+    sample.allocs_per_cmd = static_cast<double>(g_alloc_count.load() - before) / iterations;
+    return sample;
+}
+
+void print(const char* name, const Sample& s)
+{
+    std::cout << "  " << std::left << std::setw(10) << name
+              << std::fixed << std::setprecision(0) << std::setw(16) << s.ops_per_sec
+              << std::setprecision(2) << s.allocs_per_cmd << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = 1000000;
+    if (argc > 1) iterations = std::stoul(argv[1]);
+
+    const std::string key = "user:profile:1000001";
+    const std::string value(64, 'v');
+    std::vector<std::string> hset_args = {key};
+    for (int i = 0; i < 8; ++i) {
+        hset_args.push_back("field_" + std::to_string(i));
+        hset_args.push_back("value_payload_" + std::to_string(i));
+    }
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "RESP Command Encoding: legacy vs append vs Command<>" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Iterations: " << iterations << std::endl;
+    std::cout << "  " << std::left << std::setw(10) << "Mode" << std::setw(16) << "Commands/s"
+              << "Allocs/cmd" << std::endl;
+
+    std::string buffer;
+
+    std::cout << "SET key <64B value>" << std::endl;
+    print("legacy", measure(iterations, [&](size_t) {
+        return legacyEncode("SET", {key, value}).size();
+    }));
+    print("append", measure(iterations, [&](size_t) {
+        buffer.clear();
+        RespEncoder::appendCommandArgs(buffer, "SET", key, value);
+        return buffer.size();
+    }));
+    print("command", measure(iterations, [&](size_t) {
+        buffer.clear();
+        Command<"SET", 2>::append(buffer, key, value);
+        return buffer.size();
+    }));
+
+    std::cout << "GET key" << std::endl;
+    print("legacy", measure(iterations, [&](size_t) {
+        return legacyEncode("GET", {key}).size();
+    }));
+    print("append", measure(iterations, [&](size_t) {
+        buffer.clear();
+        RespEncoder::appendCommandArgs(buffer, "GET", key);
+        return buffer.size();
+    }));
+    print("command", measure(iterations, [&](size_t) {
+        buffer.clear();
+        Command<"GET", 1>::append(buffer, key);
+        return buffer.size();
+    }));
+
+    std::cout << "ZADD key <score> member" << std::endl;
+    print("legacy", measure(iterations, [&](size_t i) {
+        return legacyEncode("ZADD", {key, std::to_string(i * 0.25), "member"}).size();
+    }));
+    print("append", measure(iterations, [&](size_t i) {
+        buffer.clear();
+        RespEncoder::appendCommandArgs(buffer, "ZADD", key, i * 0.25, "member");
+        return buffer.size();
+    }));
+    print("command", measure(iterations, [&](size_t i) {
+        buffer.clear();
+        Command<"ZADD", 3>::append(buffer, key, i * 0.25, "member");
+        return buffer.size();
+    }));
+
+    std::cout << "HSET key <8 field/value pairs>" << std::endl;
+    print("legacy", measure(iterations, [&](size_t) {
+        return legacyEncode("HSET", hset_args).size();
+    }));
+    print("append", measure(iterations, [&](size_t) {
+        buffer.clear();
+        RespEncoder::appendCommand(buffer, "HSET", hset_args);
+        return buffer.size();
+    }));
+
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
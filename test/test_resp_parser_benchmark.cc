@@ -0,0 +1,108 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace galay::redis::protocol;
+
+/**
+ * @brief 构造一个约 target_bytes 大小的数组回复（类似 LRANGE 的结果）
+ */
+std::string buildArrayReply(size_t target_bytes, size_t element_size)
+{
+    std::string element(element_size, 'x');
+    std::string item = "$" + std::to_string(element_size) + "\r\n" + element + "\r\n";
+    size_t count = target_bytes / item.size();
+
+    std::string reply = "*" + std::to_string(count) + "\r\n";
+    reply.reserve(reply.size() + count * item.size());
+    for (size_t i = 0; i < count; ++i) {
+        reply += item;
+    }
+    return reply;
+}
+
+/**
+ * @brief 模拟数据按 chunk 大小分批到达，每到达一批就调用一次 parse
+ * @param restart 为 true 时每次调用前 reset()，模拟无状态解析器从帧起点重新解析
+ * @return 总耗时（毫秒），解析失败返回 -1
+ */
+double feedInChunks(const std::string& reply, size_t chunk_size, bool restart, size_t& calls)
+{
+    RespParser parser;
+    calls = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t available = chunk_size; ; available += chunk_size) {
+        size_t len = std::min(available, reply.size());
+        if (restart) {
+            parser.reset();
+        }
+        ++calls;
+        auto result = parser.parse(reply.data(), len);
+        if (result) {
+            if (result->first != reply.size()) {
+                return -1;
+            }
+            break;
+        }
+        if (result.error() != ParseError::Incomplete || len == reply.size()) {
+            return -1;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void runCase(size_t reply_mb, size_t chunk_size, bool restart)
+{
+    std::string reply = buildArrayReply(reply_mb * 1024 * 1024, 100);
+    size_t calls = 0;
+    double ms = feedInChunks(reply, chunk_size, restart, calls);
+
+    std::cout << std::left << std::setw(12) << (restart ? "restart" : "resumable")
+              << std::setw(10) << (std::to_string(reply_mb) + "MB")
+              << std::setw(12) << calls;
+    if (ms < 0) {
+        std::cout << "parse failed" << std::endl;
+        return;
+    }
+    std::cout << std::setw(14) << std::fixed << std::setprecision(2) << ms
+              << std::setprecision(3) << (ms * 1e6 / reply.size()) << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t chunk_size = 1024;
+    size_t max_mb = 10;
+    if (argc > 1) chunk_size = std::stoul(argv[1]);
+    if (argc > 2) max_mb = std::stoul(argv[2]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "RespParser Incremental Parse Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Chunk size: " << chunk_size << " bytes, element size: 100 bytes" << std::endl;
+    std::cout << "resumable: 断点续解析；restart: 每次从帧起点重新解析（旧行为）" << std::endl;
+    std::cout << "--------------------------------------------------" << std::endl;
+    std::cout << std::left << std::setw(12) << "Mode" << std::setw(10) << "Reply"
+              << std::setw(12) << "Calls" << std::setw(14) << "Total(ms)" << "ns/byte" << std::endl;
+
+    // 续解析：耗时随回复大小线性增长，ns/byte 基本不变
+    for (size_t mb : {1, 2, 5, 10}) {
+        if (mb <= max_mb) {
+            runCase(mb, chunk_size, false);
+        }
+    }
+
+    // 重新解析：总扫描量为 O(n^2 / chunk)，ns/byte 随大小线性增长
+    for (size_t mb : {1, 2, 4}) {
+        if (mb <= max_mb) {
+            runCase(mb, chunk_size, true);
+        }
+    }
+
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RespScanner.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace galay::redis::protocol;
+
+/**
+ * @brief 大量小整数回复（如批量 INCR 的管道结果）
+ */
+std::string buildSmallIntegers(size_t target_bytes)
+{
+    std::string corpus;
+    corpus.reserve(target_bytes + 32);
+    for (int64_t i = 0; corpus.size() < target_bytes; ++i) {
+        corpus += ":" + std::to_string(i % 1000) + "\r\n";
+    }
+    return corpus;
+}
+
+/**
+ * @brief 长状态行回复，行内没有\r\n，扫描距离最长
+ */
+std::string buildLongStatusLines(size_t target_bytes, size_t line_size)
+{
+    std::string line = "+" + std::string(line_size, 's') + "\r\n";
+    std::string corpus;
+    corpus.reserve(target_bytes + line.size());
+    while (corpus.size() < target_bytes) {
+        corpus += line;
+    }
+    return corpus;
+}
+
+/**
+ * @brief 嵌套数组回复（类似 XRANGE / 多层 ARRAY 的结果）
+ */
+std::string buildNestedArrays(size_t target_bytes)
+{
+    std::string frame = "*2\r\n$10\r\n1700000000\r\n*4\r\n$5\r\nfield\r\n$12\r\nvalue-123456\r\n"
+                        ":42\r\n*2\r\n+OK\r\n$-1\r\n";
+    std::string corpus;
+    corpus.reserve(target_bytes + frame.size());
+    while (corpus.size() < target_bytes) {
+        corpus += frame;
+    }
+    return corpus;
+}
+
+/**
+ * @brief 用指定内核从头到尾依次查找所有\r\n
+ * @return 吞吐量（GB/s）
+ */
+double scanThroughput(RespScanner::Kernel kernel, const std::string& corpus, size_t rounds, size_t& lines)
+{
+    lines = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        size_t offset = 0;
+        while (true) {
+            size_t pos = RespScanner::findCRLF(kernel, corpus.data(), corpus.size(), offset);
+            if (pos == RespScanner::npos) break;
+            ++lines;
+            offset = pos + 2;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    lines /= rounds;
+    return static_cast<double>(corpus.size()) * rounds / seconds / 1e9;
+}
+
+/**
+ * @brief 整个语料逐帧完整解析（使用运行时选定的内核）
+ * @return 吞吐量（GB/s），解析失败返回 -1
+ */
+double parseThroughput(const std::string& corpus, size_t rounds)
+{
+    RespParser parser;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        size_t offset = 0;
+        while (offset < corpus.size()) {
+            auto result = parser.parse(corpus.data() + offset, corpus.size() - offset);
+            if (!result) {
+                return -1;
+            }
+            offset += result->first;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(corpus.size()) * rounds / seconds / 1e9;
+}
+
+void runCorpus(const std::string& name, const std::string& corpus, size_t rounds)
+{
+    std::cout << "--------------------------------------------------" << std::endl;
+    std::cout << name << " (" << corpus.size() / 1024 << " KB)" << std::endl;
+
+    double scalar_gbps = 0;
+    for (auto kernel : {RespScanner::Kernel::Scalar, RespScanner::Kernel::SSE2, RespScanner::Kernel::AVX2}) {
+        std::cout << "  " << std::left << std::setw(10) << RespScanner::kernelName(kernel);
+        if (!RespScanner::isSupported(kernel)) {
+            std::cout << "unsupported" << std::endl;
+            continue;
+        }
+        size_t lines = 0;
+        double gbps = scanThroughput(kernel, corpus, rounds, lines);
+        if (kernel == RespScanner::Kernel::Scalar) {
+            scalar_gbps = gbps;
+        }
+        std::cout << std::setw(12) << lines << std::fixed << std::setprecision(2)
+                  << std::setw(10) << gbps << "GB/s  x" << gbps / scalar_gbps << std::endl;
+    }
+
+    double parse_gbps = parseThroughput(corpus, rounds);
+    std::cout << "  " << std::left << std::setw(22) << "full parse";
+    if (parse_gbps < 0) {
+        std::cout << "parse failed" << std::endl;
+    } else {
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << parse_gbps << "GB/s" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t corpus_kb = 1024;
+    size_t rounds = 20;
+    if (argc > 1) corpus_kb = std::stoul(argv[1]);
+    if (argc > 2) rounds = std::stoul(argv[2]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "RESP CRLF Scan Benchmark" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Active kernel: " << RespScanner::kernelName(RespScanner::activeKernel())
+              << ", rounds: " << rounds << std::endl;
+    std::cout << "  " << std::left << std::setw(10) << "Kernel" << std::setw(12) << "Lines"
+              << std::setw(10) << "Speed" << "      vs scalar" << std::endl;
+
+    size_t bytes = corpus_kb * 1024;
+    runCorpus("small integers", buildSmallIntegers(bytes), rounds);
+    runCorpus("long status lines (512B)", buildLongStatusLines(bytes, 512), rounds);
+    runCorpus("nested arrays", buildNestedArrays(bytes), rounds);
+
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
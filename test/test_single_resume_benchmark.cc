@@ -0,0 +1,123 @@
+#include "galay-redis/async/RedisClient.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+std::atomic<bool> g_done{false};
+
+/**
+ * @brief 单次恢复：每条命令调用方只 co_await 一次，send/recv 状态机由客户端驱动协程推进
+ *        driverStats().io_steps 即旧实现中调用方需要的恢复次数
+ */
+Coroutine runAll(IOScheduler* scheduler, int port, int count)
+{
+    RedisClient client(scheduler);
+    auto connect_result = co_await client.connect("127.0.0.1", port);
+    if (!connect_result) {
+        std::cerr << "Connect failed: " << connect_result.error().message() << std::endl;
+        g_done = true;
+        co_return;
+    }
+
+    // 单命令：一次 send + 一次 recv
+    auto before = client.driverStats();
+    uint64_t awaits = 0;
+    size_t failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        ++awaits;
+        auto result = co_await client.set("single_resume_" + std::to_string(i), "value");
+        if (!result || !result->has_value()) {
+            ++failures;
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto after = client.driverStats();
+
+    auto report = [&](const char* name, uint64_t commands) {
+        uint64_t operations = after.operations - before.operations;
+        uint64_t io_steps = after.io_steps - before.io_steps;
+        uint64_t wakeups = after.io_wakeups - before.io_wakeups;
+        std::cout << (failures == 0 ? "✓ " : "✗ ") << name << ": " << commands << " commands in "
+                  << elapsed * 1000 << " ms (" << static_cast<uint64_t>(commands / elapsed) << " ops/sec)"
+                  << (failures ? ", " + std::to_string(failures) + " failures" : "") << std::endl;
+        std::cout << "  caller resumes per operation: " << static_cast<double>(awaits) / operations
+                  << " (before: " << static_cast<double>(io_steps) / operations << ")"
+                  << ", IO wakeups per operation: " << static_cast<double>(wakeups) / operations << std::endl;
+    };
+    report("Single command", count);
+
+    // pipeline：回复超过一次读取时旧实现每次读取都恢复调用方
+    std::vector<std::vector<std::string>> commands;
+    for (int i = 0; i < 1000; ++i) {
+        commands.push_back({"SET", "single_resume_" + std::to_string(i), std::string(64, 'x')});
+    }
+    int batches = std::max(1, count / 1000);
+    before = client.driverStats();
+    awaits = 0;
+    failures = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < batches; ++i) {
+        ++awaits;
+        auto result = co_await client.pipeline(commands);
+        if (!result || !result->has_value() || result->value().size() != commands.size()) {
+            ++failures;
+        }
+    }
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    after = client.driverStats();
+    report("Pipeline x1000", static_cast<uint64_t>(batches) * commands.size());
+
+    co_await client.close();
+    g_done = true;
+}
+
+int main(int argc, char* argv[])
+{
+    int count = 100000;
+    if (argc > 1) count = std::atoi(argv[1]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Single-Resume Awaitable Benchmark (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Commands: " << count << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    if (!server.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        scheduler->spawn(runAll(scheduler, server.port(), count));
+
+        while (!g_done.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    server.stop();
+    std::cout << "Server handled " << server.commandsServed() << " commands" << std::endl;
+    return 0;
+}
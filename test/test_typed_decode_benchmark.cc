@@ -0,0 +1,132 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RedisReplyView.h"
+#include "galay-redis/protocol/RespDecode.h"
+#include "galay-redis/base/RedisValue.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace galay::redis;
+using namespace galay::redis::protocol;
+
+// 统计堆分配次数
+static std::atomic<size_t> g_alloc_count{0};
+
+void* operator new(size_t size)
+{
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+/**
+ * @brief LRANGE 回复：元素超过SSO长度
+ */
+std::string buildLrange(size_t count)
+{
+    std::string reply = "*" + std::to_string(count) + "\r\n";
+    for (size_t i = 0; i < count; ++i) {
+        std::string item = "queue:item:payload:" + std::to_string(1000000 + i);
+        reply += "$" + std::to_string(item.size()) + "\r\n" + item + "\r\n";
+    }
+    return reply;
+}
+
+struct Sample
+{
+    double ms = 0;
+    size_t allocs = 0;
+    size_t items = 0;
+};
+
+/**
+ * @brief 现有路径：RespParser -> RedisValue -> toArray() -> toString()
+ */
+Sample runValue(const std::string& reply)
+{
+    Sample sample;
+    RespParser parser;
+    size_t before = g_alloc_count.load();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<std::string> out;
+    {
+        RedisValue value(std::move(parser.parse(reply.data(), reply.size())->second));
+        auto array = value.toArray();
+        out.reserve(array.size());
+        for (const auto& elem : array) {
+            out.push_back(elem.toString());
+        }
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    sample.allocs = g_alloc_count.load() - before;
+    sample.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sample.items = out.size();
+    return sample;
+}
+
+/**
+ * @brief 类型化路径：RespViewParser 节点数组（复用） -> decode<std::vector<std::string>>
+ */
+Sample runTyped(const std::string& reply, std::vector<RespViewNode>& nodes)
+{
+    Sample sample;
+    RespViewParser parser;
+    size_t before = g_alloc_count.load();
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto consumed = parser.parse(reply.data(), reply.size(), nodes);
+    auto out = decode<std::vector<std::string>>(RedisReplyView(reply.data(), nodes.data()));
+    auto t1 = std::chrono::high_resolution_clock::now();
+    sample.allocs = g_alloc_count.load() - before;
+    sample.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sample.items = consumed && out ? out->size() : 0;
+    return sample;
+}
+
+void print(const char* name, const Sample& s)
+{
+    std::cout << std::left << std::setw(10) << name << std::setw(12) << s.allocs
+              << std::fixed << std::setprecision(3) << std::setw(12) << s.ms << s.items << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = 100000;
+    size_t rounds = 5;
+    if (argc > 1) count = std::stoul(argv[1]);
+    if (argc > 2) rounds = std::stoul(argv[2]);
+
+    std::string reply = buildLrange(count);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "LRANGE -> std::vector<std::string>: RedisValue vs decode<T>" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Items: " << count << ", reply size: " << reply.size() / 1024 << " KB"
+              << ", best of " << rounds << std::endl;
+    std::cout << std::left << std::setw(10) << "Mode" << std::setw(12) << "Allocs"
+              << std::setw(12) << "Total(ms)" << "Items" << std::endl;
+
+    Sample best_value, best_typed;
+    best_value.ms = best_typed.ms = 1e18;
+    std::vector<RespViewNode> nodes;
+    for (size_t i = 0; i < rounds; ++i) {
+        Sample value = runValue(reply);
+        if (value.ms < best_value.ms) best_value = value;
+        Sample typed = runTyped(reply, nodes);
+        if (typed.ms < best_typed.ms) best_typed = typed;
+    }
+
+    print("value", best_value);
+    print("typed", best_typed);
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
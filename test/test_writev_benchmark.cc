@@ -0,0 +1,137 @@
+#include "galay-redis/protocol/RedisProtocol.h"
+#include "galay-redis/protocol/RespCommand.h"
+#include "galay-redis/protocol/RespVectored.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using namespace galay::redis::protocol;
+
+/**
+ * @brief 阻塞地写完整个 iovec 数组
+ */
+bool writeAll(int fd, std::vector<iovec> iovecs)
+{
+    size_t index = 0;
+    while (index < iovecs.size()) {
+        ssize_t n = ::writev(fd, iovecs.data() + index, static_cast<int>(iovecs.size() - index));
+        if (n < 0) {
+            return false;
+        }
+        size_t written = static_cast<size_t>(n);
+        while (index < iovecs.size() && written >= iovecs[index].iov_len) {
+            written -= iovecs[index].iov_len;
+            ++index;
+        }
+        if (index < iovecs.size()) {
+            iovecs[index].iov_base = static_cast<char*>(iovecs[index].iov_base) + written;
+            iovecs[index].iov_len -= written;
+        }
+    }
+    return true;
+}
+
+bool writeAll(int fd, const std::string& data)
+{
+    return writeAll(fd, {iovec{const_cast<char*>(data.data()), data.size()}});
+}
+
+struct Sample
+{
+    double ms = 0;
+    double gbps = 0;
+};
+
+/**
+ * @brief 对端线程持续读空 socket，模拟 Redis 服务端接收
+ */
+template<typename F>
+Sample measure(size_t iterations, size_t command_size, F&& send)
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return {};
+    }
+    size_t total = iterations * command_size;
+    std::thread reader([fd = fds[1], total] {
+        std::vector<char> buf(256 * 1024);
+        size_t received = 0;
+        while (received < total) {
+            ssize_t n = ::read(fd, buf.data(), buf.size());
+            if (n <= 0) break;
+            received += static_cast<size_t>(n);
+        }
+    });
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        send(fds[0]);
+    }
+    reader.join();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    Sample sample;
+    sample.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sample.gbps = total / (sample.ms / 1000.0) / (1024.0 * 1024 * 1024);
+    return sample;
+}
+
+void print(const char* name, const Sample& s)
+{
+    std::cout << "  " << std::left << std::setw(10) << name << std::fixed << std::setprecision(3)
+              << std::setw(14) << s.ms << std::setprecision(2) << s.gbps << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = 2000;
+    size_t value_size = 1024 * 1024;
+    if (argc > 1) iterations = std::stoul(argv[1]);
+    if (argc > 2) value_size = std::stoul(argv[2]);
+
+    const std::string key = "blob:1000001";
+    const std::string value(value_size, 'v');
+    const size_t command_size = Command<"SET", 2>::encode(key, value).size();
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "SET key <" << value_size / 1024 << " KB value>: send vs writev" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Commands: " << iterations << ", socketpair with draining reader" << std::endl;
+    std::cout << "  " << std::left << std::setw(10) << "Mode" << std::setw(14) << "Total(ms)"
+              << "GB/s" << std::endl;
+
+    // 原路径：参数拷贝进 args，再编码进命令缓冲区，最后 send
+    print("copy", measure(iterations, command_size, [&](int fd) {
+        std::vector<std::string> args = {key, value};
+        std::string encoded;
+        RespEncoder::appendCommand(encoded, "SET", args);
+        writeAll(fd, encoded);
+    }));
+
+    // 复用缓冲区：值仍要拷贝一次进命令缓冲区
+    std::string buffer;
+    print("append", measure(iterations, command_size, [&](int fd) {
+        buffer.clear();
+        Command<"SET", 2>::append(buffer, key, value);
+        writeAll(fd, buffer);
+    }));
+
+    // 分散写：值原地引用，只在进入内核时拷贝
+    print("writev", measure(iterations, command_size, [&](int fd) {
+        RespVectoredCommand command;
+        command.append("SET", {key, value});
+        writeAll(fd, command.iovecs(0));
+    }));
+
+    std::cout << "==================================================" << std::endl;
+    return 0;
+}
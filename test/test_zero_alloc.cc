@@ -0,0 +1,144 @@
+#include "galay-redis/async/RedisClient.h"
+#include "RespTestServer.h"
+#include <galay-kernel/kernel/Runtime.h>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <new>
+
+using namespace galay::redis;
+using namespace galay::kernel;
+
+// 只统计开启计数的线程（客户端所在的调度线程），服务端线程的分配不计入
+static thread_local bool t_counting = false;
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size)
+{
+    if (t_counting) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+std::atomic<bool> g_done{false};
+std::atomic<bool> g_passed{false};
+
+/**
+ * @brief 预热后执行 count 次 SET + getView，统计这期间客户端线程的堆分配次数
+ * @details key 和 value 都远长于任何 std::string 的短字符串长度，结果不依赖标准库的 SSO 实现；
+ *          get() 把值拷贝成 std::string，值超出短字符串长度时必然分配，因此这里用借用式的 getView
+ */
+Coroutine runAll(IOScheduler* scheduler, int port, int warmup, int count)
+{
+    RedisClient client(scheduler);
+    auto connect_result = co_await client.connect("127.0.0.1", port);
+    if (!connect_result) {
+        std::cerr << "Connect failed: " << connect_result.error().message() << std::endl;
+        g_done = true;
+        co_return;
+    }
+
+    const std::string key = "zero_alloc_key:" + std::string(48, 'k');
+    const std::string value = "zero_alloc_value:" + std::string(240, 'v');
+    size_t failures = 0;
+    size_t allocations = 0;
+
+    for (int round = 0; round < 2; ++round) {
+        bool measure = round == 1;
+        int iterations = measure ? count : warmup;
+        if (measure) {
+            g_allocations = 0;
+            t_counting = true;
+        }
+        for (int i = 0; i < iterations; ++i) {
+            auto set_result = co_await client.set(key, value);
+            if (!set_result || !set_result->has_value() || !set_result->value()[0].isStatus()) {
+                ++failures;
+            }
+            // 借用式等待体返回 std::nullopt 时继续 co_await
+            std::expected<std::optional<RedisBorrowedReply>, RedisError> get_result;
+            do {
+                get_result = co_await client.getView(key);
+            } while (get_result && !get_result->has_value());
+            if (!get_result || !get_result->has_value() || (*get_result)->view().asString() != value) {
+                ++failures;
+            }
+        }
+        if (measure) {
+            t_counting = false;
+            allocations = g_allocations.load();
+        }
+    }
+
+    if (failures != 0) {
+        std::cout << "✗ " << failures << " commands failed" << std::endl;
+    } else if (allocations != 0) {
+        std::cout << "✗ " << allocations << " heap allocations in " << count << " SET/getView round trips ("
+                  << static_cast<double>(allocations) / (2.0 * count) << " per command)" << std::endl;
+    } else {
+        std::cout << "✓ 0 heap allocations in " << count << " SET/getView round trips with a "
+                  << value.size() << "-byte value after "
+                  << warmup << " warm-up round trips" << std::endl;
+        g_passed = true;
+    }
+
+    co_await client.close();
+    g_done = true;
+}
+
+int main(int argc, char* argv[])
+{
+    int count = 10000;
+    int warmup = 100;
+    if (argc > 1) count = std::atoi(argv[1]);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Zero-Allocation Hot Path Test (in-process RESP server)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    galay::redis::test::RespTestServer server;
+    if (!server.start()) {
+        std::cerr << "Failed to start RESP server" << std::endl;
+        return 1;
+    }
+
+    try {
+        Runtime runtime;
+        runtime.start();
+
+        auto* scheduler = runtime.getNextIOScheduler();
+        if (!scheduler) {
+            std::cerr << "Failed to get IO scheduler" << std::endl;
+            return 1;
+        }
+
+        scheduler->spawn(runAll(scheduler, server.port(), warmup, count));
+
+        while (!g_done.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        runtime.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    server.stop();
+    return g_passed ? 0 : 1;
+}